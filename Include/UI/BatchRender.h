@@ -0,0 +1,30 @@
+#ifndef BATCH_RENDER_H_
+#define BATCH_RENDER_H_
+
+#include <QGuiApplication>
+
+/**
+ * @file BatchRender.h
+ * @brief 	The command line entry point that renders geometry files to PNG images without opening the editor.
+ * 			The program is started with --render followed by the files. Each file is either a project file (see projectFile)
+ * 			or a geometryEditor2D that was saved with a boost text archive. The view of each image is zoomed to fit the geometry.
+ * 			The files are split between several threads and each thread renders with its own offscreenRenderer.
+ * 			Run QTTest3 --render --help for the list of options.
+ */
+
+/**
+ * @brief Checks the arguments of the program for the --render option
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return Returns true if the images should be rendered instead of starting the editor. Otherwise, returns false
+ */
+bool isBatchRenderRequested(int argc, char *argv[]);
+
+/**
+ * @brief Renders all of the files that are listed on the command line and waits for the renders to finish
+ * @param application The application. The arguments are read from the application
+ * @return Returns 0 if every file was rendered. Otherwise, returns 1
+ */
+int runBatchRender(QGuiApplication &application);
+
+#endif
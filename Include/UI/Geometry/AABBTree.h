@@ -0,0 +1,477 @@
+#ifndef AABB_TREE_H_
+#define AABB_TREE_H_
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+#include "Include/UI/Geometry/BoundingBox.h"
+
+/**
+ * @class aabbTree
+ * @file AABBTree.h
+ * @brief   A dynamic bounding volume hierarchy (axis aligned bounding box tree) that is used to quickly find the
+ *          segments (lines and arcs) that could possibly intersect a region. Each segment is stored in a leaf along
+ *          with its bounding box. Every internal node of the tree stores the box that encloses both of its children.
+ *          When a region is queried, any branch whose box does not overlap the region is skipped. This reduces the
+ *          intersection search from checking every segment to checking only the segments that are close by.
+ *          The tree is kept balanced through tree rotations (this is the same approach that is used in the Box2D library)
+ *          so that inserting, removing and querying stays at O(log n) even when the segments are added in order.
+ *          The tree only stores the address of the item. Since the geometry is stored in a plf::colony, the address
+ *          remains valid until the item is erased from the colony. Therefor, the owner of the tree needs to call
+ *          erase() before the item is erased and update() anytime the endpoints of the segment change.
+ */
+template<class T>
+class aabbTree
+{
+private:
+	//! The null index for the nodes of the tree
+	static const int p_nullNode = -1;
+
+	struct treeNode
+	{
+		//! For a leaf, this is the box of the item. Otherwise, this is the box enclosing both children
+		boundingBox box;
+
+		//! The item that is stored in the leaf. This is nullptr for internal nodes
+		T *item = nullptr;
+
+		//! The index of the parent. If the node is on the free list, this is the next free node
+		int parent = p_nullNode;
+
+		int child1 = p_nullNode;
+
+		int child2 = p_nullNode;
+
+		//! The height of the node. Leafs are 0 and free nodes are -1
+		int height = -1;
+
+		bool isLeaf() const
+		{
+			return (child1 == p_nullNode);
+		}
+	};
+
+	//! All of the nodes in the tree. Nodes refer to each other by index so that the vector is allowed to grow
+	std::vector<treeNode> p_nodes;
+
+	//! The index of the root of the tree
+	int p_root = p_nullNode;
+
+	//! The head of the list of the nodes that can be reused
+	int p_freeList = p_nullNode;
+
+	//! Lookup from the item to the leaf that stores the item
+	std::unordered_map<T*, int> p_leafs;
+
+	int allocateNode()
+	{
+		if(p_freeList == p_nullNode)
+		{
+			p_nodes.push_back(treeNode());
+			p_nodes.back().height = 0;
+			return (int)p_nodes.size() - 1;
+		}
+
+		int nodeIndex = p_freeList;
+		p_freeList = p_nodes[nodeIndex].parent;
+
+		p_nodes[nodeIndex] = treeNode();
+		p_nodes[nodeIndex].height = 0;
+
+		return nodeIndex;
+	}
+
+	void freeNode(int nodeIndex)
+	{
+		p_nodes[nodeIndex].item = nullptr;
+		p_nodes[nodeIndex].height = -1;
+		p_nodes[nodeIndex].parent = p_freeList;
+		p_freeList = nodeIndex;
+	}
+
+	/**
+	 * @brief 	Places the leaf into the tree. The function walks down the tree choosing the branch
+	 * 			that results in the smallest increase of the total perimeter. The leaf is then paired
+	 * 			with the node that was found and all of the boxes above the leaf are refit.
+	 * @param leaf The index of the leaf to insert
+	 */
+	void insertLeaf(int leaf)
+	{
+		if(p_root == p_nullNode)
+		{
+			p_root = leaf;
+			p_nodes[p_root].parent = p_nullNode;
+			return;
+		}
+
+		boundingBox leafBox = p_nodes[leaf].box;
+		int index = p_root;
+
+		while(!p_nodes[index].isLeaf())
+		{
+			int child1 = p_nodes[index].child1;
+			int child2 = p_nodes[index].child2;
+
+			double perimeter = p_nodes[index].box.getPerimeter();
+			double combinedPerimeter = p_nodes[index].box.merged(leafBox).getPerimeter();
+
+			// Cost of creating a new parent for this node and the new leaf
+			double cost = 2.0 * combinedPerimeter;
+
+			// Minimum cost of pushing the leaf further down the tree
+			double inheritanceCost = 2.0 * (combinedPerimeter - perimeter);
+
+			double cost1 = leafBox.merged(p_nodes[child1].box).getPerimeter() + inheritanceCost;
+			if(!p_nodes[child1].isLeaf())
+				cost1 -= p_nodes[child1].box.getPerimeter();
+
+			double cost2 = leafBox.merged(p_nodes[child2].box).getPerimeter() + inheritanceCost;
+			if(!p_nodes[child2].isLeaf())
+				cost2 -= p_nodes[child2].box.getPerimeter();
+
+			if(cost < cost1 && cost < cost2)
+				break;
+
+			if(cost1 < cost2)
+				index = child1;
+			else
+				index = child2;
+		}
+
+		int sibling = index;
+		int oldParent = p_nodes[sibling].parent;
+		int newParent = allocateNode();
+
+		p_nodes[newParent].parent = oldParent;
+		p_nodes[newParent].box = leafBox.merged(p_nodes[sibling].box);
+		p_nodes[newParent].height = p_nodes[sibling].height + 1;
+		p_nodes[newParent].child1 = sibling;
+		p_nodes[newParent].child2 = leaf;
+		p_nodes[sibling].parent = newParent;
+		p_nodes[leaf].parent = newParent;
+
+		if(oldParent != p_nullNode)
+		{
+			if(p_nodes[oldParent].child1 == sibling)
+				p_nodes[oldParent].child1 = newParent;
+			else
+				p_nodes[oldParent].child2 = newParent;
+		}
+		else
+			p_root = newParent;
+
+		refit(p_nodes[leaf].parent);
+	}
+
+	/**
+	 * @brief Removes the leaf from the tree. The sibling of the leaf takes the place of the parent
+	 * @param leaf The index of the leaf to remove
+	 */
+	void removeLeaf(int leaf)
+	{
+		if(leaf == p_root)
+		{
+			p_root = p_nullNode;
+			return;
+		}
+
+		int parent = p_nodes[leaf].parent;
+		int grandParent = p_nodes[parent].parent;
+		int sibling;
+
+		if(p_nodes[parent].child1 == leaf)
+			sibling = p_nodes[parent].child2;
+		else
+			sibling = p_nodes[parent].child1;
+
+		if(grandParent != p_nullNode)
+		{
+			if(p_nodes[grandParent].child1 == parent)
+				p_nodes[grandParent].child1 = sibling;
+			else
+				p_nodes[grandParent].child2 = sibling;
+
+			p_nodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			refit(grandParent);
+		}
+		else
+		{
+			p_root = sibling;
+			p_nodes[sibling].parent = p_nullNode;
+			freeNode(parent);
+		}
+	}
+
+	/**
+	 * @brief Walks up the tree from the index, balancing the tree and recomputing the boxes and heights
+	 * @param index The index of the node to start at
+	 */
+	void refit(int index)
+	{
+		while(index != p_nullNode)
+		{
+			index = balance(index);
+
+			int child1 = p_nodes[index].child1;
+			int child2 = p_nodes[index].child2;
+
+			p_nodes[index].height = 1 + std::max(p_nodes[child1].height, p_nodes[child2].height);
+			p_nodes[index].box = p_nodes[child1].box.merged(p_nodes[child2].box);
+
+			index = p_nodes[index].parent;
+		}
+	}
+
+	/**
+	 * @brief 	Performs a left or right rotation if the node A is imbalanced.
+	 * @param iA The index of the node to balance
+	 * @return Returns the index of the node that now sits in the position of node A
+	 */
+	int balance(int iA)
+	{
+		if(p_nodes[iA].isLeaf() || p_nodes[iA].height < 2)
+			return iA;
+
+		int iB = p_nodes[iA].child1;
+		int iC = p_nodes[iA].child2;
+
+		int heightDifference = p_nodes[iC].height - p_nodes[iB].height;
+
+		if(heightDifference > 1)
+			return rotate(iA, iC, iB);
+		else if(heightDifference < -1)
+			return rotate(iA, iB, iC);
+
+		return iA;
+	}
+
+	/**
+	 * @brief 	Promotes the node "up" (the taller child of A) to take the place of A. A then takes the
+	 * 			shorter grandchild of "up" as a child.
+	 * @param iA The index of the imbalanced node
+	 * @param iUp The index of the child of A that is being promoted
+	 * @param iOther The index of the other child of A
+	 * @return Returns the index of the node that now sits in the position of node A
+	 */
+	int rotate(int iA, int iUp, int iOther)
+	{
+		int iF = p_nodes[iUp].child1;
+		int iG = p_nodes[iUp].child2;
+
+		// Swap A and the promoted node
+		p_nodes[iUp].child1 = iA;
+		p_nodes[iUp].parent = p_nodes[iA].parent;
+		p_nodes[iA].parent = iUp;
+
+		if(p_nodes[iUp].parent != p_nullNode)
+		{
+			if(p_nodes[p_nodes[iUp].parent].child1 == iA)
+				p_nodes[p_nodes[iUp].parent].child1 = iUp;
+			else
+				p_nodes[p_nodes[iUp].parent].child2 = iUp;
+		}
+		else
+			p_root = iUp;
+
+		// The taller grandchild stays with the promoted node while the other goes to A
+		if(p_nodes[iF].height < p_nodes[iG].height)
+			std::swap(iF, iG);
+
+		p_nodes[iUp].child2 = iF;
+
+		if(p_nodes[iA].child1 == iUp)
+			p_nodes[iA].child1 = iG;
+		else
+			p_nodes[iA].child2 = iG;
+
+		p_nodes[iG].parent = iA;
+
+		p_nodes[iA].box = p_nodes[iOther].box.merged(p_nodes[iG].box);
+		p_nodes[iA].height = 1 + std::max(p_nodes[iOther].height, p_nodes[iG].height);
+
+		p_nodes[iUp].box = p_nodes[iA].box.merged(p_nodes[iF].box);
+		p_nodes[iUp].height = 1 + std::max(p_nodes[iA].height, p_nodes[iF].height);
+
+		return iUp;
+	}
+
+public:
+
+	/**
+	 * @brief Adds an item to the tree. If the item is already in the tree, the box of the item is updated
+	 * @param item The address of the item. This must remain valid until the item is removed from the tree
+	 * @param box The bounding box of the item
+	 */
+	void insert(T *item, const boundingBox &box)
+	{
+		if(p_leafs.find(item) != p_leafs.end())
+		{
+			update(item, box);
+			return;
+		}
+
+		int leaf = allocateNode();
+		p_nodes[leaf].box = box;
+		p_nodes[leaf].item = item;
+
+		insertLeaf(leaf);
+
+		p_leafs[item] = leaf;
+	}
+
+	/**
+	 * @brief Removes an item from the tree. If the item is not in the tree, nothing happens
+	 * @param item The address of the item to remove
+	 */
+	void erase(T *item)
+	{
+		typename std::unordered_map<T*, int>::iterator leafIterator = p_leafs.find(item);
+
+		if(leafIterator == p_leafs.end())
+			return;
+
+		removeLeaf(leafIterator->second);
+		freeNode(leafIterator->second);
+		p_leafs.erase(leafIterator);
+	}
+
+	/**
+	 * @brief 	Function that is called after the shape of the item has changed. The leaf is
+	 * 			reinserted into the tree with the new box. If the item is not in the tree, the item is added
+	 * @param item The address of the item
+	 * @param box The new bounding box of the item
+	 */
+	void update(T *item, const boundingBox &box)
+	{
+		typename std::unordered_map<T*, int>::iterator leafIterator = p_leafs.find(item);
+
+		if(leafIterator == p_leafs.end())
+		{
+			insert(item, box);
+			return;
+		}
+
+		int leaf = leafIterator->second;
+
+		removeLeaf(leaf);
+		p_nodes[leaf].box = box;
+		insertLeaf(leaf);
+	}
+
+	/**
+	 * @brief Checks if an item is stored in the tree
+	 * @param item The address of the item
+	 * @return Returns true if the item is in the tree
+	 */
+	bool contains(T *item) const
+	{
+		return (p_leafs.find(item) != p_leafs.end());
+	}
+
+	//! Removes all of the items from the tree
+	void clear()
+	{
+		p_nodes.clear();
+		p_leafs.clear();
+		p_root = p_nullNode;
+		p_freeList = p_nullNode;
+	}
+
+	/**
+	 * @brief Makes room for a number of items so that the tree does not grow one item at a time while a whole list is inserted
+	 * @param numberOfItems The number of items that will be stored in the tree
+	 */
+	void reserve(size_t numberOfItems)
+	{
+		// A tree with n leafs has n - 1 internal nodes
+		p_nodes.reserve(2 * numberOfItems);
+		p_leafs.reserve(numberOfItems);
+	}
+
+	//! Returns the number of items stored in the tree
+	size_t size() const
+	{
+		return p_leafs.size();
+	}
+
+	/**
+	 * @brief 	Calls the visitor on every item whose box overlaps the region. The visitor takes in the address of the
+	 * 			item and returns true in order to stop the search early. Note that the visitor is allowed to read the
+	 * 			tree but must not insert or remove items. If the items need to be edited, collect the items first.
+	 * @param region The region to search
+	 * @param visitor Function object with the signature bool(T*)
+	 * @return Returns true if the visitor stopped the search
+	 */
+	template<class Visitor>
+	bool query(const boundingBox &region, Visitor visitor) const
+	{
+		if(p_root == p_nullNode)
+			return false;
+
+		std::vector<int> stack;
+		stack.reserve(64);
+		stack.push_back(p_root);
+
+		while(!stack.empty())
+		{
+			int index = stack.back();
+			stack.pop_back();
+
+			const treeNode &currentNode = p_nodes[index];
+
+			if(!currentNode.box.overlaps(region))
+				continue;
+
+			if(currentNode.isLeaf())
+			{
+				if(visitor(currentNode.item))
+					return true;
+			}
+			else
+			{
+				stack.push_back(currentNode.child1);
+				stack.push_back(currentNode.child2);
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Collects all of the items whose box overlaps the region.
+	 * @param region The region to search
+	 * @return Returns a vector containing the address of every item that overlaps the region
+	 */
+	std::vector<T*> queryItems(const boundingBox &region) const
+	{
+		std::vector<T*> items;
+
+		query(region, [&items](T *item) -> bool
+		{
+			items.push_back(item);
+			return false;
+		});
+
+		return items;
+	}
+
+	/**
+	 * @brief Returns the bounding box that was stored for the item
+	 * @param item The address of the item
+	 * @return Returns the box of the item. If the item is not in the tree, an empty box at the origin is returned
+	 */
+	boundingBox getBox(T *item) const
+	{
+		typename std::unordered_map<T*, int>::const_iterator leafIterator = p_leafs.find(item);
+
+		if(leafIterator == p_leafs.end())
+			return boundingBox();
+
+		return p_nodes[leafIterator->second].box;
+	}
+};
+
+#endif
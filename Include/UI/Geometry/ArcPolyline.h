@@ -0,0 +1,101 @@
+#ifndef ARC_POLYLINE_H_
+#define ARC_POLYLINE_H_
+
+#include <algorithm>
+#include <vector>
+
+#include <QPointF>
+
+/**
+ * @class arcPolyline
+ * @file ArcPolyline.h
+ * @brief   The points along an arc. Most arcs are drawn with only a few segments, so the points of these arcs are kept in a small
+ *          buffer inside the class. This way, copying an arc (such as inserting the arc into the arc list or copying the editor)
+ *          does not allocate any memory. Only arcs with more then INLINE_POINT_COUNT points keep their points on the heap.
+ */
+class arcPolyline
+{
+public:
+	//! The number of points that fit into the buffer inside the class. This is enough for an arc with 7 segments
+	enum : unsigned int { INLINE_POINT_COUNT = 8 };
+
+private:
+	QPointF p_inlinePoints[INLINE_POINT_COUNT];
+
+	//! The points once there are too many to fit into p_inlinePoints
+	std::vector<QPointF> p_heapPoints;
+
+	unsigned int p_size = 0;
+
+	//! Set to true if the points are in p_heapPoints
+	bool p_isOnHeap = false;
+
+public:
+	//! Removes all of the points. The memory on the heap is kept for the next time that the points are filled in
+	void clear()
+	{
+		p_heapPoints.clear();
+		p_size = 0;
+		p_isOnHeap = false;
+	}
+
+	//! Makes room for a number of points. The points are moved onto the heap if they will not fit into the class
+	void reserve(unsigned int count)
+	{
+		if(count <= INLINE_POINT_COUNT)
+			return;
+
+		p_heapPoints.reserve(count);
+
+		if(!p_isOnHeap)
+		{
+			p_heapPoints.assign(p_inlinePoints, p_inlinePoints + p_size);
+			p_isOnHeap = true;
+		}
+	}
+
+	void push_back(const QPointF &point)
+	{
+		if(!p_isOnHeap && p_size == INLINE_POINT_COUNT)
+			reserve(2 * INLINE_POINT_COUNT);
+
+		if(p_isOnHeap)
+			p_heapPoints.push_back(point);
+		else
+			p_inlinePoints[p_size] = point;
+
+		p_size++;
+	}
+
+	size_t size() const
+	{
+		return p_size;
+	}
+
+	bool empty() const
+	{
+		return (p_size == 0);
+	}
+
+	const QPointF *begin() const
+	{
+		return p_isOnHeap ? p_heapPoints.data() : p_inlinePoints;
+	}
+
+	const QPointF *end() const
+	{
+		return begin() + p_size;
+	}
+
+	const QPointF &front() const
+	{
+		return *begin();
+	}
+
+	const QPointF &operator[](size_t index) const
+	{
+		return begin()[index];
+	}
+};
+
+#endif
@@ -0,0 +1,177 @@
+#ifndef BOUNDING_BOX_H_
+#define BOUNDING_BOX_H_
+
+#include <math.h>
+#include <algorithm>
+
+/**
+ * @class boundingBox
+ * @file BoundingBox.h
+ * @brief   An axis aligned rectangle that is used to describe the extents of a geometry shape.
+ *          This is primarly used by the spatial indexes in the geometry editor in order to quickly
+ *          determine which shapes could possibly interact with each other. The box is described by the
+ *          lower left corner and the upper right corner.
+ */
+class boundingBox
+{
+private:
+	//! The lower left x-coordinate of the box
+	double p_minX = 0;
+
+	//! The lower left y-coordinate of the box
+	double p_minY = 0;
+
+	//! The upper right x-coordinate of the box
+	double p_maxX = 0;
+
+	//! The upper right y-coordinate of the box
+	double p_maxY = 0;
+
+public:
+	//! The constructor for the class. The box will be a single point at the origin
+	boundingBox()
+	{
+
+	}
+
+	/**
+	 * @brief The constructor for the class
+	 * @param minX The lower left x-coordinate of the box
+	 * @param minY The lower left y-coordinate of the box
+	 * @param maxX The upper right x-coordinate of the box
+	 * @param maxY The upper right y-coordinate of the box
+	 */
+	boundingBox(double minX, double minY, double maxX, double maxY)
+	{
+		p_minX = minX;
+		p_minY = minY;
+		p_maxX = maxX;
+		p_maxY = maxY;
+	}
+
+	/**
+	 * @brief Creates the smallest box that contains the two points
+	 * @param firstX The x-coordinate of the first point
+	 * @param firstY The y-coordinate of the first point
+	 * @param secondX The x-coordinate of the second point
+	 * @param secondY The y-coordinate of the second point
+	 * @return Returns the box that bounds both points
+	 */
+	static boundingBox fromPoints(double firstX, double firstY, double secondX, double secondY)
+	{
+		return boundingBox(std::min(firstX, secondX), std::min(firstY, secondY), std::max(firstX, secondX), std::max(firstY, secondY));
+	}
+
+	double getMinX() const
+	{
+		return p_minX;
+	}
+
+	double getMinY() const
+	{
+		return p_minY;
+	}
+
+	double getMaxX() const
+	{
+		return p_maxX;
+	}
+
+	double getMaxY() const
+	{
+		return p_maxY;
+	}
+
+	/**
+	 * @brief Enlarges the box so that the point lies within the box
+	 * @param xCoordinate The x-coordinate of the point
+	 * @param yCoordinate The y-coordinate of the point
+	 */
+	void expandToInclude(double xCoordinate, double yCoordinate)
+	{
+		p_minX = std::min(p_minX, xCoordinate);
+		p_minY = std::min(p_minY, yCoordinate);
+		p_maxX = std::max(p_maxX, xCoordinate);
+		p_maxY = std::max(p_maxY, yCoordinate);
+	}
+
+	/**
+	 * @brief Returns a copy of the box that is grown by a margin on every side
+	 * @param margin The distance to grow the box by
+	 * @return Returns the enlarged box
+	 */
+	boundingBox inflated(double margin) const
+	{
+		return boundingBox(p_minX - margin, p_minY - margin, p_maxX + margin, p_maxY + margin);
+	}
+
+	/**
+	 * @brief Computes the smallest box that contains both boxes
+	 * @param box The other box
+	 * @return Returns the union of the two boxes
+	 */
+	boundingBox merged(const boundingBox &box) const
+	{
+		return boundingBox(std::min(p_minX, box.p_minX), std::min(p_minY, box.p_minY), std::max(p_maxX, box.p_maxX), std::max(p_maxY, box.p_maxY));
+	}
+
+	/**
+	 * @brief Checks to see if two boxes overlap. Boxes that only touch along an edge are considered overlapping
+	 * @param box The other box
+	 * @return Returns true if the boxes overlap
+	 */
+	bool overlaps(const boundingBox &box) const
+	{
+		return !(box.p_minX > p_maxX || box.p_maxX < p_minX || box.p_minY > p_maxY || box.p_maxY < p_minY);
+	}
+
+	/**
+	 * @brief Checks to see if a box lies completly within this box
+	 * @param box The other box
+	 * @return Returns true if the other box is inside of this box
+	 */
+	bool contains(const boundingBox &box) const
+	{
+		return (box.p_minX >= p_minX && box.p_maxX <= p_maxX && box.p_minY >= p_minY && box.p_maxY <= p_maxY);
+	}
+
+	/**
+	 * @brief Checks to see if a point lies within the box
+	 * @param xCoordinate The x-coordinate of the point
+	 * @param yCoordinate The y-coordinate of the point
+	 * @return Returns true if the point is inside of the box or on the edge of the box
+	 */
+	bool contains(double xCoordinate, double yCoordinate) const
+	{
+		return (xCoordinate >= p_minX && xCoordinate <= p_maxX && yCoordinate >= p_minY && yCoordinate <= p_maxY);
+	}
+
+	/**
+	 * @brief Checks to see if a point lies on one of the edges of the box
+	 * @param xCoordinate The x-coordinate of the point
+	 * @param yCoordinate The y-coordinate of the point
+	 * @return Returns true if the point touches the left, right, bottom or top edge of the box
+	 */
+	bool isOnBoundary(double xCoordinate, double yCoordinate) const
+	{
+		return (xCoordinate <= p_minX || xCoordinate >= p_maxX || yCoordinate <= p_minY || yCoordinate >= p_maxY);
+	}
+
+	/**
+	 * @brief 	Computes the perimeter of the box. The perimeter is used as the cost function
+	 * 			for building the AABB tree.
+	 * @return Returns the perimeter of the box
+	 */
+	double getPerimeter() const
+	{
+		return 2.0 * ((p_maxX - p_minX) + (p_maxY - p_minY));
+	}
+
+	//! Returns the length of the diagonal of the box
+	double getDiagonal() const
+	{
+		return sqrt((p_maxX - p_minX) * (p_maxX - p_minX) + (p_maxY - p_minY) * (p_maxY - p_minY));
+	}
+};
+
+#endif
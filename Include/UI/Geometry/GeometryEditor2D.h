@@ -3,16 +3,26 @@
 
 #include <math.h>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "Include/common/Vector.h"
 #include "Include/common/plfcolony.h"
+#include "Include/common/ColonySerialization.h"
 
 #include "Include/UI/Geometry/geometryShapes.h"
+#include "Include/UI/Geometry/SpatialGrid.h"
+#include "Include/UI/Geometry/AABBTree.h"
+#include "Include/UI/Geometry/IncidenceIndex.h"
+#include "Include/UI/Geometry/NodeHandle.h"
+#include "Include/UI/Geometry/NodeStore.h"
 
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/serialization/vector.hpp>
 
+class projectFile;
+
 //! This class is responsible for any math related functions that operate on the geometry shapes. This includes adding the geomerty.
 /*!
     This class contains any math related function that operates directly on the geometry objects (nodes/labels/arcs/lines)
@@ -26,70 +36,51 @@ class geometryEditor2D
 private:
 	friend class boost::serialization::access;
 	
+	//! The project file fills the lists directly when a file is loaded
+	friend class projectFile;
+	
+	/* The lists are written directly from the colonies and read directly into the colonies (see ColonySerialization.h).
+	 * The archive is the same as an archive of a std::vector of each list, so files saved by older versions still load
+	 */
 	template<class Archive>
 	void save(Archive &ar, const unsigned int version) const
 	{
-		/*
-		 * I really wish there was a better way of doing this
-		 */ 
-		std::vector<node> saveNodes;
-		std::vector<edgeLineShape> saveLines;
-		std::vector<arcShape> saveArcs;
-		std::vector<blockLabel> saveLabels;
-		
-		for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); nodeIterator++)
-			saveNodes.push_back(*nodeIterator);
-		
-		for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); lineIterator++)
-			saveLines.push_back(*lineIterator);
-			
-		for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); arcIterator++)
-			saveArcs.push_back(*arcIterator);
-			
-		for(plf::colony<blockLabel>::iterator labelIterator = _blockLabelList.begin(); labelIterator != _blockLabelList.end(); labelIterator++)
-			saveLabels.push_back(*labelIterator);
-
-		ar & saveNodes;
-		ar & saveLines;
-		ar & saveArcs;
-		ar & saveLabels;
-		
+		ar & _nodeList;
+		ar & _lineList;
+		ar & _arcList;
+		ar & _blockLabelList;
 	}
 	
 	template<class Archive>
 	void load(Archive &ar, const unsigned int version)
 	{
-		std::vector<node> loadNodes;
-		std::vector<edgeLineShape> loadLines;
-		std::vector<arcShape> loadArcs;
-		std::vector<blockLabel> loadLabels;
+		ar & _nodeList;
+		ar & _lineList;
+		ar & _arcList;
+		ar & _blockLabelList;
 		
-		ar & loadNodes;
-		ar & loadLines;
-		ar & loadArcs;
-		ar & loadLabels;
+		_nodeNumber = 0;
+		p_arcNumber = 0;
 		
-		for(std::vector<node>::iterator nodeIterator = loadNodes.begin(); nodeIterator != loadNodes.end(); nodeIterator++)
+		for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
 		{
-			_nodeList.insert(*nodeIterator);
 			if(nodeIterator->getNodeID() > _nodeNumber)
 				_nodeNumber = nodeIterator->getNodeID();
 		}
 		
-		for(std::vector<edgeLineShape>::iterator lineIterator = loadLines.begin(); lineIterator != loadLines.end(); lineIterator++)
-			_lineList.insert(*lineIterator);
-			
-		for(std::vector<arcShape>::iterator arcIterator = loadArcs.begin(); arcIterator != loadArcs.end(); arcIterator++)
+		for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
 		{
-			_arcList.insert(*arcIterator);
 			if(arcIterator->getArcID() > p_arcNumber)
 				p_arcNumber = arcIterator->getArcID();
 		}
-			
-		for(std::vector<blockLabel>::iterator labelIterator = loadLabels.begin(); labelIterator != loadLabels.end(); labelIterator++)
-			_blockLabelList.insert(*labelIterator);
-			
 		
+		_nodeInterator1 = nullptr;
+		_nodeInterator2 = nullptr;
+		
+		/* The archive only holds the node numbers of the lines and arcs. The lines and arcs have no handles yet, so
+		 * rebuildDataStructure finds the nodes from the numbers
+		 */
+		rebuildDataStructure();
 	}
 	BOOST_SERIALIZATION_SPLIT_MEMBER()
     /*
@@ -209,6 +200,452 @@ private:
 	unsigned long _nodeNumber = 0;
 	
 	unsigned long p_arcNumber = 0;
+	
+	//! The spatial index for all of the nodes in _nodeList
+	/*!
+		This is used to quickly determine if there is a node within some distance of a point
+		without having to loop through the entire node list. Nodes that are being dragged are not
+		stored in the index. Any time a node is added or erased, the index needs to be updated.
+		For this reason, the insertNode and eraseNode functions should be used instead of directly
+		editing the node list.
+		\sa insertNode, eraseNode
+	*/ 
+	spatialGrid<node> p_nodeGrid;
+	
+	//! The spatial index for all of the block labels in _blockLabelList
+	/*!
+		\sa p_nodeGrid
+	*/ 
+	spatialGrid<blockLabel> p_blockLabelGrid;
+	
+	//! The bounding volume hierarchy for all of the lines in _lineList
+	/*!
+		This is used to quickly find all of the lines that could possibly intersect a region
+		without having to loop through the entire line list. Anytime a line is added, erased or
+		the endpoints of the line change, the tree needs to be updated. For this reason, the insertLine, updateLine
+		and eraseLine functions should be used instead of directly editing the line list.
+		\sa insertLine, updateLine, eraseLine
+	*/ 
+	aabbTree<edgeLineShape> p_lineTree;
+	
+	//! The bounding volume hierarchy for all of the arcs in _arcList
+	/*!
+		\sa p_lineTree
+	*/ 
+	aabbTree<arcShape> p_arcTree;
+	
+	//! Keeps track of the lines that are connected to each node
+	/*!
+		This is used to find the lines that are connected to a node without having to loop
+		through the entire line list. This index is kept up to date by the same functions that
+		keep p_lineTree up to date. Therefor, updateLine needs to be called anytime the endpoints of
+		a line in the line list are changed.
+		\sa p_lineTree, getLinesAtNode
+	*/ 
+	incidenceIndex<edgeLineShape> p_lineIncidence;
+	
+	//! Keeps track of the arcs that are connected to each node
+	/*!
+		\sa p_lineIncidence
+	*/ 
+	incidenceIndex<arcShape> p_arcIncidence;
+	
+	//! The smallest box that contains all of the nodes (not including any nodes that are being dragged)
+	/*!
+		Adding a node or moving a node outwards only grows the box. Once a node that lies on the edge of the
+		box is removed or moved, the box can shrink. In this case, the box is marked as invalid and is
+		recalculated the next time that it is needed.
+		\sa getModelBoundingBox
+	*/ 
+	boundingBox p_modelBox;
+	
+	//! Set to true when p_modelBox contains the extents of the node list
+	bool p_modelBoxIsValid = false;
+	
+	//! Converts the handles that are stored in the nodes and in the lines/arcs into the address of the nodes
+	/*!
+		Every node in _nodeList is given a handle when the node is added. The handle is released when the node is erased.
+		For this reason, the insertNode and eraseNode functions should be used instead of directly editing the node list.
+		\sa rebuildHandleTable, relinkSegments
+	*/ 
+	handleTable<node> p_nodeHandles;
+	
+	//! Packed lists of the coordinates of all of the nodes in _nodeList
+	/*!
+		This is used by the renderer in order to build the vertex buffer of the nodes.
+		Like p_nodeGrid, nodes that are being dragged are not stored and the store is updated by insertNode and eraseNode.
+		\sa p_nodeGrid
+	*/ 
+	nodeStore p_nodeStore;
+	
+	//! Counter that is increased every time that geometry is added, removed or moved
+	/*!
+		This is used by the renderer of the canvas in order to know when the vertex buffers need to be rebuilt.
+		The counter is increased in the same places that the spatial indexes are updated. Changing the selected
+		state of the geometry does not change the counter.
+		\sa getGeometryRevision
+	*/ 
+	unsigned long p_geometryRevision = 0;
+	
+	//! Counters that are increased every time that a node, line, arc or block label is added, removed or moved
+	/*!
+		These work the same way as p_geometryRevision except that each one only counts the changes to one list.
+		The renderer uses these in order to only rebuild the vertex buffers of the type of geometry that changed.
+		\sa getNodeRevision, getLineRevision, getArcRevision, getBlockLabelRevision
+	*/ 
+	unsigned long p_nodeRevision = 0;
+	
+	unsigned long p_lineRevision = 0;
+	
+	unsigned long p_arcRevision = 0;
+	
+	unsigned long p_blockLabelRevision = 0;
+	
+	//! The nodes in _nodeList whose selected state is set
+	/*!
+		This is used to clear the selection and to count the selected geometry without looping through
+		the entire list. The set is updated by the setSelectState functions of the editor, by the functions that
+		add and erase geometry and by rebuildSpatialIndex. For this reason, the selected state of the geometry in the
+		lists should be changed through the editor instead of directly through the geometry.
+		\sa setSelectState, clearSelectedNodes
+	*/ 
+	std::unordered_set<node*> p_selectedNodes;
+	
+	//! The block labels in _blockLabelList whose selected state is set
+	/*!
+		\sa p_selectedNodes
+	*/ 
+	std::unordered_set<blockLabel*> p_selectedBlockLabels;
+	
+	//! The lines in _lineList whose selected state is set
+	/*!
+		\sa p_selectedNodes
+	*/ 
+	std::unordered_set<edgeLineShape*> p_selectedLines;
+	
+	//! The arcs in _arcList whose selected state is set
+	/*!
+		\sa p_selectedNodes
+	*/ 
+	std::unordered_set<arcShape*> p_selectedArcs;
+	
+	//! Set to true between a call to beginBatch and commitBatch
+	/*!
+		While a batch is open, the geometry that is appended to the lists is not placed into any of the
+		spatial indexes and no intersections are checked. All of this is done in one pass when the batch is committed.
+		\sa beginBatch, commitBatch
+	*/ 
+	bool p_batchIsOpen = false;
+	
+	/**
+	 * @brief Places the geometry into the set of selected geometry if the geometry is selected. Otherwise, removes the geometry from the set
+	 * @param selectedItems The set of selected geometry that the geometry belongs to
+	 * @param item The geometry
+	 */
+	template<class T>
+	void trackSelectState(std::unordered_set<T*> &selectedItems, T &item)
+	{
+		if(item.getIsSelectedState())
+			selectedItems.insert(&item);
+		else
+			selectedItems.erase(&item);
+	}
+	
+	/**
+	 * @brief Sets the selected state of all of the geometry in a set of selected geometry to false and empties the set
+	 * @param selectedItems The set of selected geometry
+	 */
+	template<class T>
+	void clearSelectedItems(std::unordered_set<T*> &selectedItems)
+	{
+		for(typename std::unordered_set<T*>::iterator itemIterator = selectedItems.begin(); itemIterator != selectedItems.end(); ++itemIterator)
+			(*itemIterator)->setSelectState(false);
+			
+		selectedItems.clear();
+	}
+	
+	/**
+	 * @brief 	Function that is called in order to rebuild the spatial indexes from the geometry lists.
+	 * 			This needs to be called anytime an entire list is replaced (such as a load or
+	 * 			a copy of the list). Lines and arcs whose node addresses have not been rebuilt
+	 * 			yet are skipped. These will be indexed once rebuildDataStructure is called.
+	 */
+	void rebuildSpatialIndex()
+	{
+		p_nodeGrid.clear();
+		p_nodeStore.clear();
+		p_blockLabelGrid.clear();
+		p_lineTree.clear();
+		p_arcTree.clear();
+		p_lineIncidence.clear();
+		p_arcIncidence.clear();
+		p_selectedNodes.clear();
+		p_selectedBlockLabels.clear();
+		p_selectedLines.clear();
+		p_selectedArcs.clear();
+		p_modelBoxIsValid = false;
+		p_geometryRevision++;
+		p_nodeRevision++;
+		p_lineRevision++;
+		p_arcRevision++;
+		p_blockLabelRevision++;
+		
+		p_lineTree.reserve(_lineList.size());
+		p_arcTree.reserve(_arcList.size());
+		p_lineIncidence.reserve(_lineList.size());
+		p_arcIncidence.reserve(_arcList.size());
+		
+		for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+		{
+			if(!nodeIterator->getDraggingState())
+			{
+				p_nodeGrid.insert(&(*nodeIterator));
+				p_nodeStore.insert(&(*nodeIterator));
+			}
+			
+			trackSelectState(p_selectedNodes, *nodeIterator);
+		}
+		
+		for(plf::colony<blockLabel>::iterator labelIterator = _blockLabelList.begin(); labelIterator != _blockLabelList.end(); ++labelIterator)
+		{
+			if(!labelIterator->getDraggingState())
+				p_blockLabelGrid.insert(&(*labelIterator));
+				
+			trackSelectState(p_selectedBlockLabels, *labelIterator);
+		}
+		
+		for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+		{
+			trackSelectState(p_selectedLines, *lineIterator);
+			
+			if(lineIterator->getFirstNode() && lineIterator->getSecondNode())
+			{
+				p_lineTree.insert(&(*lineIterator), lineIterator->getBoundingBox());
+				p_lineIncidence.insert(&(*lineIterator));
+			}
+		}
+		
+		for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+		{
+			trackSelectState(p_selectedArcs, *arcIterator);
+			
+			if(arcIterator->getFirstNode() && arcIterator->getSecondNode())
+			{
+				p_arcTree.insert(&(*arcIterator), arcIterator->getBoundingBox());
+				p_arcIncidence.insert(&(*arcIterator));
+			}
+		}
+	}
+	
+	/**
+	 * @brief 	Function that is called in order to rebuild the handle table from the node list. This needs to be called
+	 * 			anytime the node list is replaced. Nodes that were copied keep their handle. Nodes that do not have a
+	 * 			handle (such as nodes that were loaded from file) or whose handle is already taken are given a new handle.
+	 */
+	void rebuildHandleTable()
+	{
+		std::vector<node*> unplacedNodes;
+		
+		p_nodeHandles.clear();
+		
+		for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+		{
+			if(!p_nodeHandles.place(nodeIterator->getHandle(), &(*nodeIterator)))
+				unplacedNodes.push_back(&(*nodeIterator));
+		}
+		
+		p_nodeHandles.finishPlacement();
+		
+		for(std::vector<node*>::iterator nodeIterator = unplacedNodes.begin(); nodeIterator != unplacedNodes.end(); ++nodeIterator)
+			(*nodeIterator)->setHandle(p_nodeHandles.acquire(*nodeIterator));
+	}
+	
+	/**
+	 * @brief 	Points the lines and arcs at the nodes that their node handles refer to. This is how the lines and arcs are repaired after
+	 * 			the node list (or the line/arc list) is copied. Each lookup is an index into the handle table.
+	 * @return 	Returns false if the handle of any line or arc does not refer to a node in the node list. These lines and arcs are not changed
+	 */
+	bool relinkSegments()
+	{
+		bool allLinked = true;
+		
+		for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+		{
+			node *firstNode = p_nodeHandles.resolve(lineIterator->getFirstNodeHandle());
+			node *secondNode = p_nodeHandles.resolve(lineIterator->getSecondNodeHandle());
+			
+			if(firstNode && secondNode)
+			{
+				lineIterator->setFirstNode(*firstNode);
+				lineIterator->setSecondNode(*secondNode);
+			}
+			else
+				allLinked = false;
+		}
+		
+		for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+		{
+			node *firstNode = p_nodeHandles.resolve(arcIterator->getFirstNodeHandle());
+			node *secondNode = p_nodeHandles.resolve(arcIterator->getSecondNodeHandle());
+			
+			if(firstNode && secondNode)
+			{
+				arcIterator->setFirstNode(*firstNode);
+				arcIterator->setSecondNode(*secondNode);
+			}
+			else
+				allLinked = false;
+		}
+		
+		return allLinked;
+	}
+	
+	/**
+	 * @brief Adds a node to the node list and places the node into the spatial index
+	 * @param newNode The node that is to be added. This should not be a node that is being dragged
+	 * @return Returns an iterator pointing to the node in the node list
+	 */
+	plf::colony<node>::iterator insertNode(const node &newNode)
+	{
+		plf::colony<node>::iterator nodeIterator = _nodeList.insert(newNode);
+		
+		nodeIterator->setHandle(p_nodeHandles.acquire(&(*nodeIterator)));
+		p_nodeGrid.insert(&(*nodeIterator));
+		p_nodeStore.insert(&(*nodeIterator));
+		trackSelectState(p_selectedNodes, *nodeIterator);
+		p_geometryRevision++;
+		p_nodeRevision++;
+		
+		if(p_modelBoxIsValid)
+			p_modelBox.expandToInclude(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
+			
+		return nodeIterator;
+	}
+	
+	/**
+	 * @brief Adds a line to the line list and places the line into the spatial index
+	 * @param line The line that is to be added. Both nodes of the line must be set
+	 * @return Returns an iterator pointing to the line in the line list
+	 */
+	plf::colony<edgeLineShape>::iterator insertLine(const edgeLineShape &line)
+	{
+		plf::colony<edgeLineShape>::iterator lineIterator = _lineList.insert(line);
+		
+		p_lineTree.insert(&(*lineIterator), lineIterator->getBoundingBox());
+		p_lineIncidence.insert(&(*lineIterator));
+		trackSelectState(p_selectedLines, *lineIterator);
+		p_geometryRevision++;
+		p_lineRevision++;
+		
+		return lineIterator;
+	}
+	
+	/**
+	 * @brief Adds an arc to the arc list and places the arc into the spatial index
+	 * @param arc The arc that is to be added. Both nodes of the arc must be set and the arc must be calculated
+	 * @return Returns an iterator pointing to the arc in the arc list
+	 */
+	plf::colony<arcShape>::iterator insertArc(const arcShape &arc)
+	{
+		plf::colony<arcShape>::iterator arcIterator = _arcList.insert(arc);
+		
+		p_arcTree.insert(&(*arcIterator), arcIterator->getBoundingBox());
+		p_arcIncidence.insert(&(*arcIterator));
+		trackSelectState(p_selectedArcs, *arcIterator);
+		p_geometryRevision++;
+		p_arcRevision++;
+		
+		return arcIterator;
+	}
+	
+	/**
+	 * @brief 	Function that is called after the endpoints of a line in the line list have changed. This includes
+	 * 			moving the line over to a different node even if the new node is in the same position
+	 * @param line The line that was edited
+	 */
+	void updateLine(edgeLineShape &line)
+	{
+		p_lineTree.update(&line, line.getBoundingBox());
+		p_lineIncidence.update(&line);
+		p_geometryRevision++;
+		p_lineRevision++;
+	}
+	
+	/**
+	 * @brief Function that is called after the endpoints or the angle of an arc in the arc list have changed
+	 * @param arc The arc that was edited
+	 */
+	void updateArc(arcShape &arc)
+	{
+		p_arcTree.update(&arc, arc.getBoundingBox());
+		p_arcIncidence.update(&arc);
+		p_geometryRevision++;
+		p_arcRevision++;
+	}
+	
+	/**
+	 * @brief 	Converts the addresses returned from the spatial index into iterators and sorts the iterators
+	 * 			into the same order that the items appear in the list. This way, any edits that are made from the
+	 * 			result of a query are made in the same order as if the entire list was looped through.
+	 * @param list The list that the items belong to
+	 * @param items The addresses of the items
+	 * @return Returns the iterators to the items in list order
+	 */
+	template<class T>
+	std::vector<typename plf::colony<T>::iterator> sortByListOrder(plf::colony<T> &list, const std::vector<T*> &items)
+	{
+		std::vector<typename plf::colony<T>::iterator> sortedItems;
+		
+		if(items.empty())
+			return sortedItems;
+		
+		sortedItems.reserve(items.size());
+		
+		for(typename std::vector<T*>::const_iterator itemIterator = items.begin(); itemIterator != items.end(); ++itemIterator)
+			sortedItems.push_back(list.get_iterator_from_pointer(*itemIterator));
+			
+		std::sort(sortedItems.begin(), sortedItems.end());
+		
+		return sortedItems;
+	}
+	
+	/**
+	 * @brief Finds all of the lines whose bounding box overlaps the region
+	 * @param region The region to search
+	 * @return Returns the iterators of the lines in list order
+	 */
+	std::vector<plf::colony<edgeLineShape>::iterator> getLinesInRegion(const boundingBox &region)
+	{
+		return sortByListOrder(_lineList, p_lineTree.queryItems(region));
+	}
+	
+	/**
+	 * @brief Finds all of the arcs whose bounding box overlaps the region
+	 * @param region The region to search
+	 * @return Returns the iterators of the arcs in list order
+	 */
+	std::vector<plf::colony<arcShape>::iterator> getArcsInRegion(const boundingBox &region)
+	{
+		return sortByListOrder(_arcList, p_arcTree.queryItems(region));
+	}
+	
+	/**
+	 * @brief Finds all of the nodes that lie within the region
+	 * @param region The region to search
+	 * @return Returns the iterators of the nodes in list order
+	 */
+	std::vector<plf::colony<node>::iterator> getNodesInRegion(const boundingBox &region)
+	{
+		std::vector<node*> foundNodes;
+		
+		p_nodeGrid.visitBox(region.getMinX(), region.getMinY(), region.getMaxX(), region.getMaxY(), [&foundNodes](node *foundNode) -> bool
+		{
+			foundNodes.push_back(foundNode);
+			return false;
+		});
+		
+		return sortByListOrder(_nodeList, foundNodes);
+	}
     
     //! Function that will get the intersection X, Y point of two lines crossing each other
     /*!
@@ -260,9 +697,145 @@ private:
         \return Returns the total number of intersections between arcSegment1 and arcSegment2
     */ 
     int getArcToArcIntersection(arcShape& arcSegment1, arcShape &arcSegment2, Vector *point);
-    
+
+	//! Structure used by the batch intersection check in order to sort all of the geometry along the x-axis
+	struct sweepItem
+	{
+		//! The bounding box of the item. For lines and arcs, this box is grown by the tolerance
+		boundingBox box;
+
+		//! Only one of these pointers will be set for each item
+		node *sweepNode = nullptr;
+
+		edgeLineShape *sweepLine = nullptr;
+
+		arcShape *sweepArc = nullptr;
+	};
+
+	/**
+	 * @brief 	Function that checks all of the geometry for intersections in one batch. This is used by checkIntersections
+	 * 			when all of the geometry is edited (for example after a large move or a paste). The function works in three passes.
+	 * 			First, the nodes are sorted by position and any nodes that are on top of each other are merged into one node.
+	 * 			Next, the nodes and the bounding boxes of the lines/arcs are sorted along the x-axis and swept from left to right (sort and sweep).
+	 * 			Only the items whose boxes overlap are tested which finds every node-on-segment and segment-segment intersection
+	 * 			without testing every pair. A node is created at every intersection point and all of the points where a segment needs to be broken
+	 * 			are recorded. Lastly, every segment is broken up at all of its recorded points at once and removeDuplicateSegments removes any lines/arcs that now lie on top of each other or start and end on the same node.
+	 * 			Hidden lines and arcs are ignored.
+	 * @param tolerance The distance that a node needs to be from a segment in order for the segment to be broken.
+	 * 					This is also the distance used to determine if an intersection point is on top of an existing node
+	 */
+	void resolveIntersections(double tolerance);
+
+	/**
+	 * @brief 	Merges together all of the nodes that are within the tolerance of each other. Unlike the first pass of resolveIntersections,
+	 * 			the nodes do not need to be exactly on top of each other. The node that comes first in the node list is kept and
+	 * 			all of the lines/arcs that were connected to the other nodes are moved over to the kept node.
+	 * 			Any line/arc that now starts and ends on the same node is removed by removeDuplicateSegments.
+	 * @param tolerance Any two nodes that are closer then this distance are merged
+	 */
+	void snapNodes(double tolerance);
+
+	/**
+	 * @brief 	Removes any line that connects the same two nodes as a line that comes before it in the line list.
+	 * 			Arcs are removed if an arc that comes before it goes from the same first node to the same second node with the same angle.
+	 * 			Lines and arcs that start and end on the same node are also removed.
+	 */
+	void removeDuplicateSegments();
+
+	/**
+	 * @brief 	Finds a node that is within the tolerance of a point. If there is no node, then a node is created at the point.
+	 * 			Note that unlike addNode, this function will not break any lines or arcs
+	 * @param xPoint The x-coordinate of the point
+	 * @param yPoint The y-coordinate of the point
+	 * @param tolerance The distance used to determine if a node is on top of the point
+	 * @return Returns the address of the node at the point
+	 */
+	node *getNodeAtPoint(double xPoint, double yPoint, double tolerance);
+
+	/**
+	 * @brief Calculates where a point projects onto a line
+	 * @param lineSegment The line
+	 * @param xPoint The x-coordinate of the point
+	 * @param yPoint The y-coordinate of the point
+	 * @return Returns 0 if the point projects onto the first node and 1 if the point projects onto the second node
+	 */
+	double getPositionAlongLine(edgeLineShape &lineSegment, double xPoint, double yPoint);
+
+	/**
+	 * @brief Calculates the angle between the first node of the arc and a point. The angle is measured counter-clockwise about the center of the arc
+	 * @param arcSegment The arc
+	 * @param xPoint The x-coordinate of the point
+	 * @param yPoint The y-coordinate of the point
+	 * @return Returns the angle in radians. This is between 0 and 2 PI
+	 */
+	double getPositionAlongArc(arcShape &arcSegment, double xPoint, double yPoint);
+
+	/**
+	 * @brief 	Breaks a line into multiple lines at the nodes. The existing line becomes the first piece
+	 * 			and a new line is added for each of the remaining pieces
+	 * @param lineIterator The line that is to be broken
+	 * @param splitNodes The nodes that lie on the line. These do not need to be in order
+	 */
+	void splitLine(plf::colony<edgeLineShape>::iterator lineIterator, std::vector<node*> splitNodes);
+
+	/**
+	 * @brief 	Breaks an arc into multiple arcs at the nodes. This works the same way as splitLine except this is for arcs
+	 * @param arcIterator The arc that is to be broken
+	 * @param splitNodes The nodes that lie on the arc. These do not need to be in order
+	 */
+	void splitArc(plf::colony<arcShape>::iterator arcIterator, std::vector<node*> splitNodes);
+
 public:
     
+    //! The constructor for the class
+    geometryEditor2D()
+    {
+        
+    }
+    
+    /**
+     * @brief   The copy constructor for the class. The lines and arcs of the copy are connected to the nodes of the copy
+     *          through the node handles.
+     * @param editor The geometry editor that is to be copied
+     */
+    geometryEditor2D(const geometryEditor2D &editor)
+    {
+        *this = editor;
+    }
+    
+    /**
+     * @brief   Copies all of the geometry from another editor. The spatial indexes are not copied since they store the addresses of
+     *          the geometry in the other editor. Instead, the indexes are rebuilt from the copied lists.
+     * @param editor The geometry editor that is to be copied
+     * @return Returns a reference to this editor
+     */
+    geometryEditor2D &operator=(const geometryEditor2D &editor)
+    {
+        if(this == &editor)
+            return *this;
+            
+        _nodeList = editor._nodeList;
+        _blockLabelList = editor._blockLabelList;
+        _lineList = editor._lineList;
+        _arcList = editor._arcList;
+        _nodeNumber = editor._nodeNumber;
+        p_arcNumber = editor.p_arcNumber;
+        _nodeInterator1 = nullptr;
+        _nodeInterator2 = nullptr;
+        p_batchIsOpen = false;
+        
+        rebuildHandleTable();
+        relinkSegments();
+        rebuildSpatialIndex();
+        
+        _lastNodeAdded = _nodeList.begin();
+        _lastLineAdded = _lineList.begin();
+        _lastArcAdded = _arcList.begin();
+        _lastBlockLabelAdded = _blockLabelList.begin();
+        
+        return *this;
+    }
+    
     //! This function is used to calculate the shortest distance between a line and a node
     /*!
         This function contains the same underlying principal that operates the getIntersection function
@@ -343,11 +916,15 @@ public:
     
     //! Function that is used to set the node list
     /*!
+        The lines and arcs are moved over to the nodes in the new list that have the same handle.
         \param list The node list that _nodeList will be set to
     */ 
     void setNodeList(plf::colony<node> list)
     {
         _nodeList = list;
+        rebuildHandleTable();
+        relinkSegments();
+        rebuildSpatialIndex();
     }
     
     //! Function that will get the block list and return a pointer pointing to the block list
@@ -368,6 +945,7 @@ public:
     void setBlockLabelList(plf::colony<blockLabel> list)
     {
         _blockLabelList = list;
+        rebuildSpatialIndex();
     }
     
     //! Function that will get the line list and return a pointer pointing to the line list
@@ -383,11 +961,14 @@ public:
     
     //! Function that is used to set the line list
     /*!
+        The lines are connected to the nodes in the node list through the node handles.
         \param list The line list that _lineList will be set to
     */ 
     void setLineList(plf::colony<edgeLineShape> list)
     {
         _lineList = list;
+        relinkSegments();
+        rebuildSpatialIndex();
     }
     
     //! Function that will get the arc list and return a pointer pointing to the arc list
@@ -403,11 +984,14 @@ public:
     
     //! Function that is used to set the arc list
     /*!
+        \sa setLineList
         \param list The arc list that _arcList will be set to
     */ 
     void setArcList(plf::colony<arcShape> list)
     {
         _arcList = list;
+        relinkSegments();
+        rebuildSpatialIndex();
     }
     
     //! Function that is called in order to add a node a list
@@ -449,6 +1033,9 @@ public:
         newNode.setCenter(xPoint, yPoint);
         newNode.setDraggingState(true);
         _lastNodeAdded = _nodeList.insert(newNode);
+        _lastNodeAdded->setHandle(p_nodeHandles.acquire(&(*_lastNodeAdded)));
+        p_geometryRevision++;
+        p_nodeRevision++;
     }
     
     //! Function that is called to add a block label to the block label list
@@ -479,6 +1066,493 @@ public:
         newLabel.setCenter(xPoint, yPoint);
         newLabel.setDraggingState(true);
         _lastBlockLabelAdded = _blockLabelList.insert(newLabel);
+        p_geometryRevision++;
+        p_blockLabelRevision++;
+    }
+    
+    /**
+     * @brief   Function that is called in order to remove a node from the node list. This function should be used
+     *          instead of directly erasing the node from the list so that the spatial index stays in sync with the list.
+     *          If the node is the last node added, then the last node added is reset to the beginning of the list.
+     * @param nodeIterator The iterator pointing to the node that is to be removed
+     * @return Returns an iterator pointing to the next node in the list
+     */
+    plf::colony<node>::iterator eraseNode(plf::colony<node>::iterator nodeIterator)
+    {
+        bool isLastNodeAdded = (nodeIterator == _lastNodeAdded);
+        
+        // The box can only shrink if the node was on the edge of the box
+        if(p_modelBoxIsValid && !nodeIterator->getDraggingState() && p_modelBox.isOnBoundary(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate()))
+            p_modelBoxIsValid = false;
+        
+        p_nodeGrid.erase(&(*nodeIterator));
+        p_nodeStore.erase(&(*nodeIterator));
+        p_selectedNodes.erase(&(*nodeIterator));
+        p_nodeHandles.release(nodeIterator->getHandle());
+        p_lineIncidence.eraseNode(&(*nodeIterator));
+        p_arcIncidence.eraseNode(&(*nodeIterator));
+        p_geometryRevision++;
+        p_nodeRevision++;
+        
+        plf::colony<node>::iterator nextIterator = _nodeList.erase(nodeIterator);
+        
+        if(isLastNodeAdded)
+            _lastNodeAdded = _nodeList.begin();
+            
+        return nextIterator;
+    }
+    
+    /**
+     * @brief   Function that is called in order to remove a block label from the list.
+     *          This works the same way as eraseNode except this is for block labels.
+     * @param labelIterator The iterator pointing to the block label that is to be removed
+     * @return Returns an iterator pointing to the next block label in the list
+     */
+    plf::colony<blockLabel>::iterator eraseBlockLabel(plf::colony<blockLabel>::iterator labelIterator)
+    {
+        bool isLastLabelAdded = (labelIterator == _lastBlockLabelAdded);
+        
+        p_blockLabelGrid.erase(&(*labelIterator));
+        p_selectedBlockLabels.erase(&(*labelIterator));
+        p_geometryRevision++;
+        p_blockLabelRevision++;
+        
+        plf::colony<blockLabel>::iterator nextIterator = _blockLabelList.erase(labelIterator);
+        
+        if(isLastLabelAdded)
+            _lastBlockLabelAdded = _blockLabelList.begin();
+            
+        return nextIterator;
+    }
+    
+    /**
+     * @brief   Function that is called in order to remove a line from the line list. This function should be used
+     *          instead of directly erasing the line from the list so that the spatial index stays in sync with the list.
+     *          If the line is the last line added, then the last line added is reset to the beginning of the list.
+     * @param lineIterator The iterator pointing to the line that is to be removed
+     * @return Returns an iterator pointing to the next line in the list
+     */
+    plf::colony<edgeLineShape>::iterator eraseLine(plf::colony<edgeLineShape>::iterator lineIterator)
+    {
+        bool isLastLineAdded = (lineIterator == _lastLineAdded);
+        
+        p_lineTree.erase(&(*lineIterator));
+        p_lineIncidence.erase(&(*lineIterator));
+        p_selectedLines.erase(&(*lineIterator));
+        p_geometryRevision++;
+        p_lineRevision++;
+        
+        plf::colony<edgeLineShape>::iterator nextIterator = _lineList.erase(lineIterator);
+        
+        if(isLastLineAdded)
+            _lastLineAdded = _lineList.begin();
+            
+        return nextIterator;
+    }
+    
+    /**
+     * @brief   Function that is called in order to remove an arc from the arc list.
+     *          This works the same way as eraseLine except this is for arcs.
+     * @param arcIterator The iterator pointing to the arc that is to be removed
+     * @return Returns an iterator pointing to the next arc in the list
+     */
+    plf::colony<arcShape>::iterator eraseArc(plf::colony<arcShape>::iterator arcIterator)
+    {
+        bool isLastArcAdded = (arcIterator == _lastArcAdded);
+        
+        p_arcTree.erase(&(*arcIterator));
+        p_arcIncidence.erase(&(*arcIterator));
+        p_selectedArcs.erase(&(*arcIterator));
+        p_geometryRevision++;
+        p_arcRevision++;
+        
+        plf::colony<arcShape>::iterator nextIterator = _arcList.erase(arcIterator);
+        
+        if(isLastArcAdded)
+            _lastArcAdded = _arcList.begin();
+            
+        return nextIterator;
+    }
+    
+    /**
+     * @brief   Gets the smallest box that contains all of the nodes. This is used to calculate the default tolerance
+     *          when adding lines and arcs and by the canvas in order to zoom to the extents of the model.
+     *          The box is only recalculated from the node list if a node on the edge of the box was removed or moved since the last call.
+     * @param box The box that will be set to the extents of the model
+     * @return Returns false if there are no nodes. Otherwise, returns true
+     */
+    bool getModelBoundingBox(boundingBox &box)
+    {
+        if(!p_modelBoxIsValid)
+        {
+            bool foundNode = false;
+            
+            for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+            {
+                if(nodeIterator->getDraggingState())
+                    continue;
+                    
+                if(!foundNode)
+                {
+                    p_modelBox = boundingBox(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate(), nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
+                    foundNode = true;
+                }
+                else
+                    p_modelBox.expandToInclude(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
+            }
+            
+            if(!foundNode)
+                return false;
+                
+            p_modelBoxIsValid = true;
+        }
+        
+        box = p_modelBox;
+        
+        return true;
+    }
+    
+    /**
+     * @brief   Gets the revision of the geometry. The revision changes every time that geometry is added, removed or moved
+     *          through the editor. This is used by the renderer in order to know if the vertex buffers are out of date.
+     * @return  Returns the current revision
+     */
+    unsigned long getGeometryRevision()
+    {
+        return p_geometryRevision;
+    }
+    
+    //! Gets the revision of the nodes. This only changes when a node is added, removed or moved
+    unsigned long getNodeRevision()
+    {
+        return p_nodeRevision;
+    }
+    
+    //! Gets the revision of the lines. This only changes when a line is added, removed or its endpoints change
+    unsigned long getLineRevision()
+    {
+        return p_lineRevision;
+    }
+    
+    //! Gets the revision of the arcs. This only changes when an arc is added, removed or its endpoints change
+    unsigned long getArcRevision()
+    {
+        return p_arcRevision;
+    }
+    
+    //! Gets the revision of the block labels. This only changes when a block label is added, removed or moved
+    unsigned long getBlockLabelRevision()
+    {
+        return p_blockLabelRevision;
+    }
+    
+    /**
+     * @brief   Gets the packed coordinates of all of the nodes that are not being dragged. This is used to draw all of the nodes at once
+     * @return  Returns a reference to the node store
+     */
+    const nodeStore &getNodeStore()
+    {
+        return p_nodeStore;
+    }
+    
+    /**
+     * @brief   Gets all of the nodes inside of a selection window. The nodes are found through the spatial grid in the same way as getBlockLabelsInWindow.
+     *          If the window covers more cells then there are nodes, the grid checks every node instead of visiting the cells.
+     * @param window The selection window. The edges of the window are included
+     * @return  Returns the addresses of the nodes. The nodes are not in list order
+     */
+    std::vector<node*> getNodesInWindow(const boundingBox &window)
+    {
+        std::vector<node*> foundNodes;
+        
+        p_nodeGrid.visitBox(window.getMinX(), window.getMinY(), window.getMaxX(), window.getMaxY(), [&foundNodes](node *foundNode) -> bool
+        {
+            foundNodes.push_back(foundNode);
+            return false;
+        });
+        
+        return foundNodes;
+    }
+    
+    /**
+     * @brief   Gets all of the block labels inside of a selection window. The labels are found through the spatial grid
+     * @param window The selection window. The edges of the window are included
+     * @return  Returns the addresses of the block labels. The labels are not in list order
+     */
+    std::vector<blockLabel*> getBlockLabelsInWindow(const boundingBox &window)
+    {
+        std::vector<blockLabel*> foundLabels;
+        
+        p_blockLabelGrid.visitBox(window.getMinX(), window.getMinY(), window.getMaxX(), window.getMaxY(), [&foundLabels](blockLabel *foundLabel) -> bool
+        {
+            foundLabels.push_back(foundLabel);
+            return false;
+        });
+        
+        return foundLabels;
+    }
+    
+    /**
+     * @brief   Gets all of the lines that have at least one node inside of a selection window (a crossing selection).
+     *          Only the lines whose bounding box overlaps the window are checked.
+     * @param window The selection window. The edges of the window are included
+     * @return  Returns the addresses of the lines. The lines are not in list order
+     */
+    std::vector<edgeLineShape*> getLinesCrossingWindow(const boundingBox &window)
+    {
+        std::vector<edgeLineShape*> foundLines;
+        
+        p_lineTree.query(window, [&](edgeLineShape *foundLine) -> bool
+        {
+            if(window.contains(foundLine->getFirstNode()->getCenterXCoordinate(), foundLine->getFirstNode()->getCenterYCoordinate()) || window.contains(foundLine->getSecondNode()->getCenterXCoordinate(), foundLine->getSecondNode()->getCenterYCoordinate()))
+                foundLines.push_back(foundLine);
+                
+            return false;
+        });
+        
+        return foundLines;
+    }
+    
+    /**
+     * @brief   Gets all of the arcs that have at least one node inside of a selection window. This works the same way
+     *          as getLinesCrossingWindow except this is for arcs
+     * @param window The selection window. The edges of the window are included
+     * @return  Returns the addresses of the arcs. The arcs are not in list order
+     */
+    std::vector<arcShape*> getArcsCrossingWindow(const boundingBox &window)
+    {
+        std::vector<arcShape*> foundArcs;
+        
+        p_arcTree.query(window, [&](arcShape *foundArc) -> bool
+        {
+            if(window.contains(foundArc->getFirstNode()->getCenterXCoordinate(), foundArc->getFirstNode()->getCenterYCoordinate()) || window.contains(foundArc->getSecondNode()->getCenterXCoordinate(), foundArc->getSecondNode()->getCenterYCoordinate()))
+                foundArcs.push_back(foundArc);
+                
+            return false;
+        });
+        
+        return foundArcs;
+    }
+    
+    /**
+     * @brief   Erases all of the selected geometry. The lines and arcs that are connected to a selected node are erased along with the node.
+     *          Only the selected geometry and the segments that are connected to the selected nodes are visited. The lines and arcs are erased
+     *          before the nodes so that the incidence indexes never hold a segment whose node was erased.
+     */
+    void eraseSelection()
+    {
+        for(std::unordered_set<node*>::iterator nodeIterator = p_selectedNodes.begin(); nodeIterator != p_selectedNodes.end(); ++nodeIterator)
+        {
+            std::vector<edgeLineShape*> connectedLines = p_lineIncidence.getSegments(*nodeIterator);
+            for(std::vector<edgeLineShape*>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
+                setSelectState(**lineIterator, true);
+            
+            std::vector<arcShape*> connectedArcs = p_arcIncidence.getSegments(*nodeIterator);
+            for(std::vector<arcShape*>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
+                setSelectState(**arcIterator, true);
+        }
+        
+        /* The erase functions remove the geometry from the selected sets, so the sets are copied before erasing */
+        std::vector<plf::colony<edgeLineShape>::iterator> selectedLines = sortByListOrder(_lineList, std::vector<edgeLineShape*>(p_selectedLines.begin(), p_selectedLines.end()));
+        for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = selectedLines.begin(); lineIterator != selectedLines.end(); ++lineIterator)
+            eraseLine(*lineIterator);
+        
+        std::vector<plf::colony<arcShape>::iterator> selectedArcs = sortByListOrder(_arcList, std::vector<arcShape*>(p_selectedArcs.begin(), p_selectedArcs.end()));
+        for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = selectedArcs.begin(); arcIterator != selectedArcs.end(); ++arcIterator)
+            eraseArc(*arcIterator);
+        
+        std::vector<plf::colony<node>::iterator> selectedNodes = sortByListOrder(_nodeList, std::vector<node*>(p_selectedNodes.begin(), p_selectedNodes.end()));
+        for(std::vector<plf::colony<node>::iterator>::iterator nodeIterator = selectedNodes.begin(); nodeIterator != selectedNodes.end(); ++nodeIterator)
+            eraseNode(*nodeIterator);
+        
+        std::vector<plf::colony<blockLabel>::iterator> selectedLabels = sortByListOrder(_blockLabelList, std::vector<blockLabel*>(p_selectedBlockLabels.begin(), p_selectedBlockLabels.end()));
+        for(std::vector<plf::colony<blockLabel>::iterator>::iterator labelIterator = selectedLabels.begin(); labelIterator != selectedLabels.end(); ++labelIterator)
+            eraseBlockLabel(*labelIterator);
+    }
+    
+    /**
+     * @brief   Selects every line and arc whose nodes are both selected. This is used after the nodes inside of a window
+     *          have been selected in order to select the segments that lie fully inside of the selection. Only the segments
+     *          that are connected to the selected nodes are visited.
+     * @return  Returns true if any line or arc has both of its nodes selected. Otherwise, returns false
+     */
+    bool selectSegmentsOfSelectedNodes()
+    {
+        bool foundSegment = false;
+        
+        for(std::unordered_set<node*>::iterator nodeIterator = p_selectedNodes.begin(); nodeIterator != p_selectedNodes.end(); ++nodeIterator)
+        {
+            std::vector<edgeLineShape*> connectedLines = p_lineIncidence.getSegments(*nodeIterator);
+            for(std::vector<edgeLineShape*>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
+            {
+                if((*lineIterator)->getFirstNode()->getIsSelectedState() && (*lineIterator)->getSecondNode()->getIsSelectedState())
+                {
+                    setSelectState(**lineIterator, true);
+                    foundSegment = true;
+                }
+            }
+            
+            std::vector<arcShape*> connectedArcs = p_arcIncidence.getSegments(*nodeIterator);
+            for(std::vector<arcShape*>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
+            {
+                if((*arcIterator)->getFirstNode()->getIsSelectedState() && (*arcIterator)->getSecondNode()->getIsSelectedState())
+                {
+                    setSelectState(**arcIterator, true);
+                    foundSegment = true;
+                }
+            }
+        }
+        
+        return foundSegment;
+    }
+    
+    /**
+     * @brief   Gets all of the lines that are connected to a node. The lines are matched by the address of the node.
+     *          This takes the place of looping through the entire line list and comparing the endpoints.
+     * @param connectedNode The node
+     * @return Returns the iterators of the lines in list order
+     */
+    std::vector<plf::colony<edgeLineShape>::iterator> getLinesAtNode(node &connectedNode)
+    {
+        return sortByListOrder(_lineList, p_lineIncidence.getSegments(&connectedNode));
+    }
+    
+    /**
+     * @brief   Gets all of the arcs that are connected to a node. This works the same way as getLinesAtNode except this is for arcs.
+     * @param connectedNode The node
+     * @return Returns the iterators of the arcs in list order
+     */
+    std::vector<plf::colony<arcShape>::iterator> getArcsAtNode(node &connectedNode)
+    {
+        return sortByListOrder(_arcList, p_arcIncidence.getSegments(&connectedNode));
+    }
+    
+    /**
+     * @brief   Finds the node that is closest to a point. This is used to find the node that the user clicked on.
+     *          Only the nodes in the spatial index are searched. So, nodes that are being dragged are never found.
+     * @param xCoordinate The x-coordinate of the point
+     * @param yCoordinate The y-coordinate of the point
+     * @param tolerance Only nodes that are closer then this distance to the point are found
+     * @return Returns the address of the closest node. If there is no node within the tolerance, returns nullptr
+     */
+    node *pickNode(double xCoordinate, double yCoordinate, double tolerance);
+    
+    /**
+     * @brief   Finds the block label that is closest to a point. This works the same way as pickNode except this is for block labels
+     * @param xCoordinate The x-coordinate of the point
+     * @param yCoordinate The y-coordinate of the point
+     * @param tolerance Only block labels that are closer then this distance to the point are found
+     * @return Returns the address of the closest block label. If there is no block label within the tolerance, returns nullptr
+     */
+    blockLabel *pickBlockLabel(double xCoordinate, double yCoordinate, double tolerance);
+    
+    /**
+     * @brief   Finds the line that is closest to a point. Only the lines whose bounding box is within the tolerance of the
+     *          point are checked.
+     * @param xCoordinate The x-coordinate of the point
+     * @param yCoordinate The y-coordinate of the point
+     * @param tolerance Only lines that are closer then this distance to the point are found
+     * @return Returns the address of the closest line. If there is no line within the tolerance, returns nullptr
+     */
+    edgeLineShape *pickLine(double xCoordinate, double yCoordinate, double tolerance);
+    
+    /**
+     * @brief   Finds the arc that is closest to a point. This works the same way as pickLine except this is for arcs
+     * @param xCoordinate The x-coordinate of the point
+     * @param yCoordinate The y-coordinate of the point
+     * @param tolerance Only arcs that are closer then this distance to the point are found
+     * @return Returns the address of the closest arc. If there is no arc within the tolerance, returns nullptr
+     */
+    arcShape *pickArc(double xCoordinate, double yCoordinate, double tolerance);
+    
+    /**
+     * @brief   Sets the selected state of a node in the node list. This function should be used instead of setting
+     *          the state on the node directly so that the set of selected nodes stays in sync with the list.
+     * @param selectedNode The node
+     * @param state The new selected state
+     */
+    void setSelectState(node &selectedNode, bool state)
+    {
+        selectedNode.setSelectState(state);
+        trackSelectState(p_selectedNodes, selectedNode);
+    }
+    
+    //! Sets the selected state of a block label in the block label list. \sa setSelectState(node &, bool)
+    void setSelectState(blockLabel &selectedLabel, bool state)
+    {
+        selectedLabel.setSelectState(state);
+        trackSelectState(p_selectedBlockLabels, selectedLabel);
+    }
+    
+    //! Sets the selected state of a line in the line list. \sa setSelectState(node &, bool)
+    void setSelectState(edgeLineShape &selectedLine, bool state)
+    {
+        selectedLine.setSelectState(state);
+        trackSelectState(p_selectedLines, selectedLine);
+    }
+    
+    //! Sets the selected state of an arc in the arc list. \sa setSelectState(node &, bool)
+    void setSelectState(arcShape &selectedArc, bool state)
+    {
+        selectedArc.setSelectState(state);
+        trackSelectState(p_selectedArcs, selectedArc);
+    }
+    
+    //! Unselects all of the selected nodes. Only the nodes that are selected are visited
+    void clearSelectedNodes()
+    {
+        clearSelectedItems(p_selectedNodes);
+    }
+    
+    //! Unselects all of the selected block labels. Only the block labels that are selected are visited
+    void clearSelectedBlockLabels()
+    {
+        clearSelectedItems(p_selectedBlockLabels);
+    }
+    
+    //! Unselects all of the selected lines. Only the lines that are selected are visited
+    void clearSelectedLines()
+    {
+        clearSelectedItems(p_selectedLines);
+    }
+    
+    //! Unselects all of the selected arcs. Only the arcs that are selected are visited
+    void clearSelectedArcs()
+    {
+        clearSelectedItems(p_selectedArcs);
+    }
+    
+    //! Unselects all of the selected geometry
+    void clearSelection()
+    {
+        clearSelectedNodes();
+        clearSelectedBlockLabels();
+        clearSelectedLines();
+        clearSelectedArcs();
+    }
+    
+    //! Returns the number of nodes that are selected
+    unsigned int getSelectedNodeCount()
+    {
+        return p_selectedNodes.size();
+    }
+    
+    //! Returns the number of block labels that are selected
+    unsigned int getSelectedBlockLabelCount()
+    {
+        return p_selectedBlockLabels.size();
+    }
+    
+    //! Returns the number of lines that are selected
+    unsigned int getSelectedLineCount()
+    {
+        return p_selectedLines.size();
+    }
+    
+    //! Returns the number of arcs that are selected
+    unsigned int getSelectedArcCount()
+    {
+        return p_selectedArcs.size();
     }
     
     //! Function that is called in order to add a line to the line list
@@ -550,6 +1624,109 @@ public:
     */ 
     bool addArc(arcShape &arcSeg, double tolerance, bool nodesAreSelected);
     
+    /**
+     * @brief   Function that is called in order to start adding a large amount of geometry at once (for example, when importing a drawing).
+     *          After this function is called, the geometry should be added through appendNode, appendLine and appendArc. These
+     *          functions do not perform any of the checks that addNode, addLine and addArc perform. Instead, all of the checks are performed
+     *          at once when commitBatch is called. No other function that edits or searches the geometry should be called until the batch is committed.
+     * \sa commitBatch
+     */
+    void beginBatch()
+    {
+        p_batchIsOpen = true;
+    }
+    
+    /**
+     * @brief   Adds a node to the node list without checking if the node is on top of any other geometry. If there is no batch open,
+     *          the node is still placed into the spatial index.
+     * @param xPoint The x-coordinate of the node
+     * @param yPoint The y-coordinate of the node
+     * @return Returns the address of the new node. This is used to connect the lines and arcs that are appended afterwards
+     */
+    node *appendNode(double xPoint, double yPoint)
+    {
+        node newNode;
+        
+        newNode.setCenter(xPoint, yPoint);
+        newNode.setNodeID(++_nodeNumber);
+        
+        if(p_batchIsOpen)
+        {
+            _lastNodeAdded = _nodeList.insert(newNode);
+            _lastNodeAdded->setHandle(p_nodeHandles.acquire(&(*_lastNodeAdded)));
+        }
+        else
+            _lastNodeAdded = insertNode(newNode);
+            
+        return &(*_lastNodeAdded);
+    }
+    
+    /**
+     * @brief   Adds a line to the line list without checking for any intersections or if the line already exists
+     * @param firstNode The address of the first node of the line
+     * @param secondNode The address of the second node of the line
+     * @return Returns false if either node does not exist or if both nodes are the same. Otherwise, returns true
+     */
+    bool appendLine(node *firstNode, node *secondNode)
+    {
+        if(!firstNode || !secondNode || firstNode == secondNode)
+            return false;
+            
+        edgeLineShape newLine;
+        
+        newLine.setFirstNode(*firstNode);
+        newLine.setSecondNode(*secondNode);
+        newLine.calculateDistance();
+        
+        if(p_batchIsOpen)
+            _lastLineAdded = _lineList.insert(newLine);
+        else
+            _lastLineAdded = insertLine(newLine);
+            
+        return true;
+    }
+    
+    /**
+     * @brief   Adds an arc to the arc list without checking for any intersections or if the arc already exists
+     * @param arcSeg The arc that is to be added. The first node, second node and the arc angle need to be set.
+     *               The arc is calculated before it is added
+     * @return Returns false if either node of the arc does not exist or if both nodes are the same. Otherwise, returns true
+     */
+    bool appendArc(arcShape &arcSeg)
+    {
+        if(!arcSeg.getFirstNode() || !arcSeg.getSecondNode() || arcSeg.getFirstNode() == arcSeg.getSecondNode())
+            return false;
+            
+        arcSeg.calculate();
+        arcSeg.setArcID(++p_arcNumber);
+        
+        if(p_batchIsOpen)
+            _lastArcAdded = _arcList.insert(arcSeg);
+        else
+            _lastArcAdded = insertArc(arcSeg);
+            
+        return true;
+    }
+    
+    /**
+     * @brief   Function that is called once all of the geometry for a batch has been appended. The spatial indexes are rebuilt once
+     *          and then all of the geometry is checked in one pass. First, any nodes that are within the tolerance of each other are
+     *          merged (snapping). Next, any duplicate lines/arcs are removed. Then, every segment is broken at any intersection point and at any
+     *          node that lies on the segment (see resolveIntersections). Lastly, any duplicates that were created from the splitting are removed.
+     *          Unlike calling addLine and addArc for each segment, the time that this function takes grows with the number of
+     *          items plus the number of intersections instead of the square of the number of items.
+     * @param tolerance The distance used for snapping and for determining if a node lies on a segment. If 0, then the tolerance
+     *                  is calculated from the size of the model in the same way as addLine
+     * @return Returns false if there is no batch open. Otherwise, returns true
+     */
+    bool commitBatch(double tolerance = 0);
+    
+    //! Returns true if beginBatch was called and the batch has not been committed yet
+    bool isBatchOpen()
+    {
+        return p_batchIsOpen;
+    }
+    
     //! Function that is called in order to reset the seelected nodes variables back to null pointers
     /*!
         The default value for _nodeInterator1 and _nodeInterator2 is the null pointer. This function
@@ -657,28 +1834,51 @@ public:
 	 * 			after the data structure is loaded, then the addresses of all of nodes will change once the 
 	 * 			data structure is copied. Therefor, it is necessary to call this function which will rebuild
 	 * 			all of the node addresses contained within the arcs/lines once the data structure is copied.
-	 * 			The function will loop through the entire node list and compare the node with the node ID saved
-	 * 			in the arcs and lines. If there is a match for either the first or second node, the function 
-	 * 			will then set the address of the first/second node of the arc/line to the matched node.
+	 * 			The function first builds a table that looks up the address of a node from the node ID. Then, the
+	 * 			function loops through the line list and the arc list once and sets the address of the first/second node
+	 * 			to the node that matches the node ID saved in the arc/line. If two nodes have the same ID, the node that comes
+	 * 			later in the node list is used.
+	 * 			If every line and arc still holds the handles of its nodes (which is the case when the lists were copied),
+	 * 			the nodes are found through the handle table instead and the node ID table is not built.
 	 */
 	void rebuildDataStructure()
 	{
-		for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); nodeIterator++)
+		rebuildHandleTable();
+		
+		// The node ID table is only needed for lines and arcs that do not have handles (such as the ones that were loaded from file)
+		if(!relinkSegments())
 		{
+			std::unordered_map<unsigned long, node*> nodeTable;
+		
+			nodeTable.reserve(_nodeList.size());
+		
+			for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); nodeIterator++)
+				nodeTable[nodeIterator->getNodeID()] = &(*nodeIterator);
+			
 			for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); lineIterator++)
 			{
-				if(nodeIterator->getNodeID() == lineIterator->getFirstNodeID())
-					lineIterator->setFirstNode(*nodeIterator);
-				else if(nodeIterator->getNodeID() == lineIterator->getSecondNodeID())
-					lineIterator->setSecondNode(*nodeIterator);
+				std::unordered_map<unsigned long, node*>::iterator foundNode = nodeTable.find(lineIterator->getFirstNodeID());
+				if(foundNode != nodeTable.end())
+					lineIterator->setFirstNode(*foundNode->second);
+				
+				foundNode = nodeTable.find(lineIterator->getSecondNodeID());
+				if(foundNode != nodeTable.end())
+					lineIterator->setSecondNode(*foundNode->second);
 			}
-			
+		
 			for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); arcIterator++)
 			{
-				if(nodeIterator->getNodeID() == arcIterator->getFirstNodeID())
-					arcIterator->setFirstNode(*nodeIterator);
-				else if(nodeIterator->getNodeID() == arcIterator->getSecondNodeID())
-					arcIterator->setSecondNode(*nodeIterator);
+				std::unordered_map<unsigned long, node*>::iterator firstNode = nodeTable.find(arcIterator->getFirstNodeID());
+				if(firstNode != nodeTable.end())
+					arcIterator->setFirstNode(*firstNode->second);
+				
+				std::unordered_map<unsigned long, node*>::iterator secondNode = nodeTable.find(arcIterator->getSecondNodeID());
+				if(secondNode != nodeTable.end())
+					arcIterator->setSecondNode(*secondNode->second);
+				
+				// The center of the arc is not saved in the archive
+				if(firstNode != nodeTable.end() && secondNode != nodeTable.end())
+					arcIterator->calculate();
 			}
 		}
 		
@@ -686,6 +1886,8 @@ public:
 		_lastBlockLabelAdded = _blockLabelList.begin();
 		_lastLineAdded = _lineList.begin();
 		_lastNodeAdded = _nodeList.begin();
+		
+		rebuildSpatialIndex();
 	}
 };
 
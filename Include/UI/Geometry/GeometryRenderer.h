@@ -0,0 +1,417 @@
+#ifndef GEOMETRY_RENDERER_H_
+#define GEOMETRY_RENDERER_H_
+
+#include <vector>
+
+#include <QOpenGLFunctions>
+
+#include "Include/UI/Geometry/geometryShapes.h"
+#include "Include/UI/Geometry/GeometryEditor2D.h"
+#include "Include/UI/Geometry/BoundingBox.h"
+
+/**
+ * @class geometryRenderer
+ * @file GeometryRenderer.h
+ * @brief   Draws the nodes, block labels, lines and arcs of a geometry editor from vertex buffers that are kept on the graphics card.
+ *          Instead of sending every vertex to OpenGL on every frame (which is what calling draw() on every piece of geometry does),
+ *          the vertices are only uploaded when the geometry changes. Panning and zooming only change the projection and
+ *          the frame is drawn with a handful of glDrawArrays calls.
+ *          The geometry is split into batches with one batch for each way that the geometry is drawn (for example, the lines that are
+ *          hidden are drawn with a stipple and are kept in their own batch). Each batch has a position buffer and a color buffer.
+ *          The position buffers of a batch are rebuilt when the revision of the type of geometry in the batch changes (so adding a block label
+ *          does not rebuild the lines). Selecting geometry only changes the color buffers.
+ *          Only the fixed function vertex arrays are used so that the renderer works on the same contexts as the rest of the canvas.
+ *          Nodes and block labels that are being dragged are not stored in the buffers since these move on every frame.
+ *
+ *          The vertices of each batch are sorted into a grid of tiles that covers the model. Only the tiles that overlap the
+ *          visible window are drawn. The amount of detail depends on the size of a pixel: arcs are broken into only as many
+ *          segments as are needed for the arc to look smooth on the screen (but never more then the number of segments of the arc)
+ *          and nodes (or block labels) that fall into the same pixel are drawn as one point. The size of a pixel is rounded
+ *          down to a power of two so that the buffers are only rebuilt after the zoom has changed by a factor of two.
+ *
+ *          The renderer can also be used to find the geometry under the mouse (see pick). Every piece of geometry is given an ID and each
+ *          batch keeps a second color buffer that holds the ID of each vertex. When picking, the batches are drawn with these colors into a small
+ *          offscreen framebuffer that covers only the pixels around the mouse. The pixels are then read back and the IDs are turned back into the geometry.
+ */
+class geometryRenderer : protected QOpenGLFunctions
+{
+private:
+	//! The number of tiles along each side of the grid of tiles
+	enum : unsigned int { TILES_PER_SIDE = 32 };
+
+	//! The number of pick IDs that each batch is given. Each batch has its own range so that a batch can be rebuilt without changing the IDs of the other batches
+	enum : GLuint { PICK_IDS_PER_BATCH = 1u << 28 };
+
+	/**
+	 * @brief 	A range of vertices and the geometry that the vertices belong to. Usually, this is one piece of geometry.
+	 * 			When nodes are clustered, all of the nodes in the same pixel share one vertex.
+	 */
+	struct vertexGroup
+	{
+		//! The first vertex of the group
+		GLint firstVertex = 0;
+
+		//! The number of vertices in the group
+		GLsizei vertexCount = 0;
+
+		//! The position of the first piece of geometry of the group in the list of geometry
+		unsigned int firstItem = 0;
+
+		//! The number of pieces of geometry that share the vertices
+		unsigned int itemCount = 0;
+
+		//! The smallest box that contains all of the vertices of the group
+		boundingBox box;
+
+		//! The tile that the group is sorted into
+		unsigned int tile = 0;
+	};
+
+	/**
+	 * @brief The vertices of one batch of geometry
+	 */
+	struct vertexBatch
+	{
+		//! The x and y coordinate of each vertex. The vertices are sorted by tile
+		std::vector<GLdouble> positions;
+
+		//! The red, green, blue and alpha value of each vertex
+		std::vector<GLubyte> colors;
+
+		//! The geometry that is drawn by the batch. This is used to update the colors when the selection changes
+		std::vector<geometry2D*> items;
+
+		//! The first vertex of each piece of geometry
+		std::vector<GLint> itemFirstVertex;
+
+		//! The number of vertices of each piece of geometry
+		std::vector<GLsizei> itemVertexCount;
+
+		//! The first vertex of each tile. The list has one more entry then the number of tiles so that the range of tile i is [i, i + 1)
+		std::vector<GLint> tileFirstVertex;
+
+		//! The first piece of geometry of each tile. This has the same layout as tileFirstVertex
+		std::vector<unsigned int> tileFirstItem;
+
+		//! The smallest box that contains all of the vertices in each tile
+		std::vector<boundingBox> tileBounds;
+
+		//! The area that is covered by the grid of tiles. This is the smallest box that contains all of the vertices of the batch
+		boundingBox tileArea;
+
+		//! The groups that have been added since the batch was reset. These are sorted into the tiles by finishBatch
+		std::vector<vertexGroup> groups;
+
+		//! The vertices of the groups before the groups are sorted
+		std::vector<GLdouble> stagedPositions;
+
+		//! The geometry of the groups before the groups are sorted
+		std::vector<geometry2D*> stagedItems;
+
+		//! The color of the geometry that is not selected
+		GLubyte color[3];
+
+		//! The name of the position buffer on the graphics card
+		GLuint positionBuffer = 0;
+
+		//! The name of the color buffer on the graphics card
+		GLuint colorBuffer = 0;
+
+		//! The ID of each vertex stored as a red, green, blue and alpha value. The ID of a vertex is the ID of the first piece of geometry that the vertex belongs to
+		std::vector<GLubyte> pickColors;
+
+		//! The ID of the first piece of geometry in the batch. The ID of the piece of geometry at position i in the list of geometry is firstPickID + i
+		GLuint firstPickID = 0;
+
+		//! The name of the buffer on the graphics card that holds the pick colors
+		GLuint pickColorBuffer = 0;
+
+		//! Returns the number of vertices in the batch
+		GLsizei size() const
+		{
+			return positions.size() / 2;
+		}
+	};
+
+	//! The lines that are not hidden. Drawn as GL_LINES
+	vertexBatch p_lines;
+
+	//! The lines that are hidden. Drawn as GL_LINES with a stipple
+	vertexBatch p_hiddenLines;
+
+	//! The arcs that are not hidden. Each arc is broken up into its segments and drawn as GL_LINES
+	vertexBatch p_arcs;
+
+	//! The arcs that are hidden. Each arc is drawn as its own GL_LINE_STRIP so that the stipple pattern runs along the whole arc
+	vertexBatch p_hiddenArcs;
+
+	//! The nodes. Drawn as GL_POINTS
+	vertexBatch p_nodes;
+
+	//! The block labels. Drawn as GL_POINTS
+	vertexBatch p_blockLabels;
+
+	//! The revision of the nodes of the editor that p_nodes was built from
+	unsigned long p_nodeRevision = 0;
+
+	//! The revision of the lines of the editor that p_lines and p_hiddenLines were built from
+	unsigned long p_lineRevision = 0;
+
+	//! The revision of the arcs of the editor that p_arcs and p_hiddenArcs were built from
+	unsigned long p_arcRevision = 0;
+
+	//! The revision of the block labels of the editor that p_blockLabels was built from
+	unsigned long p_blockLabelRevision = 0;
+
+	//! The power of two that the size of a pixel was rounded to when the position buffers were built
+	int p_detailLevel = 0;
+
+	//! Set to true when the position buffers need to be rebuilt even if the revision of the editor did not change
+	bool p_geometryIsDirty = true;
+
+	//! Set to true when the selected state of any geometry might have changed
+	bool p_colorsAreDirty = true;
+
+	//! Set to true once the buffers have been created
+	bool p_isInitialized = false;
+
+	//! The name of the offscreen framebuffer that the IDs are drawn into when picking
+	GLuint p_pickFramebuffer = 0;
+
+	//! The name of the color buffer of p_pickFramebuffer
+	GLuint p_pickRenderbuffer = 0;
+
+	//! The width and height in pixels of p_pickRenderbuffer
+	GLsizei p_pickBufferSize = 0;
+
+	/**
+	 * @brief Empties the lists of a batch. The buffers on the graphics card are not touched
+	 * @param batch The batch that is to be cleared
+	 * @param red The red part of the color of the geometry that is not selected
+	 * @param green The green part of the color of the geometry that is not selected
+	 * @param blue The blue part of the color of the geometry that is not selected
+	 */
+	void resetBatch(vertexBatch &batch, GLubyte red, GLubyte green, GLubyte blue)
+	{
+		batch.groups.clear();
+		batch.stagedPositions.clear();
+		batch.stagedItems.clear();
+		batch.color[0] = red;
+		batch.color[1] = green;
+		batch.color[2] = blue;
+	}
+
+	//! Starts a new group of vertices in the batch
+	void beginGroup(vertexBatch &batch)
+	{
+		vertexGroup group;
+
+		group.firstVertex = batch.stagedPositions.size() / 2;
+		group.firstItem = batch.stagedItems.size();
+
+		batch.groups.push_back(group);
+	}
+
+	/**
+	 * @brief Adds a vertex to the current group of the batch
+	 * @param batch The batch that the vertex belongs to
+	 * @param xCoordinate The x-coordinate of the vertex
+	 * @param yCoordinate The y-coordinate of the vertex
+	 */
+	void addVertex(vertexBatch &batch, double xCoordinate, double yCoordinate)
+	{
+		vertexGroup &group = batch.groups.back();
+
+		if(group.vertexCount == 0)
+			group.box = boundingBox(xCoordinate, yCoordinate, xCoordinate, yCoordinate);
+		else
+			group.box.expandToInclude(xCoordinate, yCoordinate);
+
+		batch.stagedPositions.push_back(xCoordinate);
+		batch.stagedPositions.push_back(yCoordinate);
+		group.vertexCount++;
+	}
+
+	/**
+	 * @brief Adds a piece of geometry to the current group of the batch. The geometry will be drawn with the vertices of the group
+	 * @param batch The batch that the geometry belongs to
+	 * @param item The geometry
+	 */
+	void addItem(vertexBatch &batch, geometry2D *item)
+	{
+		batch.stagedItems.push_back(item);
+		batch.groups.back().itemCount++;
+	}
+
+	/**
+	 * @brief Adds the segments of an arc to a batch
+	 * @param batch The batch that the arc belongs to
+	 * @param arc The arc that is to be added
+	 * @param asStrip Set to true if the vertices are drawn as a GL_LINE_STRIP. Otherwise, every segment is added as a pair of vertices for GL_LINES
+	 * @param pixelSize The size of a pixel. This is used to determine how many segments are needed
+	 */
+	void addArc(vertexBatch &batch, arcShape &arc, bool asStrip, double pixelSize);
+
+	/**
+	 * @brief 	Adds points to a batch. All of the points that fall into the same pixel are drawn with one vertex. The vertex is
+	 * 			placed at the first of these points so that nothing moves when the points are far enough apart
+	 * @param batch The batch that the points belong to
+	 * @param items The geometry that is drawn by each point
+	 * @param xCoordinates The x-coordinate of each point
+	 * @param yCoordinates The y-coordinate of each point
+	 * @param pixelSize The size of a pixel
+	 */
+	void addPoints(vertexBatch &batch, const std::vector<geometry2D*> &items, const std::vector<double> &xCoordinates, const std::vector<double> &yCoordinates, double pixelSize);
+
+	//! Sorts the groups of a batch into the tiles and creates the final lists of the batch
+	void finishBatch(vertexBatch &batch);
+
+	//! Fills in the colors of a batch from the selected state of the geometry in the batch
+	void updateColors(vertexBatch &batch);
+
+	/**
+	 * @brief Gives every piece of geometry in a batch an ID and fills in the pick colors of the batch
+	 * @param batch The batch
+	 * @param firstPickID The ID of the first piece of geometry in the batch
+	 */
+	void updatePickColors(vertexBatch &batch, GLuint firstPickID);
+
+	//! Copies the positions, the colors and the pick colors of a batch onto the graphics card
+	void uploadBatch(vertexBatch &batch);
+
+	/**
+	 * @brief Sorts a batch into its tiles, fills in its colors and pick colors and uploads the batch
+	 * @param batch The batch. All of the groups of the batch need to be added
+	 * @param batchIndex The position of the batch in the pick ID ranges. The batch is given the IDs starting at batchIndex * PICK_IDS_PER_BATCH + 1
+	 */
+	void buildBatch(vertexBatch &batch, unsigned int batchIndex);
+
+	//! Rebuilds p_lines and p_hiddenLines from the line list of the editor
+	void rebuildLines(geometryEditor2D &editor);
+
+	/**
+	 * @brief Rebuilds p_arcs and p_hiddenArcs from the arc list of the editor
+	 * @param editor The editor that holds the geometry
+	 * @param pixelSize The size of a pixel after it has been rounded to the detail level
+	 */
+	void rebuildArcs(geometryEditor2D &editor, double pixelSize);
+
+	/**
+	 * @brief Rebuilds p_nodes from the node store of the editor
+	 * @param editor The editor that holds the geometry
+	 * @param pixelSize The size of a pixel after it has been rounded to the detail level
+	 */
+	void rebuildNodes(geometryEditor2D &editor, double pixelSize);
+
+	/**
+	 * @brief Rebuilds p_blockLabels from the block label list of the editor
+	 * @param editor The editor that holds the geometry
+	 * @param pixelSize The size of a pixel after it has been rounded to the detail level
+	 */
+	void rebuildBlockLabels(geometryEditor2D &editor, double pixelSize);
+
+	/**
+	 * @brief 	Rebuilds the batches whose type of geometry has a new revision in the editor. The arcs, nodes and block labels are also
+	 * 			rebuilt when the detail level has changed. The colors of the batches that were not rebuilt are updated if the selection might have changed
+	 * @param editor The editor that holds the geometry
+	 * @param pixelSize The width of one pixel in model coordinates
+	 */
+	void updateBuffers(geometryEditor2D &editor, double pixelSize);
+
+	/**
+	 * @brief Binds the buffers of a batch to the vertex arrays
+	 * @param batch The batch that is to be drawn
+	 * @param useColors Set to true to use the color buffer. Otherwise, the current color is used for every vertex
+	 */
+	void bindBatch(vertexBatch &batch, bool useColors);
+
+	//! Binds the position buffer and the pick color buffer of a batch to the vertex arrays
+	void bindPickBatch(vertexBatch &batch);
+
+	/**
+	 * @brief 	Draws the tiles of a batch that overlap the window. Neighbouring tiles that are visible are drawn
+	 * 			with one call to glDrawArrays
+	 * @param batch The batch that is to be drawn. The batch needs to be bound
+	 * @param mode The type of primitive
+	 * @param window The visible window
+	 */
+	void drawVisibleTiles(vertexBatch &batch, GLenum mode, const boundingBox &window);
+
+public:
+	/**
+	 * @brief The geometry that was found by pick. For each type of geometry, this is the geometry that is drawn closest to the mouse
+	 */
+	struct pickResult
+	{
+		node *pickedNode = nullptr;
+
+		blockLabel *pickedBlockLabel = nullptr;
+
+		edgeLineShape *pickedLine = nullptr;
+
+		arcShape *pickedArc = nullptr;
+	};
+
+	/**
+	 * @brief Creates the buffers on the graphics card. This needs to be called once the OpenGL context of the canvas is current
+	 */
+	void initialize();
+
+	/**
+	 * @brief Deletes the buffers on the graphics card. This needs to be called while the OpenGL context of the canvas is current
+	 */
+	void release();
+
+	/**
+	 * @brief 	Draws all of the lines, arcs, nodes and block labels of the editor that are inside of the window. If the geometry
+	 * 			or the detail level has changed since the last call, the batches that are out of date are rebuilt first. The batches are drawn in the same order as
+	 * 			the canvas used to draw the geometry.
+	 * @param editor The editor that holds the geometry
+	 * @param window The part of the model that is visible on the canvas
+	 * @param pixelSize The width of one pixel in model coordinates
+	 */
+	void draw(geometryEditor2D &editor, const boundingBox &window, double pixelSize);
+
+	/**
+	 * @brief 	Finds the geometry that is drawn closest to a pixel of the canvas. The IDs of the geometry that is drawn within the radius
+	 * 			of the pixel are drawn into an offscreen framebuffer with the current projection and then read back. The points are drawn
+	 * 			one pixel large and the lines and arcs are drawn one pixel wide so that the distance is measured from the center of the geometry.
+	 * 			Nodes (or block labels) that were drawn as one point are found as the first node of the point.
+	 * 			This needs to be called while the OpenGL context of the canvas is current and the projection of the canvas is set.
+	 * @param editor The editor that holds the geometry
+	 * @param window The part of the model that is visible on the canvas
+	 * @param pixelSize The width of one pixel in model coordinates
+	 * @param pixelX The column of the pixel. The first column is on the left side of the canvas
+	 * @param pixelY The row of the pixel. The first row is on the bottom of the canvas
+	 * @param radius Only geometry that is drawn within this many pixels of the pixel is found
+	 * @param result The geometry that was found
+	 * @return Returns false if the offscreen framebuffer could not be created. Otherwise, returns true
+	 */
+	bool pick(geometryEditor2D &editor, const boundingBox &window, double pixelSize, int pixelX, int pixelY, int radius, pickResult &result);
+
+	//! Returns true if the buffers have been created
+	bool isInitialized()
+	{
+		return p_isInitialized;
+	}
+
+	/**
+	 * @brief 	Function that is called after the selected state of any geometry has changed. The colors are updated
+	 * 			the next time that the geometry is drawn
+	 */
+	void invalidateColors()
+	{
+		p_colorsAreDirty = true;
+	}
+
+	/**
+	 * @brief 	Function that is called after the geometry has been changed in a way that the editor does not keep track of (such as
+	 * 			changing the hidden state of a line). All of the batches are rebuilt the next time that the geometry is drawn
+	 */
+	void invalidate()
+	{
+		p_geometryIsDirty = true;
+	}
+};
+
+#endif
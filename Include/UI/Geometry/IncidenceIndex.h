@@ -0,0 +1,216 @@
+#ifndef INCIDENCE_INDEX_H_
+#define INCIDENCE_INDEX_H_
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <unordered_map>
+
+#include "Include/UI/Geometry/geometryShapes.h"
+
+/**
+ * @class incidenceIndex
+ * @file IncidenceIndex.h
+ * @brief   Keeps track of which lines (or arcs) are connected to each node. Without this index, finding the
+ *          segments that touch a node requires looping through the entire line list and arc list.
+ *          With the index, the lookup only depends on the number of segments connected to the node.
+ *          Like the other spatial indexes, only the addresses are stored. The index also remembers the two nodes
+ *          that each segment was connected to when it was last inserted or updated. This way, when the endpoints of a segment
+ *          are changed, the owner only needs to call update() afterwards and the segment is moved from the old nodes to the new nodes.
+ *          Nodes are matched by address and not by position.
+ *          The index also hashes every segment by its pair of endpoints so that a segment between two nodes can be found
+ *          without looking through the segments of either node. This is used to reject duplicate segments.
+ *          The template parameter must provide getFirstNode() and getSecondNode() (the edgeLineShape interface)
+ */
+template<class T>
+class incidenceIndex
+{
+private:
+	//! The segments that are connected to each node
+	std::unordered_map<node*, std::vector<T*>> p_nodeSegments;
+
+	typedef std::pair<node*, node*> endpointKey;
+
+	//! Hash function for the endpoint pairs. The order of the nodes matters
+	struct endpointHash
+	{
+		size_t operator()(const endpointKey &key) const
+		{
+			size_t firstHash = std::hash<node*>()(key.first);
+
+			return firstHash ^ (std::hash<node*>()(key.second) + 0x9e3779b9 + (firstHash << 6) + (firstHash >> 2));
+		}
+	};
+
+	//! The two nodes that each segment was connected to when the segment was placed into the index
+	std::unordered_map<T*, endpointKey> p_segmentNodes;
+
+	//! All of the segments keyed by the first and second node
+	std::unordered_multimap<endpointKey, T*, endpointHash> p_endpointSegments;
+
+	void attach(node *connectedNode, T *segment)
+	{
+		if(connectedNode)
+			p_nodeSegments[connectedNode].push_back(segment);
+	}
+
+	void detach(node *connectedNode, T *segment)
+	{
+		if(!connectedNode)
+			return;
+
+		typename std::unordered_map<node*, std::vector<T*>>::iterator nodeIterator = p_nodeSegments.find(connectedNode);
+
+		if(nodeIterator == p_nodeSegments.end())
+			return;
+
+		std::vector<T*> &segments = nodeIterator->second;
+		typename std::vector<T*>::iterator segmentIterator = std::find(segments.begin(), segments.end(), segment);
+
+		if(segmentIterator != segments.end())
+			segments.erase(segmentIterator);
+
+		if(segments.empty())
+			p_nodeSegments.erase(nodeIterator);
+	}
+
+public:
+	/**
+	 * @brief Places a segment into the index
+	 * @param segment The address of the segment. The endpoints of the segment should already be set
+	 */
+	void insert(T *segment)
+	{
+		endpointKey endpoints(segment->getFirstNode(), segment->getSecondNode());
+
+		p_segmentNodes[segment] = endpoints;
+		p_endpointSegments.insert(std::make_pair(endpoints, segment));
+
+		attach(endpoints.first, segment);
+
+		// A segment with both ends on the same node is only listed once for that node
+		if(endpoints.second != endpoints.first)
+			attach(endpoints.second, segment);
+	}
+
+	/**
+	 * @brief Removes a segment from the index
+	 * @param segment The address of the segment
+	 */
+	void erase(T *segment)
+	{
+		typename std::unordered_map<T*, endpointKey>::iterator segmentIterator = p_segmentNodes.find(segment);
+
+		if(segmentIterator == p_segmentNodes.end())
+			return;
+
+		std::pair<typename std::unordered_multimap<endpointKey, T*, endpointHash>::iterator, typename std::unordered_multimap<endpointKey, T*, endpointHash>::iterator> keyRange = p_endpointSegments.equal_range(segmentIterator->second);
+		for(typename std::unordered_multimap<endpointKey, T*, endpointHash>::iterator keyIterator = keyRange.first; keyIterator != keyRange.second; ++keyIterator)
+		{
+			if(keyIterator->second == segment)
+			{
+				p_endpointSegments.erase(keyIterator);
+				break;
+			}
+		}
+
+		detach(segmentIterator->second.first, segment);
+
+		if(segmentIterator->second.second != segmentIterator->second.first)
+			detach(segmentIterator->second.second, segment);
+
+		p_segmentNodes.erase(segmentIterator);
+	}
+
+	/**
+	 * @brief Function that is called after the endpoints of a segment have changed
+	 * @param segment The address of the segment
+	 */
+	void update(T *segment)
+	{
+		typename std::unordered_map<T*, endpointKey>::iterator segmentIterator = p_segmentNodes.find(segment);
+
+		if(segmentIterator != p_segmentNodes.end() && segmentIterator->second.first == segment->getFirstNode() && segmentIterator->second.second == segment->getSecondNode())
+			return;
+
+		erase(segment);
+		insert(segment);
+	}
+
+	/**
+	 * @brief 	Removes the list of segments for a node. This is called when the node is erased.
+	 * 			Any segments that are still connected to the node keep the record of the node until they are erased or updated
+	 * @param erasedNode The address of the node
+	 */
+	void eraseNode(node *erasedNode)
+	{
+		p_nodeSegments.erase(erasedNode);
+	}
+
+	/**
+	 * @brief Gets all of the segments that are connected to a node
+	 * @param connectedNode The address of the node
+	 * @return Returns a copy of the list of segments. A copy is returned so that the segments can be erased while looping through the result
+	 */
+	std::vector<T*> getSegments(node *connectedNode) const
+	{
+		typename std::unordered_map<node*, std::vector<T*>>::const_iterator nodeIterator = p_nodeSegments.find(connectedNode);
+
+		if(nodeIterator == p_nodeSegments.end())
+			return std::vector<T*>();
+
+		return nodeIterator->second;
+	}
+
+	/**
+	 * @brief Gets all of the segments that start at one node and end at another node
+	 * @param firstNode The address of the first node of the segment
+	 * @param secondNode The address of the second node of the segment
+	 * @return Returns the segments. Segments that go from secondNode to firstNode are not included
+	 */
+	std::vector<T*> getSegments(node *firstNode, node *secondNode) const
+	{
+		std::vector<T*> segments;
+		std::pair<typename std::unordered_multimap<endpointKey, T*, endpointHash>::const_iterator, typename std::unordered_multimap<endpointKey, T*, endpointHash>::const_iterator> keyRange = p_endpointSegments.equal_range(endpointKey(firstNode, secondNode));
+
+		for(typename std::unordered_multimap<endpointKey, T*, endpointHash>::const_iterator keyIterator = keyRange.first; keyIterator != keyRange.second; ++keyIterator)
+			segments.push_back(keyIterator->second);
+
+		return segments;
+	}
+
+	/**
+	 * @brief Gets the number of segments that are connected to a node
+	 * @param connectedNode The address of the node
+	 * @return Returns the number of segments
+	 */
+	size_t getDegree(node *connectedNode) const
+	{
+		typename std::unordered_map<node*, std::vector<T*>>::const_iterator nodeIterator = p_nodeSegments.find(connectedNode);
+
+		if(nodeIterator == p_nodeSegments.end())
+			return 0;
+
+		return nodeIterator->second.size();
+	}
+
+	/**
+	 * @brief Makes room for a number of segments so that the maps are not rehashed while a whole list is inserted
+	 * @param numberOfSegments The number of segments that will be placed into the index
+	 */
+	void reserve(size_t numberOfSegments)
+	{
+		p_nodeSegments.reserve(numberOfSegments);
+		p_segmentNodes.reserve(numberOfSegments);
+		p_endpointSegments.reserve(numberOfSegments);
+	}
+
+	void clear()
+	{
+		p_nodeSegments.clear();
+		p_segmentNodes.clear();
+		p_endpointSegments.clear();
+	}
+};
+
+#endif
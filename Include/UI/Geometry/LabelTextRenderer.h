@@ -0,0 +1,189 @@
+#ifndef LABEL_TEXT_RENDERER_H_
+#define LABEL_TEXT_RENDERER_H_
+
+#include <string>
+#include <vector>
+
+#include <QOpenGLFunctions>
+
+#include "Include/UI/Geometry/BoundingBox.h"
+
+/**
+ * @class labelTextRenderer
+ * @file LabelTextRenderer.h
+ * @brief   Draws the text that is placed on the canvas (such as the names of the block labels).
+ *          When the renderer is initialized, the printable ASCII characters of the bundled DejaVuSansMono font are rendered
+ *          once with FreeType into a single texture (the glyph atlas). Drawing a string only adds one textured square per character
+ *          to a list. At the end of the frame, the list is placed into a vertex buffer and all of the text is drawn with one call.
+ *          The text is always drawn at the same size in pixels no matter the zoom. In order to keep the text readable when zoomed out,
+ *          a string is not drawn if it would overlap a string that was already drawn in the same frame. Strings that fall outside of the canvas are skipped.
+ *          Only the fixed function texture environment is used so that the renderer works on the same contexts as the rest of the canvas.
+ */
+class labelTextRenderer : protected QOpenGLFunctions
+{
+private:
+	//! The first character that is in the atlas
+	enum : int { FIRST_CHARACTER = 32 };
+
+	//! The number of characters in the atlas. This is all of the printable ASCII characters
+	enum : int { NUMBER_OF_CHARACTERS = 95 };
+
+	//! The number of characters along each row of the atlas
+	enum : int { ATLAS_COLUMNS = 16 };
+
+	//! The height of the font in pixels
+	enum : int { FONT_PIXEL_SIZE = 12 };
+
+	/**
+	 * @brief The position of one character in the atlas and how the character is placed relative to the pen
+	 */
+	struct glyph
+	{
+		//! The left side of the glyph in the atlas in pixels
+		int atlasX = 0;
+
+		//! The top side of the glyph in the atlas in pixels
+		int atlasY = 0;
+
+		//! The width of the bitmap of the glyph
+		int width = 0;
+
+		//! The height of the bitmap of the glyph
+		int height = 0;
+
+		//! The distance from the pen to the left side of the bitmap
+		int left = 0;
+
+		//! The distance from the baseline to the top of the bitmap
+		int top = 0;
+	};
+
+	//! The glyph of each character in the atlas
+	glyph p_glyphs[NUMBER_OF_CHARACTERS];
+
+	//! The distance that the pen moves after each character. The font is monospaced so this is the same for every character
+	int p_advance = 0;
+
+	//! The distance between two lines of text
+	int p_lineHeight = 0;
+
+	//! The width of the atlas in pixels
+	int p_atlasWidth = 0;
+
+	//! The height of the atlas in pixels
+	int p_atlasHeight = 0;
+
+	//! The name of the atlas texture
+	GLuint p_atlasTexture = 0;
+
+	//! The name of the vertex buffer that holds the squares of the current frame
+	GLuint p_vertexBuffer = 0;
+
+	//! The x and y position in pixels and the s and t texture coordinate of each corner of each square
+	std::vector<GLfloat> p_vertices;
+
+	//! The part of the model that is visible on the canvas in the current frame
+	boundingBox p_window;
+
+	//! The size of one pixel in model coordinates in the current frame
+	double p_pixelSize = 1;
+
+	//! The width of the canvas in pixels
+	int p_canvasWidth = 0;
+
+	//! The height of the canvas in pixels
+	int p_canvasHeight = 0;
+
+	//! The distance from the baseline to the top of the tallest character
+	int p_ascent = 0;
+
+	//! The distance from the baseline to the bottom of the lowest character
+	int p_descent = 0;
+
+	/**
+	 * @brief The area in pixels that is covered by one string. The left and bottom sides are part of the box, the right and top sides are not
+	 */
+	struct textBox
+	{
+		int minX = 0;
+		int minY = 0;
+		int maxX = 0;
+		int maxY = 0;
+	};
+
+	//! The size in pixels of the cells that are used to find the text that is near a new string
+	enum : int { OCCUPANCY_CELL_SIZE = 64 };
+
+	//! The area of every string that was added in the current frame
+	std::vector<textBox> p_textBoxes;
+
+	//! For each cell of the canvas, the position in p_textBoxes of the strings that overlap the cell
+	std::vector<std::vector<unsigned int>> p_occupancy;
+
+	//! The number of columns of cells
+	int p_occupancyColumns = 0;
+
+	//! The number of rows of cells
+	int p_occupancyRows = 0;
+
+	//! Set to true once the atlas and the buffer have been created
+	bool p_isInitialized = false;
+
+	/**
+	 * @brief Renders the characters of the font into the atlas and uploads the atlas
+	 * @param fontData The contents of the font file
+	 * @return Returns true if the font could be loaded. Otherwise, returns false
+	 */
+	bool buildAtlas(const std::vector<unsigned char> &fontData);
+
+public:
+	/**
+	 * @brief 	Loads the font and creates the atlas and the vertex buffer. This needs to be called once the OpenGL context of the canvas is current.
+	 * 			If the font cannot be loaded, then the renderer is left uninitialized and nothing is drawn.
+	 * @return Returns true if the renderer is ready to draw text. Otherwise, returns false
+	 */
+	bool initialize();
+
+	/**
+	 * @brief Deletes the atlas and the buffer. This needs to be called while the OpenGL context of the canvas is current
+	 */
+	void release();
+
+	/**
+	 * @brief Starts a new frame of text. Any text that was added and not drawn is thrown away
+	 * @param window The part of the model that is visible on the canvas
+	 * @param pixelSize The size of one pixel in model coordinates
+	 * @param canvasWidth The width of the canvas in pixels
+	 * @param canvasHeight The height of the canvas in pixels
+	 */
+	void beginFrame(const boundingBox &window, double pixelSize, int canvasWidth, int canvasHeight);
+
+	/**
+	 * @brief 	Adds a string to the current frame. The string is not added if it would overlap text that is already in the frame or
+	 * 			if none of it would be on the canvas.
+	 * @param xCoordinate The x-coordinate of the start of the baseline of the text in model coordinates
+	 * @param yCoordinate The y-coordinate of the start of the baseline of the text in model coordinates
+	 * @param text The text. Characters that are not printable ASCII are drawn as a space
+	 * @return Returns true if the text was added. Otherwise, returns false
+	 */
+	bool addText(double xCoordinate, double yCoordinate, const std::string &text);
+
+	/**
+	 * @brief Draws all of the text of the current frame with one call. This will change the projection to pixels and then restore it
+	 */
+	void draw();
+
+	//! Returns the distance between two lines of text in pixels
+	int getLineHeight()
+	{
+		return p_lineHeight;
+	}
+
+	//! Returns true if the font was loaded
+	bool isInitialized()
+	{
+		return p_isInitialized;
+	}
+};
+
+#endif
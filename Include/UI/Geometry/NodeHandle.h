@@ -0,0 +1,200 @@
+#ifndef NODE_HANDLE_H_
+#define NODE_HANDLE_H_
+
+#include <vector>
+
+/**
+ * @class nodeHandle
+ * @file NodeHandle.h
+ * @brief   A small value that identifies a node independent of where the node is stored in memory.
+ *          The handle is made up of the index of a slot in a handleTable and the generation of the slot.
+ *          Every time a slot is released, the generation of the slot is increased. This way, a handle to a node that was
+ *          erased will not resolve to a different node that later reuses the slot.
+ *          A generation of 0 is never given out so a default constructed handle is always a null handle.
+ */
+class nodeHandle
+{
+private:
+	//! The index of the slot in the handle table
+	unsigned int p_index = 0;
+
+	//! The generation of the slot when the handle was given out
+	unsigned int p_generation = 0;
+
+public:
+	//! The constructor for the class. The handle will be a null handle
+	nodeHandle()
+	{
+
+	}
+
+	/**
+	 * @brief The constructor for the class
+	 * @param index The index of the slot
+	 * @param generation The generation of the slot
+	 */
+	nodeHandle(unsigned int index, unsigned int generation)
+	{
+		p_index = index;
+		p_generation = generation;
+	}
+
+	unsigned int getIndex() const
+	{
+		return p_index;
+	}
+
+	unsigned int getGeneration() const
+	{
+		return p_generation;
+	}
+
+	//! Returns true if the handle does not refer to any node
+	bool isNull() const
+	{
+		return (p_generation == 0);
+	}
+
+	bool operator==(const nodeHandle &handle) const
+	{
+		return (p_index == handle.p_index && p_generation == handle.p_generation);
+	}
+
+	bool operator!=(const nodeHandle &handle) const
+	{
+		return !(*this == handle);
+	}
+};
+
+/**
+ * @class handleTable
+ * @file NodeHandle.h
+ * @brief   Converts the handles into the address of the item. The table is a list of slots where each slot stores the address
+ *          of one item and the generation of the slot. Looking up a handle is a single index into the list.
+ *          When a list of items is copied, the handles that are stored in the items (and in anything that refers to the items) stay the same.
+ *          Only the table needs to be told where each item now lives. This is done with place().
+ *          Slots that are released are reused by the next call to acquire().
+ */
+template<class T>
+class handleTable
+{
+private:
+	//! The address of the item in each slot. This is nullptr for slots that are not in use
+	std::vector<T*> p_slots;
+
+	//! The current generation of each slot
+	std::vector<unsigned int> p_generations;
+
+	//! The indexes of the slots that are not in use
+	std::vector<unsigned int> p_freeSlots;
+
+	void resize(unsigned int index)
+	{
+		if(index < p_slots.size())
+			return;
+
+		p_slots.resize(index + 1, nullptr);
+		p_generations.resize(index + 1, 0);
+	}
+
+public:
+	/**
+	 * @brief Gives out a new handle for an item
+	 * @param item The address of the item
+	 * @return Returns the handle of the item
+	 */
+	nodeHandle acquire(T *item)
+	{
+		unsigned int index;
+
+		if(!p_freeSlots.empty())
+		{
+			index = p_freeSlots.back();
+			p_freeSlots.pop_back();
+		}
+		else
+		{
+			index = p_slots.size();
+			resize(index);
+		}
+
+		p_slots[index] = item;
+
+		// Generation 0 is reserved for the null handle
+		if(++p_generations[index] == 0)
+			p_generations[index] = 1;
+
+		return nodeHandle(index, p_generations[index]);
+	}
+
+	/**
+	 * @brief Places an item into the slot of a handle that was given out before. This is used after the items have been copied or loaded
+	 * 			and still hold their handles. After all of the items are placed, finishPlacement needs to be called.
+	 * @param handle The handle that the item holds
+	 * @param item The new address of the item
+	 * @return Returns false if the handle is null or if the slot is already taken. In this case, the item needs a new handle from acquire()
+	 */
+	bool place(nodeHandle handle, T *item)
+	{
+		if(handle.isNull())
+			return false;
+
+		resize(handle.getIndex());
+
+		if(p_slots[handle.getIndex()])
+			return false;
+
+		p_slots[handle.getIndex()] = item;
+		p_generations[handle.getIndex()] = handle.getGeneration();
+
+		return true;
+	}
+
+	//! Collects all of the slots that were not filled by place() so that the slots can be reused by acquire()
+	void finishPlacement()
+	{
+		p_freeSlots.clear();
+
+		for(unsigned int i = p_slots.size(); i > 0; i--)
+		{
+			if(!p_slots[i - 1])
+				p_freeSlots.push_back(i - 1);
+		}
+	}
+
+	/**
+	 * @brief Releases the slot of a handle. Any copies of the handle will no longer resolve
+	 * @param handle The handle of the item that was removed
+	 */
+	void release(nodeHandle handle)
+	{
+		if(!resolve(handle))
+			return;
+
+		p_slots[handle.getIndex()] = nullptr;
+		p_generations[handle.getIndex()]++;
+		p_freeSlots.push_back(handle.getIndex());
+	}
+
+	/**
+	 * @brief Looks up the address of the item
+	 * @param handle The handle of the item
+	 * @return Returns the address of the item. Returns nullptr if the handle is null or if the item was released
+	 */
+	T *resolve(nodeHandle handle) const
+	{
+		if(handle.isNull() || handle.getIndex() >= p_slots.size() || p_generations[handle.getIndex()] != handle.getGeneration())
+			return nullptr;
+
+		return p_slots[handle.getIndex()];
+	}
+
+	void clear()
+	{
+		p_slots.clear();
+		p_generations.clear();
+		p_freeSlots.clear();
+	}
+};
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef NODE_STORE_H_
+#define NODE_STORE_H_
+
+#include <vector>
+
+#include "Include/UI/Geometry/geometryShapes.h"
+
+/**
+ * @class nodeStore
+ * @file NodeStore.h
+ * @brief   Keeps a packed copy of the coordinates of the nodes. The x-coordinates and the y-coordinates are each stored in
+ *          their own contiguous list (structure of arrays) with no gaps. A loop that only needs the position of the nodes
+ *          (such as building the vertex buffer of the nodes) reads 16 bytes per node from two lists instead of
+ *          jumping through every node object in the colony. The address of the node is kept in a third list in the
+ *          same order.
+ *          The store is kept in sync by the geometry editor in the same places as the spatial indexes.
+ *          Each node is found in the store through the index of its handle. When a node is removed,
+ *          the last node in the lists is moved into its place so that the lists stay packed. This means that the order of the
+ *          nodes in the store is not the same as the order in the node list.
+ */
+class nodeStore
+{
+private:
+	//! The x-coordinate of each node
+	std::vector<double> p_xCoordinates;
+
+	//! The y-coordinate of each node
+	std::vector<double> p_yCoordinates;
+
+	//! The address of each node
+	std::vector<node*> p_nodes;
+
+	//! The position in the lists of each node. This is indexed by the index of the handle of the node
+	std::vector<unsigned int> p_positions;
+
+	//! Value used in p_positions for the handles that are not in the store
+	enum : unsigned int { NOT_STORED = 0xFFFFFFFF };
+
+	bool contains(nodeHandle handle) const
+	{
+		return (!handle.isNull() && handle.getIndex() < p_positions.size() && p_positions[handle.getIndex()] != NOT_STORED);
+	}
+
+public:
+	/**
+	 * @brief Places a node into the store
+	 * @param storedNode The address of the node. The node needs to have a handle
+	 */
+	void insert(node *storedNode)
+	{
+		nodeHandle handle = storedNode->getHandle();
+
+		if(handle.isNull() || contains(handle))
+			return;
+
+		if(handle.getIndex() >= p_positions.size())
+			p_positions.resize(handle.getIndex() + 1, NOT_STORED);
+
+		p_positions[handle.getIndex()] = p_nodes.size();
+		p_xCoordinates.push_back(storedNode->getCenterXCoordinate());
+		p_yCoordinates.push_back(storedNode->getCenterYCoordinate());
+		p_nodes.push_back(storedNode);
+	}
+
+	/**
+	 * @brief Removes a node from the store. The last node in the store is moved into the position of the removed node
+	 * @param storedNode The address of the node
+	 */
+	void erase(node *storedNode)
+	{
+		nodeHandle handle = storedNode->getHandle();
+
+		if(!contains(handle))
+			return;
+
+		unsigned int position = p_positions[handle.getIndex()];
+		unsigned int lastPosition = p_nodes.size() - 1;
+
+		if(position != lastPosition)
+		{
+			p_xCoordinates[position] = p_xCoordinates[lastPosition];
+			p_yCoordinates[position] = p_yCoordinates[lastPosition];
+			p_nodes[position] = p_nodes[lastPosition];
+			p_positions[p_nodes[position]->getHandle().getIndex()] = position;
+		}
+
+		p_xCoordinates.pop_back();
+		p_yCoordinates.pop_back();
+		p_nodes.pop_back();
+		p_positions[handle.getIndex()] = NOT_STORED;
+	}
+
+	/**
+	 * @brief Function that is called after a node has moved
+	 * @param storedNode The address of the node
+	 */
+	void update(node *storedNode)
+	{
+		nodeHandle handle = storedNode->getHandle();
+
+		if(!contains(handle))
+			return;
+
+		unsigned int position = p_positions[handle.getIndex()];
+
+		p_xCoordinates[position] = storedNode->getCenterXCoordinate();
+		p_yCoordinates[position] = storedNode->getCenterYCoordinate();
+	}
+
+	const std::vector<double> &getXCoordinates() const
+	{
+		return p_xCoordinates;
+	}
+
+	const std::vector<double> &getYCoordinates() const
+	{
+		return p_yCoordinates;
+	}
+
+	//! Returns the address of the nodes in the same order as the coordinate lists
+	const std::vector<node*> &getNodes() const
+	{
+		return p_nodes;
+	}
+
+	size_t size() const
+	{
+		return p_nodes.size();
+	}
+
+	void clear()
+	{
+		p_xCoordinates.clear();
+		p_yCoordinates.clear();
+		p_nodes.clear();
+		p_positions.clear();
+	}
+};
+
+#endif
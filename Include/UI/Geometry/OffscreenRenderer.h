@@ -0,0 +1,96 @@
+#ifndef OFFSCREEN_RENDERER_H_
+#define OFFSCREEN_RENDERER_H_
+
+#include <QOpenGLFunctions>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOffscreenSurface>
+#include <QImage>
+#include <QThread>
+
+#include "Include/common/GridPreferences.h"
+#include "Include/common/Enums.h"
+
+#include "Include/UI/Geometry/GeometryEditor2D.h"
+#include "Include/UI/Geometry/SceneRenderer.h"
+
+/**
+ * @class offscreenRenderer
+ * @file OffscreenRenderer.h
+ * @brief 	Renders the scene of the canvas into an image without a window. The renderer owns its own OpenGL context
+ * 			and an offscreen surface, and draws with the same sceneRenderer that the canvas uses, so the image looks the same as the canvas.
+ * 			The image can be larger then the largest framebuffer that the driver supports. In this case, the image is drawn in tiles
+ * 			and the camera of each tile is set so that the tiles line up to the pixel.
+ * 			The surface and the context are created in create, which needs to be called from the GUI thread. After this, the renderer
+ * 			can be moved to another thread with moveToThread. render and release are then called from that thread.
+ * 			Several renderers can run at the same time since each one has its own context.
+ */
+class offscreenRenderer : protected QOpenGLFunctions
+{
+private:
+	//! The largest tile in pixels. Larger images are drawn in several tiles
+	enum : int { MAX_TILE_SIZE = 4096 };
+
+	//! The surface that the context is made current on. Nothing is drawn to the surface
+	QOffscreenSurface *p_surface = nullptr;
+
+	//! The context that the scene is drawn with
+	QOpenGLContext *p_context = nullptr;
+
+	//! Draws the grid and the geometry
+	sceneRenderer p_scene;
+
+	//! The framebuffer that each tile is drawn into. This is kept between renders as long as the size of the tile does not change
+	QOpenGLFramebufferObject *p_framebuffer = nullptr;
+
+	//! The size of the largest tile. This is found from the limits of the driver the first time that the context is made current
+	int p_tileSize = 0;
+
+	/**
+	 * @brief Makes the context current and initializes the scene if this has not been done yet
+	 * @return Returns true if the context could be made current. Otherwise, returns false
+	 */
+	bool makeCurrent();
+
+public:
+	/**
+	 * @brief Creates the offscreen surface and the context. This needs to be called from the GUI thread
+	 * @return Returns true if the surface and the context were created. Otherwise, returns false
+	 */
+	bool create();
+
+	/**
+	 * @brief Changes the thread that the context belongs to. After this, render and release can only be called from that thread
+	 * @param thread The thread that will render with the context
+	 */
+	void moveToThread(QThread *thread)
+	{
+		if(p_context)
+			p_context->moveToThread(thread);
+	}
+
+	/**
+	 * @brief 	Draws the grid and the geometry of an editor into an image. The scene is drawn the same way as it is drawn on the canvas.
+	 * 			Nodes and block labels that are being dragged are not drawn.
+	 * @param editor The editor that holds the geometry
+	 * @param preferences Decides which parts of the grid and which names are drawn
+	 * @param problem The physics problem. The names of the circuits are only drawn for magnetic problems
+	 * @param camera The view that is drawn. The width and height of the camera are the size of the image
+	 * @param image The image that the scene is drawn into. The format of the image is QImage::Format_RGB32
+	 * @return Returns true if the scene was drawn. Otherwise, returns false and the image is not changed
+	 */
+	bool render(geometryEditor2D &editor, gridPreferences &preferences, physicProblems problem, const sceneCamera &camera, QImage &image);
+
+	/**
+	 * @brief Deletes the buffers, the shader and the framebuffer. This needs to be called from the thread that the renderer was moved to
+	 */
+	void release();
+
+	~offscreenRenderer()
+	{
+		delete p_context;
+		delete p_surface;
+	}
+};
+
+#endif
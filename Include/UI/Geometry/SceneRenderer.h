@@ -0,0 +1,172 @@
+#ifndef SCENE_RENDERER_H_
+#define SCENE_RENDERER_H_
+
+#include <vector>
+
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+
+#include "Include/common/GridPreferences.h"
+#include "Include/common/Enums.h"
+
+#include "Include/UI/Geometry/GeometryEditor2D.h"
+#include "Include/UI/Geometry/GeometryRenderer.h"
+#include "Include/UI/Geometry/LabelTextRenderer.h"
+#include "Include/UI/Geometry/BoundingBox.h"
+
+/**
+ * @brief 	The part of the model that is shown and the size of the image that it is shown in.
+ * 			The camera is the center of the view. The zoom is half of the height of the view in model coordinates.
+ * 			The width of the view follows from the aspect ratio of the image.
+ */
+struct sceneCamera
+{
+	//! The x-coordinate of the center of the view
+	double cameraX = 0;
+
+	//! The y-coordinate of the center of the view
+	double cameraY = 0;
+
+	//! Half of the height of the view in the x-direction. This is multiplied by the aspect ratio
+	double zoomX = 1;
+
+	//! Half of the height of the view
+	double zoomY = 1;
+
+	//! The width of the image in pixels
+	int width = 0;
+
+	//! The height of the image in pixels
+	int height = 0;
+
+	//! Returns the part of the model that is visible. This is the box that glOrtho maps onto the image
+	boundingBox getVisibleWindow() const
+	{
+		double aspectRatio = (double)width / (double)height;
+
+		return boundingBox(cameraX - zoomX * aspectRatio, cameraY - zoomY, cameraX + zoomX * aspectRatio, cameraY + zoomY);
+	}
+
+	//! Returns the size of one pixel of the image in model coordinates
+	double getPixelSize() const
+	{
+		return 2.0 * zoomY / (double)height;
+	}
+
+	/**
+	 * @brief 	Centers the camera on a box and sets the zoom so that the entire box fits in the image with a small margin.
+	 * 			If the box has no size, then the zoom is not changed.
+	 * @param modelBox The box that needs to be visible
+	 */
+	void zoomToFit(const boundingBox &modelBox)
+	{
+		double aspectRatio = (double)width / (double)height;
+		double halfWidth = (modelBox.getMaxX() - modelBox.getMinX()) / 2.0;
+		double halfHeight = (modelBox.getMaxY() - modelBox.getMinY()) / 2.0;
+
+		cameraX = (modelBox.getMaxX() + modelBox.getMinX()) / 2.0;
+		cameraY = (modelBox.getMaxY() + modelBox.getMinY()) / 2.0;
+
+		if(halfWidth > 0 || halfHeight > 0)
+		{
+			zoomX = std::max(halfWidth / aspectRatio, halfHeight) * 1.1;
+			zoomY = zoomX;
+		}
+	}
+};
+
+/**
+ * @class sceneRenderer
+ * @file SceneRenderer.h
+ * @brief 	Draws the scene of the canvas. This is the grid, the axis, the origin, the geometry and the names of the block labels.
+ * 			Everything that the scene needs is owned here so that the same drawing code is used by the canvas and by
+ * 			the offscreen renderer that exports images without a window.
+ * 			All of the functions need to be called while the OpenGL context that the renderer was initialized in is current.
+ */
+class sceneRenderer : protected QOpenGLFunctions
+{
+private:
+	//! The smallest distance in pixels between two lines of the grid. If the grid step is smaller, then every fourth line is drawn instead
+	enum : int { MIN_GRID_SPACING = 4 };
+
+	//! Draws the geometry from vertex buffers
+	geometryRenderer p_geometryRenderer;
+
+	//! Draws the names of the block labels from a glyph atlas. All of the names in a frame are drawn with one call
+	labelTextRenderer p_textRenderer;
+
+	//! The shader that draws the grid
+	/*!
+		The grid is drawn as one square that covers the image and the shader decides which pixels are on a line.
+		The cost of drawing the grid does not depend on the number of lines. This is null if the shader could not be compiled.
+		\sa drawGrid
+	*/
+	QOpenGLShaderProgram *p_gridShader = nullptr;
+
+	//! The vertex buffer that holds the lines of the grid when the grid shader is not available
+	/*!
+		The buffer is refilled every time that the grid is drawn. The minor lines are stored first and the major lines after
+		so that each kind is drawn with one call.
+		\sa drawGrid
+	*/
+	GLuint p_gridBuffer = 0;
+
+	//! The x and y coordinate of the vertices of the grid. This is kept between calls so that the memory is reused
+	std::vector<GLdouble> p_gridVertices;
+
+	//! Set to true once the buffers and the shader have been created
+	bool p_isInitialized = false;
+
+public:
+	/**
+	 * @brief Creates the buffers, the glyph atlas and the grid shader. Calling this again after the renderer is initialized does nothing
+	 */
+	void initialize();
+
+	/**
+	 * @brief Deletes everything that was created in initialize
+	 */
+	void release();
+
+	/**
+	 * @brief Sets the viewport and the projection so that the view of the camera fills the image
+	 * @param camera The view. The width and height need to be larger then 0
+	 */
+	void applyCamera(const sceneCamera &camera);
+
+	//! Draws the grid, the axis and the origin
+	/*!
+		The grid is drawn in one call with p_gridShader. If the shader is not available, the lines of the grid are placed into p_gridBuffer
+		and drawn with one call for the minor lines and one call for the major lines.
+		Every fourth line is a major line. If the lines would be closer together then MIN_GRID_SPACING pixels, the step is multiplied by four
+		until they are not. This way, the grid never disappears when zooming out and the number of lines only depends on the size of the image.
+		\param preferences Decides which parts are drawn and the step of the grid
+		\param camera The view that the projection was set to
+	*/
+	void drawGrid(gridPreferences &preferences, const sceneCamera &camera);
+
+	//! Draws all of the geometry of an editor
+	/*!
+		The lines, arcs, nodes and block labels are drawn from the vertex buffers of p_geometryRenderer. The names of the block labels are drawn after.
+		A node or block label that is being dragged is not drawn here since it is part of the overlay of the canvas.
+		\param editor The editor that holds the geometry
+		\param preferences Decides if the names of the block labels are drawn
+		\param problem The physics problem. The names of the circuits are only drawn for magnetic problems
+		\param camera The view that the projection was set to
+	*/
+	void drawGeometry(geometryEditor2D &editor, gridPreferences &preferences, physicProblems problem, const sceneCamera &camera);
+
+	//! Returns the renderer that draws the geometry. This is used for picking and for invalidating the colors
+	geometryRenderer &getGeometryRenderer()
+	{
+		return p_geometryRenderer;
+	}
+
+	//! Returns true if initialize has been called and release has not
+	bool isInitialized()
+	{
+		return p_isInitialized;
+	}
+};
+
+#endif
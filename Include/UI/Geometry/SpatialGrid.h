@@ -0,0 +1,421 @@
+#ifndef SPATIAL_GRID_H_
+#define SPATIAL_GRID_H_
+
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include <unordered_map>
+
+/**
+ * @class spatialGrid
+ * @file SpatialGrid.h
+ * @brief   A hashed uniform grid that is used to speed up the proximity checks for the point-like geometry
+ *          (nodes and block labels). Every item is bucketed into a square cell based on the position of its
+ *          center. A query for "is there an item within d of (x, y)" only needs to look at the cells
+ *          that overlap the circle which turns the linear scan of the colony into a (nearly) constant time lookup.
+ *          The grid only stores the address of the item. Since the geometry is stored in a plf::colony, the
+ *          address remains valid until the item is erased from the colony. Therefor, the owner of the grid
+ *          needs to call erase() before the item is erased from the colony and update() when the item is moved.
+ *          The cell size is recalculated from the extents of the items whenever the number of items doubles
+ *          so that the average number of items in each cell stays small.
+ *          The template parameter must provide getCenterXCoordinate(), getCenterYCoordinate() and
+ *          getDistance(double, double) (the rectangleShape interface)
+ */
+template<class T>
+class spatialGrid
+{
+private:
+	typedef unsigned long long cellKey;
+
+	//! The buckets of the grid. The key is the packed x and y index of the cell
+	std::unordered_map<cellKey, std::vector<T*>> p_cells;
+
+	//! Reverse lookup for the cell that an item was placed into. This is used so that an item can be removed without knowing where it was placed
+	std::unordered_map<T*, cellKey> p_itemCells;
+
+	//! The length of one side of a cell
+	double p_cellSize = 1.0;
+
+	//! Once the number of items reaches this value, the cell size is recalculated
+	size_t p_resizeThreshold = 64;
+
+	/**
+	 * @brief Converts a coordinate into the index of the cell. The index is clamped in order to avoid overflowing the packed key
+	 * @param coordinate The x or y coordinate
+	 * @return Returns the index of the cell along the axis
+	 */
+	long long getCellIndex(double coordinate) const
+	{
+		double index = floor(coordinate / p_cellSize);
+
+		if(index > 1.0e9)
+			return 1000000000LL;
+		else if(index < -1.0e9)
+			return -1000000000LL;
+
+		return (long long)index;
+	}
+
+	//! The indexes are packed as unsigned values since the indexes are negative below and to the left of the origin
+	cellKey getKey(long long xIndex, long long yIndex) const
+	{
+		return ((cellKey)xIndex << 32) ^ ((cellKey)yIndex & 0xFFFFFFFFULL);
+	}
+
+	//! Unpacks one index from the key. The indexes always fit into 32 bits since getCellIndex clamps them
+	long long unpackIndex(cellKey packedIndex) const
+	{
+		long long index = (long long)(packedIndex & 0xFFFFFFFFULL);
+
+		if(index >= 0x80000000LL)
+			index -= 0x100000000LL;
+
+		return index;
+	}
+
+	/**
+	 * @brief Calls the visitor on the items of one cell that lie within a rectangular region
+	 * @param bucket The items of the cell
+	 * @param isInside Set to true if the whole cell is inside of the region. The items are then visited without looking up their position
+	 * @param minX The lower left x-coordinate of the region
+	 * @param minY The lower left y-coordinate of the region
+	 * @param maxX The upper right x-coordinate of the region
+	 * @param maxY The upper right y-coordinate of the region
+	 * @param visitor Function object with the signature bool(T*)
+	 * @return Returns true if the visitor stopped the search
+	 */
+	template<class Visitor>
+	bool visitBucket(const std::vector<T*> &bucket, bool isInside, double minX, double minY, double maxX, double maxY, Visitor &visitor) const
+	{
+		for(typename std::vector<T*>::const_iterator bucketIterator = bucket.begin(); bucketIterator != bucket.end(); ++bucketIterator)
+		{
+			if(isInside)
+			{
+				if(visitor(*bucketIterator))
+					return true;
+
+				continue;
+			}
+
+			double xCoordinate = (*bucketIterator)->getCenterXCoordinate();
+			double yCoordinate = (*bucketIterator)->getCenterYCoordinate();
+
+			if(xCoordinate >= minX && xCoordinate <= maxX && yCoordinate >= minY && yCoordinate <= maxY && visitor(*bucketIterator))
+				return true;
+		}
+
+		return false;
+	}
+
+	void insertIntoCell(T *item, cellKey key)
+	{
+		p_cells[key].push_back(item);
+		p_itemCells[item] = key;
+	}
+
+	void removeFromCell(T *item, cellKey key)
+	{
+		typename std::unordered_map<cellKey, std::vector<T*>>::iterator cellIterator = p_cells.find(key);
+
+		if(cellIterator == p_cells.end())
+			return;
+
+		std::vector<T*> &bucket = cellIterator->second;
+		for(typename std::vector<T*>::iterator bucketIterator = bucket.begin(); bucketIterator != bucket.end(); ++bucketIterator)
+		{
+			if(*bucketIterator == item)
+			{
+				// Order does not matter in the bucket so swap with the back in order to avoid shifting the vector
+				*bucketIterator = bucket.back();
+				bucket.pop_back();
+				break;
+			}
+		}
+
+		if(bucket.empty())
+			p_cells.erase(cellIterator);
+	}
+
+	/**
+	 * @brief 	Recalculates the cell size based on the extents of all of the items in the grid and places
+	 * 			every item into its new cell. The goal is to have about one item per cell
+	 */
+	void resize()
+	{
+		if(p_itemCells.empty())
+			return;
+
+		double minX = p_itemCells.begin()->first->getCenterXCoordinate();
+		double maxX = minX;
+		double minY = p_itemCells.begin()->first->getCenterYCoordinate();
+		double maxY = minY;
+
+		for(typename std::unordered_map<T*, cellKey>::iterator itemIterator = p_itemCells.begin(); itemIterator != p_itemCells.end(); ++itemIterator)
+		{
+			minX = std::min(minX, itemIterator->first->getCenterXCoordinate());
+			maxX = std::max(maxX, itemIterator->first->getCenterXCoordinate());
+			minY = std::min(minY, itemIterator->first->getCenterYCoordinate());
+			maxY = std::max(maxY, itemIterator->first->getCenterYCoordinate());
+		}
+
+		double extent = std::max(maxX - minX, maxY - minY);
+
+		if(extent > 0)
+			p_cellSize = extent / sqrt((double)p_itemCells.size());
+
+		p_cells.clear();
+
+		for(typename std::unordered_map<T*, cellKey>::iterator itemIterator = p_itemCells.begin(); itemIterator != p_itemCells.end(); ++itemIterator)
+		{
+			itemIterator->second = getKey(getCellIndex(itemIterator->first->getCenterXCoordinate()), getCellIndex(itemIterator->first->getCenterYCoordinate()));
+			p_cells[itemIterator->second].push_back(itemIterator->first);
+		}
+
+		p_resizeThreshold = 2 * p_itemCells.size();
+	}
+
+public:
+
+	/**
+	 * @brief Adds an item to the grid. If the item is already in the grid, the position of the item is updated
+	 * @param item The address of the item. This must remain valid until the item is removed from the grid
+	 * @param xCoordinate The x position of the item
+	 * @param yCoordinate The y position of the item
+	 */
+	void insert(T *item, double xCoordinate, double yCoordinate)
+	{
+		typename std::unordered_map<T*, cellKey>::iterator itemIterator = p_itemCells.find(item);
+
+		if(itemIterator != p_itemCells.end())
+			removeFromCell(item, itemIterator->second);
+
+		insertIntoCell(item, getKey(getCellIndex(xCoordinate), getCellIndex(yCoordinate)));
+
+		if(p_itemCells.size() >= p_resizeThreshold)
+			resize();
+	}
+
+	/**
+	 * @brief Adds an item to the grid at the current center of the item
+	 * @param item The address of the item
+	 */
+	void insert(T *item)
+	{
+		insert(item, item->getCenterXCoordinate(), item->getCenterYCoordinate());
+	}
+
+	/**
+	 * @brief Removes an item from the grid. If the item is not in the grid, nothing happens
+	 * @param item The address of the item to remove
+	 */
+	void erase(T *item)
+	{
+		typename std::unordered_map<T*, cellKey>::iterator itemIterator = p_itemCells.find(item);
+
+		if(itemIterator == p_itemCells.end())
+			return;
+
+		removeFromCell(item, itemIterator->second);
+		p_itemCells.erase(itemIterator);
+	}
+
+	/**
+	 * @brief 	Function that is called after an item has been moved. This will place the item
+	 * 			into the cell at the new position.
+	 * @param item The address of the item that was moved
+	 */
+	void update(T *item)
+	{
+		insert(item);
+	}
+
+	/**
+	 * @brief Checks if an item is stored in the grid
+	 * @param item The address of the item
+	 * @return Returns true if the item is in the grid
+	 */
+	bool contains(T *item) const
+	{
+		return (p_itemCells.find(item) != p_itemCells.end());
+	}
+
+	//! Removes all of the items from the grid
+	void clear()
+	{
+		p_cells.clear();
+		p_itemCells.clear();
+		p_cellSize = 1.0;
+		p_resizeThreshold = 64;
+	}
+
+	//! Returns the number of items that are stored in the grid
+	size_t size() const
+	{
+		return p_itemCells.size();
+	}
+
+	/**
+	 * @brief 	Calls the visitor on every item whose center lies within the radius of the point. The visitor
+	 * 			takes in the address of the item and returns true in order to stop the search early. If the radius covers
+	 * 			more cells then there are items, the items are checked directly instead of visiting every cell.
+	 * @param xCoordinate The x position of the center of the search
+	 * @param yCoordinate The y position of the center of the search
+	 * @param radius Any item that is strictly closer then this distance is visited
+	 * @param visitor Function object with the signature bool(T*)
+	 * @return Returns true if the visitor stopped the search
+	 */
+	template<class Visitor>
+	bool visitWithin(double xCoordinate, double yCoordinate, double radius, Visitor visitor) const
+	{
+		if(p_itemCells.empty() || radius <= 0)
+			return false;
+
+		long long minXIndex = getCellIndex(xCoordinate - radius);
+		long long maxXIndex = getCellIndex(xCoordinate + radius);
+		long long minYIndex = getCellIndex(yCoordinate - radius);
+		long long maxYIndex = getCellIndex(yCoordinate + radius);
+
+		double numberOfCells = (double)(maxXIndex - minXIndex + 1) * (double)(maxYIndex - minYIndex + 1);
+
+		if(numberOfCells > (double)p_itemCells.size())
+		{
+			for(typename std::unordered_map<T*, cellKey>::const_iterator itemIterator = p_itemCells.begin(); itemIterator != p_itemCells.end(); ++itemIterator)
+			{
+				if(itemIterator->first->getDistance(xCoordinate, yCoordinate) < radius && visitor(itemIterator->first))
+					return true;
+			}
+
+			return false;
+		}
+
+		for(long long i = minXIndex; i <= maxXIndex; i++)
+		{
+			for(long long j = minYIndex; j <= maxYIndex; j++)
+			{
+				typename std::unordered_map<cellKey, std::vector<T*>>::const_iterator cellIterator = p_cells.find(getKey(i, j));
+
+				if(cellIterator == p_cells.end())
+					continue;
+
+				for(typename std::vector<T*>::const_iterator bucketIterator = cellIterator->second.begin(); bucketIterator != cellIterator->second.end(); ++bucketIterator)
+				{
+					if((*bucketIterator)->getDistance(xCoordinate, yCoordinate) < radius && visitor(*bucketIterator))
+						return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief 	Calls the visitor on every item whose center lies within a rectangular region. This works the
+	 * 			same way as visitWithin except the region is a rectangle instead of a circle. The cells that are completely inside of the
+	 * 			region are visited without looking up the position of their items, so a large region mostly reads the buckets of the grid.
+	 * 			If the region covers more cells then there are items, the occupied cells are checked directly instead of looking up every cell.
+	 * @param minX The lower left x-coordinate of the region
+	 * @param minY The lower left y-coordinate of the region
+	 * @param maxX The upper right x-coordinate of the region
+	 * @param maxY The upper right y-coordinate of the region
+	 * @param visitor Function object with the signature bool(T*)
+	 * @return Returns true if the visitor stopped the search
+	 */
+	template<class Visitor>
+	bool visitBox(double minX, double minY, double maxX, double maxY, Visitor visitor) const
+	{
+		if(p_itemCells.empty() || minX > maxX || minY > maxY)
+			return false;
+
+		long long minXIndex = getCellIndex(minX);
+		long long maxXIndex = getCellIndex(maxX);
+		long long minYIndex = getCellIndex(minY);
+		long long maxYIndex = getCellIndex(maxY);
+
+		double numberOfCells = (double)(maxXIndex - minXIndex + 1) * (double)(maxYIndex - minYIndex + 1);
+
+		if(numberOfCells > (double)p_cells.size())
+		{
+			for(typename std::unordered_map<cellKey, std::vector<T*>>::const_iterator cellIterator = p_cells.begin(); cellIterator != p_cells.end(); ++cellIterator)
+			{
+				long long i = unpackIndex(cellIterator->first >> 32);
+				long long j = unpackIndex(cellIterator->first);
+
+				if(i < minXIndex || i > maxXIndex || j < minYIndex || j > maxYIndex)
+					continue;
+
+				bool isInside = (i > minXIndex && i < maxXIndex && j > minYIndex && j < maxYIndex);
+
+				if(visitBucket(cellIterator->second, isInside, minX, minY, maxX, maxY, visitor))
+					return true;
+			}
+
+			return false;
+		}
+
+		for(long long i = minXIndex; i <= maxXIndex; i++)
+		{
+			for(long long j = minYIndex; j <= maxYIndex; j++)
+			{
+				typename std::unordered_map<cellKey, std::vector<T*>>::const_iterator cellIterator = p_cells.find(getKey(i, j));
+
+				if(cellIterator == p_cells.end())
+					continue;
+
+				bool isInside = (i > minXIndex && i < maxXIndex && j > minYIndex && j < maxYIndex);
+
+				if(visitBucket(cellIterator->second, isInside, minX, minY, maxX, maxY, visitor))
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * @brief Finds any item that lies within the radius of a point
+	 * @param xCoordinate The x position of the center of the search
+	 * @param yCoordinate The y position of the center of the search
+	 * @param radius Any item that is strictly closer then this distance will be returned
+	 * @return Returns the address of the first item found. Returns nullptr if there are no items within the radius
+	 */
+	T *findWithin(double xCoordinate, double yCoordinate, double radius) const
+	{
+		T *foundItem = nullptr;
+
+		visitWithin(xCoordinate, yCoordinate, radius, [&foundItem](T *item) -> bool
+		{
+			foundItem = item;
+			return true;
+		});
+
+		return foundItem;
+	}
+
+	/**
+	 * @brief Finds the item that is closest to a point
+	 * @param xCoordinate The x position of the point
+	 * @param yCoordinate The y position of the point
+	 * @param radius Only items that are within this distance are considered
+	 * @return Returns the address of the closest item. Returns nullptr if there are no items within the radius
+	 */
+	T *findNearest(double xCoordinate, double yCoordinate, double radius) const
+	{
+		T *nearestItem = nullptr;
+		double nearestDistance = radius;
+
+		visitWithin(xCoordinate, yCoordinate, radius, [&nearestItem, &nearestDistance, xCoordinate, yCoordinate](T *item) -> bool
+		{
+			double distance = item->getDistance(xCoordinate, yCoordinate);
+			if(distance < nearestDistance)
+			{
+				nearestDistance = distance;
+				nearestItem = item;
+			}
+			return false;
+		});
+
+		return nearestItem;
+	}
+};
+
+#endif
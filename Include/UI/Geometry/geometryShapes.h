@@ -20,6 +20,10 @@
 #include "Include/common/GeometryProperties/SegmentProperties.h"
 
 #include "Include/UI/Geometry/OGLFT.h"
+#include "Include/UI/Geometry/BoundingBox.h"
+#include "Include/UI/Geometry/ArcPolyline.h"
+#include "Include/UI/Geometry/NodeHandle.h"
+#include "Include/UI/Geometry/LabelTextRenderer.h"
 
 #include <QOpenGLFunctions>
 
@@ -336,6 +340,13 @@ private:
 	*/ 
 	unsigned long _nodeNumber;
 	
+	//! The handle of the node in the handle table of the geometry editor
+	/*!
+		Unlike the address of the node, the handle stays the same when the node list is copied.
+		The handle is not saved to file. A new handle is given out when the node is loaded
+	*/ 
+	nodeHandle p_handle;
+	
 	//! Boolean used to describe if the node was visited. This is used in the mesh maker class.
 	bool p_isVisited = false;
 	
@@ -441,6 +452,24 @@ public:
 	{
 		return _nodeNumber;
 	}
+	
+	/**
+	 * @brief Sets the handle of the node. This is done by the geometry editor when the node is added to the node list
+	 * @param handle The handle of the node
+	 */
+	void setHandle(nodeHandle handle)
+	{
+		p_handle = handle;
+	}
+	
+	/**
+	 * @brief Retrieves the handle of the node
+	 * @return Returns the handle of the node. This is a null handle if the node does not belong to a geometry editor
+	 */
+	nodeHandle getHandle()
+	{
+		return p_handle;
+	}
 };
 
 
@@ -527,32 +556,30 @@ public:
 	/**
 	 * @brief 	Draws the text for the block label onto the screen. The text that is drawn is the material
 	 * 			associated with the block label
-	 * @param textRender 	A pointer to the OGLFT object that needs to be used
-	 * 						for drawing the text
+	 * @param textRender 	The text renderer of the canvas. The text is added to the current frame of the renderer
+	 * 						and is drawn along with the rest of the text of the frame
 	 * @param factor		This is a constant that determines the distance as to
 	 * 						where the text is drawn on the screen. A factor to how much 
 	 * 						of an offset the text needs to be drawn at from the center 
 	 * 						point of the block label.
 	 */
-    void drawBlockName(OGLFT::Grayscale *textRender, double factor)
+    void drawBlockName(labelTextRenderer &textRender, double factor)
     {
         double offset = 0.02 * factor;
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);// TODO: Commented Draw out
-      //  textRender->draw(p_xCenterCoordinate + offset, p_yCenterCoordinate + offset, _property.getMaterialName().c_str());
+        textRender.addText(p_xCenterCoordinate + offset, p_yCenterCoordinate + offset, _property.getMaterialName());
     }
     
 	/**
 	 * @brief Draws the circuit name that is associated with the block label onto the screen
-	 * @param textRender A pointer to hte OGLFT object that is to be used for drawing the text
+	 * @param textRender The text renderer of the canvas
 	 * @param factor	This is a constant that detemines how far of an offset that the 
 	 * 					text should be drawn from the center of the block label
 	 */
-    void drawCircuitName(OGLFT::Grayscale *textRender, double factor)
+    void drawCircuitName(labelTextRenderer &textRender, double factor)
     {
         double offset = 0.02 * factor;
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-     //   if(_property.getCircuitName() != "None")// TODO: Commented Draw out
-     //       textRender->draw(p_xCenterCoordinate + offset, p_yCenterCoordinate - offset, _property.getCircuitName().c_str());
+        if(_property.getCircuitName() != "None")
+            textRender.addText(p_xCenterCoordinate + offset, p_yCenterCoordinate - offset, _property.getCircuitName());
     }
 	
 	/**
@@ -817,6 +844,16 @@ protected:
 	*/ 
     node *p_secondNode = nullptr;
 	
+	//! The handle of the first node
+	/*!
+		The pointers to the nodes are only valid for the node list that they were set from. If the node list
+		is copied, the handles are used by the geometry editor to find the new address of the nodes.
+	*/ 
+	nodeHandle p_firstHandle;
+	
+	//! The handle of the second node
+	nodeHandle p_secondHandle;
+	
 	//! Boolean used to determine if the lines segment is an arc
 	bool p_isArc = false;
 	
@@ -903,6 +940,19 @@ public:
 		}
 	}
 	
+	/**
+	 * @brief 	Calculates the smallest axis aligned box that contains the edge. For lines, this is the box
+	 * 			formed by the two endpoints. This is used by the spatial index in the geometry editor.
+	 * @return Returns the bounding box of the edge. If the edge is not connected to two nodes, an empty box is returned
+	 */
+	virtual boundingBox getBoundingBox()
+	{
+		if(!p_firstNode || !p_secondNode)
+			return boundingBox();
+			
+		return boundingBox::fromPoints(p_firstNode->getCenterXCoordinate(), p_firstNode->getCenterYCoordinate(), p_secondNode->getCenterXCoordinate(), p_secondNode->getCenterYCoordinate());
+	}
+	
 	/**
 	 * @brief Returns the distance that spans across the two points of the edge. For arcs, this would be 
 	 * the arc length. This is mainly used in the mesh module.
@@ -958,6 +1008,7 @@ public:
     {
         p_firstNode = &a_Node;
         p_firstNodeNumber = p_firstNode->getNodeID();
+        p_firstHandle = p_firstNode->getHandle();
     }
     
 	/**
@@ -977,6 +1028,25 @@ public:
     {
         p_secondNode = &a_node;
         p_secondNodeNumber = p_secondNode->getNodeID();
+        p_secondHandle = p_secondNode->getHandle();
+    }
+    
+	/**
+	 * @brief Gets the handle of the first node of the line segment
+	 * @return Returns the handle of the first node. This is a null handle if the first node was not added by a geometry editor
+	 */
+    nodeHandle getFirstNodeHandle()
+    {
+        return p_firstHandle;
+    }
+    
+	/**
+	 * @brief Gets the handle of the second node of the line segment
+	 * @return Returns the handle of the second node
+	 */
+    nodeHandle getSecondNodeHandle()
+    {
+        return p_secondHandle;
     }
     
 	/**
@@ -1140,6 +1210,10 @@ public:
 		p_firstNodeNumber = p_secondNodeNumber;
 		p_secondNodeNumber = tempNumber;
 		
+		nodeHandle tempHandle = p_firstHandle;
+		p_firstHandle = p_secondHandle;
+		p_secondHandle = tempHandle;
+		
 		p_isSwapped = !p_isSwapped;
 	}
 	
@@ -1194,6 +1268,62 @@ private:
 	
     //! Boolean used to determine if the arc is clockwise or counterclock-wise
     bool p_isCounterClockWise = true;
+	
+	/**
+	 * @brief 	The values that the center and the polyline of the arc are computed from. If none of these values have changed
+	 * 			since the last time, the cached result is still valid.
+	 */
+	struct arcCacheKey
+	{
+		double firstX = 0;
+		double firstY = 0;
+		double secondX = 0;
+		double secondY = 0;
+		double arcAngle = 0;
+		double centerX = 0;
+		double centerY = 0;
+		unsigned int numSegments = 0;
+		bool isCounterClockWise = true;
+		
+		bool operator==(const arcCacheKey &key) const
+		{
+			return (firstX == key.firstX && firstY == key.firstY && secondX == key.secondX && secondY == key.secondY && arcAngle == key.arcAngle
+					&& centerX == key.centerX && centerY == key.centerY && numSegments == key.numSegments && isCounterClockWise == key.isCounterClockWise);
+		}
+	};
+	
+	//! The inputs (and the resulting center) of the last call to calculate()
+	arcCacheKey p_calculatedKey;
+	
+	//! Set to true once calculate() has been run on this arc
+	bool p_isCalculated = false;
+	
+	//! The points along the arc from the first node to the second node. There are p_numSegments + 1 points
+	arcPolyline p_polyline;
+	
+	//! The inputs that p_polyline was computed from
+	arcCacheKey p_polylineKey;
+	
+	//! Set to true once p_polyline has been filled in
+	bool p_isPolylineValid = false;
+	
+	//! Returns the current values that the center and the polyline of the arc depend on
+	arcCacheKey getCacheKey()
+	{
+		arcCacheKey key;
+		
+		key.firstX = p_firstNode->getCenterXCoordinate();
+		key.firstY = p_firstNode->getCenterYCoordinate();
+		key.secondX = p_secondNode->getCenterXCoordinate();
+		key.secondY = p_secondNode->getCenterYCoordinate();
+		key.arcAngle = p_arcAngle;
+		key.centerX = p_xCenterCoordinate;
+		key.centerY = p_yCenterCoordinate;
+		key.numSegments = p_numSegments;
+		key.isCounterClockWise = p_isCounterClockWise;
+		
+		return key;
+	}
 public:
 	/**
 	 * @brief The constructor for the clase
@@ -1255,6 +1385,42 @@ public:
         return p_numSegments;
     }
     
+	/**
+	 * @brief 	Returns the points along the arc starting at the first node and ending at the second node. The arc is broken into
+	 * 			getnumSegments() segments. The points are only computed again if the nodes, the angle, the center or the number of segments
+	 * 			have changed since the last call so that the sine and cosine of every segment are not evaluated on every frame.
+	 * 			Note that calculate() must be called before this function.
+	 * @return Returns the list of points. The list is owned by the arc and is only valid until the arc is changed
+	 */
+	const arcPolyline &getPolyline()
+	{
+		arcCacheKey key = getCacheKey();
+		
+		if(p_isPolylineValid && key == p_polylineKey)
+			return p_polyline;
+			
+		double angle = -(p_arcAngle / (double)p_numSegments);
+		
+		p_polyline.clear();
+		p_polyline.reserve(p_numSegments + 1);
+		
+		p_polyline.push_back(QPointF(key.firstX, key.firstY));
+		for(unsigned int i = 1; i + 1 <= p_numSegments; i++)
+		{
+			double cosine = cos(i * angle * PI / 180.0);
+			double sine = sin(i * angle * PI / 180.0);
+			double xPoint = (key.firstX - p_xCenterCoordinate) * cosine + (key.firstY - p_yCenterCoordinate) * sine + p_xCenterCoordinate;
+			double yPoint = -(key.firstX - p_xCenterCoordinate) * sine + (key.firstY - p_yCenterCoordinate) * cosine + p_yCenterCoordinate;
+			p_polyline.push_back(QPointF(xPoint, yPoint));
+		}
+		p_polyline.push_back(QPointF(key.secondX, key.secondY));
+		
+		p_polylineKey = key;
+		p_isPolylineValid = true;
+		
+		return p_polyline;
+	}
+    
     /**
      * @brief The function that is called in order to draw the arc on the screen
 	 * This function will call the necessary OpenGL functions in order to draw the 
@@ -1277,17 +1443,11 @@ public:
             glLineStipple(1, 0b0001100011000110);
         }
         
-        double angle = -(p_arcAngle / (double)p_numSegments);
+        const arcPolyline &polyline = getPolyline();
         
         glBegin(GL_LINE_STRIP);
-            glVertex2d(p_firstNode->getCenterXCoordinate(), p_firstNode->getCenterYCoordinate());
-            for(int i = 1; i <= (p_numSegments - 1); i++)
-            {
-                double xPoint = (p_firstNode->getCenterXCoordinate() - p_xCenterCoordinate) * cos(i * angle * PI / 180.0) + (p_firstNode->getCenterYCoordinate() - p_yCenterCoordinate) * sin(i * angle * PI / 180.0) + p_xCenterCoordinate;
-                double yPoint = -(p_firstNode->getCenterXCoordinate() - p_xCenterCoordinate) * sin(i * angle * PI / 180.0) + (p_firstNode->getCenterYCoordinate() - p_yCenterCoordinate) * cos(i * angle * PI / 180.0) + p_yCenterCoordinate;
-                glVertex2d(xPoint, yPoint);
-            }
-            glVertex2d(p_secondNode->getCenterXCoordinate(), p_secondNode->getCenterYCoordinate());
+            for(const QPointF *pointIterator = polyline.begin(); pointIterator != polyline.end(); ++pointIterator)
+                glVertex2d(pointIterator->x(), pointIterator->y());
         glEnd();
   
         glDisable(GL_LINE_STIPPLE); 
@@ -1311,6 +1471,15 @@ public:
          * the end node is considered the second node of the arc.
          * This is detictated by the order of the selection
          */ 
+        /* Nothing needs to be done if the nodes and the angle are the same as the last time that the arc was calculated.
+         * The center is part of the key so that a center that was changed from outside of this function is always recalculated
+         */
+        arcCacheKey key = getCacheKey();
+        key.numSegments = 0;
+        
+        if(p_isCalculated && key == p_calculatedKey)
+            return;
+        
         double xMid = 0;
         double yMid = 0;
         double a = 0; // This variable is the distance from the midpoint of the two end points to the center of the arc
@@ -1390,6 +1559,9 @@ public:
 		{
 			midSlope = -1.0 / slope;
 			
+			// The length of the vector (1, midSlope). This is used to move a distance of a along the perpendicular of line AB
+			double slopeLength = sqrt(midSlope * midSlope + 1);
+			
 			if(slope > 0)
 			{
                 if((!(p_firstNode->getCenterXCoordinate() > p_secondNode->getCenterXCoordinate()) != (!p_isCounterClockWise)))
@@ -1398,15 +1570,15 @@ public:
 					// If the start node is lower then the end node, the logic is reversed. This portion will create
 					// the center above the arc.
 
-                    p_xCenterCoordinate = xMid - a / sqrt(pow(midSlope, 2) + 1);
-                    p_yCenterCoordinate = yMid - (midSlope * a) / sqrt(pow(midSlope, 2) + 1);
+                    p_xCenterCoordinate = xMid - a / slopeLength;
+                    p_yCenterCoordinate = yMid - (midSlope * a) / slopeLength;
 				}
 				else
 				{
 					// This will calculate the center below the arc
 					
-                    p_xCenterCoordinate = xMid + a / sqrt(pow(midSlope, 2) + 1);
-                    p_yCenterCoordinate = yMid + (midSlope * a) / sqrt(pow(midSlope, 2) + 1);
+                    p_xCenterCoordinate = xMid + a / slopeLength;
+                    p_yCenterCoordinate = yMid + (midSlope * a) / slopeLength;
 
 				}
 			}
@@ -1418,15 +1590,15 @@ public:
 					// If the start node is lower then the end node, the logic is reversed. This portion will create
 					// the center above the arc.
 					
-                    p_xCenterCoordinate = xMid - a / sqrt(pow(midSlope, 2) + 1);
-                    p_yCenterCoordinate = yMid - (midSlope * a) / sqrt(pow(midSlope, 2) + 1);
+                    p_xCenterCoordinate = xMid - a / slopeLength;
+                    p_yCenterCoordinate = yMid - (midSlope * a) / slopeLength;
 				}
 				else
 				{
 					// This will calculate the center below the arc
 					
-                    p_xCenterCoordinate = xMid + a / sqrt(pow(midSlope, 2) + 1);
-                    p_yCenterCoordinate = yMid + (midSlope * a) / sqrt(pow(midSlope, 2) + 1);
+                    p_xCenterCoordinate = xMid + a / slopeLength;
+                    p_yCenterCoordinate = yMid + (midSlope * a) / slopeLength;
 				}
 			}
 			
@@ -1436,11 +1608,47 @@ public:
 		
 		calculateMidPoint();
 		
-		
+		p_calculatedKey = getCacheKey();
+		p_calculatedKey.numSegments = 0;
+		p_isCalculated = true;
 		
         return;
     }
 	
+	/**
+	 * @brief 	Calculates the smallest axis aligned box that contains the arc. The box is formed by the two endpoints
+	 * 			and any of the four extreme points of the circle (the points at 0, 90, 180 and 270 degrees) that lie on the arc.
+	 * 			The arc is swept counter-clockwise from the first node by the arc angle which is the same convention
+	 * 			used by the draw function and the intersection functions in the geometry editor.
+	 * 			The box is grown slightly in order to account for any round off between the radius and the endpoints.
+	 * 			Note that calculate() must be called before this function.
+	 * @return Returns the bounding box of the arc. If the arc is not connected to two nodes, an empty box is returned
+	 */
+	boundingBox getBoundingBox()
+	{
+		if(!p_firstNode || !p_secondNode)
+			return boundingBox();
+			
+		boundingBox box = edgeLineShape::getBoundingBox();
+		
+		double startAngle = atan2(p_firstNode->getCenterYCoordinate() - p_yCenterCoordinate, p_firstNode->getCenterXCoordinate() - p_xCenterCoordinate);
+		double sweepAngle = p_arcAngle * PI / 180.0;
+		
+		for(int i = 0; i < 4; i++)
+		{
+			double extremeAngle = i * PI / 2.0;
+			double offset = fmod(extremeAngle - startAngle, 2.0 * PI);
+			
+			if(offset < 0)
+				offset += 2.0 * PI;
+				
+			if(offset < sweepAngle)
+				box.expandToInclude(p_xCenterCoordinate + p_radius * cos(extremeAngle), p_yCenterCoordinate + p_radius * sin(extremeAngle));
+		}
+		
+		return box.inflated(p_radius * 1.0e-08);
+	}
+	
 	void calculateMidPoint()
 	{
         double xMid = (p_firstNode->getCenterXCoordinate() + p_secondNode->getCenterXCoordinate()) / 2.0;
@@ -5,6 +5,7 @@
 
 #include <QOpenGLWidget>
 #include <QOpenGLFunctions>
+#include <QOpenGLFramebufferObject>
 #include <QMatrix4x4>
 #include <QMouseEvent>
 #include <QWheelEvent>
@@ -20,6 +21,7 @@
 #include "Include/UI/Geometry/OGLFT.h"
 #include "Include/UI/Geometry/geometryShapes.h"
 #include "Include/UI/Geometry/GeometryEditor2D.h"
+#include "Include/UI/Geometry/SceneRenderer.h"
 
 #include "Include/UI/Geometry/GeometryDialog/ArcSegmentDialog.h"
 
@@ -83,21 +85,154 @@ private:
 
     problemDefinition *p_localDefinition = nullptr;
 
-    OGLFT::Grayscale *p_fontRender = nullptr;
-
     geometryEditor2D p_editor;
 
+    //! Draws the grid, the geometry of p_editor and the names of the block labels
+    /*!
+        The vertex buffers of the geometry are rebuilt when the revision of the editor changes. Since the selected state is set directly
+        on the geometry, anything in the canvas that changes the selection needs to call invalidateScene().
+        \sa sceneRenderer, geometryRenderer
+    */
+    sceneRenderer p_scene;
+
+    //! Set to true in order to find the geometry that the user clicked on by reading back the IDs that the geometry renderer draws
+    /*!
+        Otherwise, the geometry is found through the spatial indexes of the editor.
+        \sa pickGeometry
+    */
+    bool p_useGPUPicking = false;
+
+    //! The state of the view that the cached scene was drawn with
+    /*!
+        Everything that changes how the grid or the geometry is drawn is part of the state. As long as the state
+        has not changed, the cached scene can be copied to the screen instead of being drawn again.
+    */
+    struct sceneState
+    {
+        double cameraX = 0;
+        double cameraY = 0;
+        double zoomX = 0;
+        double zoomY = 0;
+        int width = 0;
+        int height = 0;
+        double gridStep = 0;
+        bool showGrid = false;
+        bool showAxis = false;
+        bool showOrigin = false;
+        bool showBlockName = false;
+        unsigned long geometryRevision = 0;
+
+        bool operator==(const sceneState &state) const
+        {
+            return (cameraX == state.cameraX && cameraY == state.cameraY && zoomX == state.zoomX && zoomY == state.zoomY &&
+                    width == state.width && height == state.height && gridStep == state.gridStep && showGrid == state.showGrid &&
+                    showAxis == state.showAxis && showOrigin == state.showOrigin && showBlockName == state.showBlockName &&
+                    geometryRevision == state.geometryRevision);
+        }
+    };
+
+    //! Holds an image of the grid and the geometry
+    /*!
+        Most repaints only change what is drawn on top of the geometry (such as the selection window or a node that is being dragged).
+        For these, the image is copied to the screen and only the overlay is drawn.
+        \sa drawScene, p_sceneCacheState
+    */
+    QOpenGLFramebufferObject *p_sceneCache = nullptr;
+
+    //! The state that the scene in p_sceneCache was drawn with
+    sceneState p_sceneCacheState;
+
+    //! Set to false when the cached scene needs to be drawn again even if the state did not change
+    bool p_sceneCacheIsValid = false;
+
+    //! Set to true when the canvas holds a copy of the cached scene. After this, only the areas covered by the overlay need to be copied again
+    bool p_screenHasScene = false;
+
+    //! The areas of the canvas that the overlay was drawn over during the last repaint. These are in pixels with the origin at the bottom left
+    std::vector<QRect> p_overlayRegions;
+
+    /**
+     * @brief Records the area of the canvas that is covered by a part of the overlay
+     * @param firstPoint One corner of the part of the overlay. This is in model coordinates
+     * @param secondPoint The opposite corner of the part of the overlay. This is in model coordinates
+     * @param padding The number of pixels that the part extends past the corners (such as half of the line width)
+     */
+    void addOverlayRegion(QPointF firstPoint, QPointF secondPoint, int padding)
+    {
+        double width = (double)this->geometry().width();
+        double height = (double)this->geometry().height();
+
+        // This is the reverse of convertToXCoordinate and convertToYCoordinate
+        double firstX = (firstPoint.x() - p_cameraX) * height / (2.0 * p_zoomX) + width / 2.0;
+        double firstY = (firstPoint.y() - p_cameraY) * height / (2.0 * p_zoomY) + height / 2.0;
+        double secondX = (secondPoint.x() - p_cameraX) * height / (2.0 * p_zoomX) + width / 2.0;
+        double secondY = (secondPoint.y() - p_cameraY) * height / (2.0 * p_zoomY) + height / 2.0;
+
+        int left = (int)floor(std::min(firstX, secondX)) - padding;
+        int bottom = (int)floor(std::min(firstY, secondY)) - padding;
+        int right = (int)ceil(std::max(firstX, secondX)) + padding;
+        int top = (int)ceil(std::max(firstY, secondY)) + padding;
+
+        p_overlayRegions.push_back(QRect(left, bottom, right - left, top - bottom));
+    }
+
+    /**
+     * @brief Copies part of the cached scene onto the canvas
+     * @param region The area to copy. This is in pixels with the origin at the bottom left
+     */
+    void copySceneRegion(const QRect &region);
+
+    //! Returns the current state of the view. This needs to be called after updateProjection
+    sceneState getSceneState()
+    {
+        sceneState state;
+
+        state.cameraX = p_cameraX;
+        state.cameraY = p_cameraY;
+        state.zoomX = p_zoomX;
+        state.zoomY = p_zoomY;
+        state.width = this->geometry().width();
+        state.height = this->geometry().height();
+        state.gridStep = p_preferences.getGridStep();
+        state.showGrid = p_preferences.getShowGridState();
+        state.showAxis = p_preferences.getShowAxisState();
+        state.showOrigin = p_preferences.getShowOriginState();
+        state.showBlockName = p_preferences.getShowBlockNameState();
+        state.geometryRevision = p_editor.getGeometryRevision();
+
+        return state;
+    }
+
+    //! Function that is called after the geometry has changed in a way that the editor does not keep track of
+    /*!
+        This includes changing the selected state of the geometry and changing the properties of a block label.
+        The colors of the renderer are updated and the cached scene is drawn again on the next repaint.
+    */
+    void invalidateScene()
+    {
+        p_scene.getGeometryRenderer().invalidateColors();
+        p_sceneCacheIsValid = false;
+    }
+
     gridPreferences p_preferences;
 
-    void updateProjection()
+    //! Returns the current view of the canvas
+    sceneCamera getCamera()
     {
-        glViewport(0, 0, (double)this->geometry().width(), (double)this->geometry().height());
+        sceneCamera camera;
 
-        glMatrixMode(GL_PROJECTION);
-        glLoadIdentity();
+        camera.cameraX = p_cameraX;
+        camera.cameraY = p_cameraY;
+        camera.zoomX = p_zoomX;
+        camera.zoomY = p_zoomY;
+        camera.width = this->geometry().width();
+        camera.height = this->geometry().height();
 
-        double aspectRatio = (double)this->geometry().width() / (double)this->geometry().height();
+        return camera;
+    }
 
+    void updateProjection()
+    {
         if(p_zoomX < 1e-9 || p_zoomY < 1e-9)
         {
             p_zoomX = 1e-9;
@@ -110,12 +245,7 @@ private:
             p_zoomY = p_zoomX;
         }
 
-        glOrtho(-p_zoomX * aspectRatio, p_zoomX * aspectRatio, -p_zoomY, p_zoomY, -1.0, 1.0);
-
-        glMatrixMode(GL_MODELVIEW);
-        glLoadIdentity();
-
-        glTranslated(-p_cameraX, -p_cameraY, 0.0);
+        p_scene.applyCamera(getCamera());
     }
 
     double convertToXCoordinate(int xPixel)
@@ -129,6 +259,18 @@ private:
         return p_zoomY * ((-(2.0 / (double)this->geometry().height()) * ((double)yPixel - (double)this->geometry().height() / 2.0)) / 1.0) + p_cameraY;
     }
 
+    //! Returns the part of the model that is visible on the canvas. This is the box that glOrtho maps onto the canvas
+    boundingBox getVisibleWindow()
+    {
+        return getCamera().getVisibleWindow();
+    }
+
+    //! Returns the size of one pixel of the canvas in model coordinates
+    double getPixelSize()
+    {
+        return getCamera().getPixelSize();
+    }
+
     double getTolerance()
     {
         return ((((p_zoomX + p_zoomY) / 2.0) / 25.0));
@@ -180,7 +322,13 @@ private:
 
 
 
-    void drawGrid();
+    //! Draws the grid and the geometry
+    /*!
+        If the state of the view has not changed since the last time that the scene was drawn, the cached image of the scene
+        is copied to the screen. Otherwise, the scene is drawn into the cache first. If the cache could not be created,
+        the scene is drawn directly to the screen.
+    */
+    void drawScene();
 
     void mousePressEvent(QMouseEvent *event) override;
 
@@ -199,19 +347,36 @@ private:
 
 	void onMouseRightUp(QMouseEvent *event);
 
+    //! Finds the node, block label, line and arc that are closest to a point and within the tolerance of the point
+    /*!
+        If p_useGPUPicking is set, the geometry is found with the geometry renderer of p_scene. Otherwise (or if the renderer could not pick), the
+        geometry is found through the spatial indexes of the editor.
+        \param xCoordinate The x-coordinate of the point
+        \param yCoordinate The y-coordinate of the point
+        \param pickedNode The closest node or nullptr
+        \param pickedLabel The closest block label or nullptr
+        \param pickedLine The closest line or nullptr
+        \param pickedArc The closest arc or nullptr
+    */
+    void pickGeometry(double xCoordinate, double yCoordinate, node *&pickedNode, blockLabel *&pickedLabel, edgeLineShape *&pickedLine, arcShape *&pickedArc);
+
 public:
     GLCanvasWidget(QWidget *parent, problemDefinition &definition) : QOpenGLWidget(parent)
     {
        p_localDefinition = &definition;
-    //   p_fontRender = new OGLFT::Grayscale(":/fonts/DejaVuSansMono.ttf", 8);
        this->setMouseTracking(true);
 
+       // The contents of the canvas are kept between repaints so that only the overlay needs to be redrawn
+       this->setUpdateBehavior(QOpenGLWidget::PartialUpdate);
+
        this->installEventFilter(this);
     }
 
     void initializeGL() override
     {
         initializeOpenGLFunctions();
+        p_scene.initialize();
+        p_screenHasScene = false;
 
         glViewport(0, 0, (double)this->geometry().width(), (double)this->geometry().height());
         glClearColor(1, 1, 1, 1);
@@ -243,10 +408,9 @@ public:
         initializeOpenGLFunctions();
 
         glMatrixMode(GL_MODELVIEW);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         updateProjection();
-        drawGrid();
+        drawScene();
         glMatrixMode(GL_MODELVIEW);
 
         if(p_drawMesh)
@@ -254,36 +418,28 @@ public:
 
         }
 
-        for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-        {
-            lineIterator->draw();
-        }
-
-        for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-        {
-            arcIterator->draw();
-        }
-
-        for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
+        /* Everything after this point is the overlay and is drawn on every repaint. The area that is covered by
+         * the overlay is recorded so that drawScene can remove the overlay on the next repaint
+         */
+        if(p_editor.getNodeList()->size() > 0 && p_editor.getLastNodeAdd()->getDraggingState())
         {
-            nodeIterator->draw();
+            p_editor.getLastNodeAdd()->draw();
+            addOverlayRegion(p_editor.getLastNodeAdd()->getCenter(), p_editor.getLastNodeAdd()->getCenter(), 4);
         }
 
-        for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
+        if(p_editor.getBlockLabelList()->size() > 0 && p_editor.getLastBlockLabelAdded()->getDraggingState())
         {
-            blockIterator->draw();
-
-            if(p_preferences.getShowBlockNameState() && !blockIterator->getDraggingState())
-            {
-                blockIterator->drawBlockName(p_fontRender, (p_zoomX + p_zoomY) / 2.0);
-
-                if(p_localDefinition->getPhysicsProblem() == physicProblems::PROB_MAGNETICS)
-                    blockIterator->drawCircuitName(p_fontRender, (p_zoomX + p_zoomY) / 2.0);
-            }
+            p_editor.getLastBlockLabelAdded()->draw();
+            addOverlayRegion(p_editor.getLastBlockLabelAdded()->getCenter(), p_editor.getLastBlockLabelAdded()->getCenter(), 4);
         }
 
         if(p_doZoomWindow || p_doSelectionWindow)// We are going to be drawing the same thing for this one
         {
+            addOverlayRegion(p_startPoint, QPointF(p_startPoint.x(), p_endPoint.y()), 3);
+            addOverlayRegion(QPointF(p_startPoint.x(), p_endPoint.y()), p_endPoint, 3);
+            addOverlayRegion(p_endPoint, QPointF(p_endPoint.x(), p_startPoint.y()), 3);
+            addOverlayRegion(QPointF(p_endPoint.x(), p_startPoint.y()), p_startPoint, 3);
+
             glLineWidth(3.0);
             glEnable(GL_LINE_STIPPLE);
             glLineStipple(1, 0b0001100011000110);
@@ -307,6 +463,7 @@ public:
 
         if(p_doMirrorLine)
         {
+            addOverlayRegion(p_startPoint, p_endPoint, 3);
             glLineWidth(3.0);
             glEnable(GL_LINE_STIPPLE);
 
@@ -362,6 +519,22 @@ public:
 		return p_createNodes;
 	}
 
+	//! Returns the editor that holds the geometry of the model
+	geometryEditor2D &getEditor()
+	{
+		return p_editor;
+	}
+
+	void setGPUPickingState(bool state)
+	{
+		p_useGPUPicking = state;
+	}
+
+	bool getGPUPickingState()
+	{
+		return p_useGPUPicking;
+	}
+
 	//! Will cause the canvas to zoom in by a pre determined factor.
 	/*!
 		This function will zoom in by a pre determined factor. This factor was determined by experimentation.
@@ -377,7 +550,7 @@ public:
 		else if(p_zoomY > p_zoomX)
 			p_zoomX = p_zoomY;
 
-		this->repaint();
+		this->update();
 	}
 
 	//! Will cause the canvas to zoom out by a pre determined factor.
@@ -395,38 +568,40 @@ public:
 		else if(p_zoomY > p_zoomX)
 			p_zoomX = p_zoomY;
 
-		this->repaint();
+		this->update();
 	}
 
-	void clearSelection()
+	//! Will cause the canvas to zoom to the extents of the model.
+	/*!
+		The camera is centered on the bounding box of the nodes and the zoom is set so that the entire box
+		fits on the screen with a small margin. If there is no geometry or all of the nodes are at the same point,
+		then the zoom is not changed.
+	*/
+	void zoomToFit()
 	{
-		for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-		{
-			if(nodeIterator->getIsSelectedState())
-				nodeIterator->setSelectState(false);
-		}
+		boundingBox modelBox;
 
+		if(!p_editor.getModelBoundingBox(modelBox))
+			return;
 
-		for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-		{
-			if(blockIterator->getIsSelectedState())
-				blockIterator->setSelectState(false);
-		}
+		sceneCamera camera = getCamera();
 
+		camera.zoomToFit(modelBox);
 
-		for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-		{
-			if(lineIterator->getIsSelectedState())
-				lineIterator->setSelectState(false);
-		}
+		p_cameraX = camera.cameraX;
+		p_cameraY = camera.cameraY;
+		p_zoomX = camera.zoomX;
+		p_zoomY = camera.zoomY;
 
-		for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-		{
-			if(arcIterator->getIsSelectedState())
-				arcIterator->setSelectState(false);
-		}
+		this->update();
+	}
+
+	void clearSelection()
+	{
+		p_editor.clearSelection();
 
 		p_editor.resetIndexs();
+		invalidateScene();
 
 		p_nodesAreSelected = false;
 		p_linesAreSelected = false;
@@ -435,7 +610,13 @@ public:
 		p_geometryGroupIsSelected = false;
 	}
 
-    virtual ~GLCanvasWidget() {}
+    virtual ~GLCanvasWidget()
+    {
+        makeCurrent();
+        p_scene.release();
+        delete p_sceneCache;
+        doneCurrent();
+    }
 
 protected:
     bool eventFilter(QObject *obj, QEvent *event);
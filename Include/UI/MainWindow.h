@@ -20,12 +20,14 @@
 #include <QIcon>
 #include <QMessageBox>
 #include <QMetaMethod>
+#include <QTimer>
 
 #include <QDebug>
 
 #include "Include/common/Enums.h"
 #include "Include/UI/Geometry/glcanvas.h"
 #include "Include/common/ProblemDefinition.h"
+#include "Include/UI/ProjectSaveThread.h"
 
 #define PHYSICS_SELECTION_WINDOW_SIZE QSize(184, 141)
 #define INITIAL_START_WINDOW QSize(184, 65)
@@ -37,6 +39,8 @@
 #define FADE_OUT_TIME_MS 1000
 #define WINDOW_SIZE_TIME_MS 1000
 
+#define AUTOSAVE_INTERVAL_MS 300000
+
 namespace Ui {
 class MainWindow;
 }
@@ -108,6 +112,7 @@ private:
     QAction *p_viewZoomInAct = nullptr;
     QAction *p_viewZoomOutAct = nullptr;
     QAction *p_viewZoomWindowAct = nullptr;
+    QAction *p_viewZoomNaturalAct = nullptr;
     QAction *p_viewShowBlockNameAct = nullptr;
     QAction *p_viewShowOpenBoundAct = nullptr;
     QAction *p_viewDispStatusBarAct = nullptr;
@@ -166,8 +171,36 @@ private:
 
     problemDefinition p_problemDefinition;
 
+    // Variables for saving the model
+
+    //! The save that is being written. This is nullptr when no save is running
+    projectSaveThread *p_saveThread = nullptr;
+
+    //! Starts the autosave on a fixed interval
+    QTimer *p_autosaveTimer = nullptr;
+
+    //! The path of a save that was requested while another save was running. The save is started once the running save has finished
+    QString p_pendingSavePath;
+
+    //! The revision of the geometry when the running save took its snapshot
+    unsigned long p_snapshotRevision = 0;
+
+    //! The revision of the geometry that was last written to a file. Autosave is skipped if the geometry has not changed since
+    unsigned long p_savedRevision = 0;
+
     void changeGUIState(systemState nextState);
 
+    /**
+     * @brief   Takes a snapshot of the model and starts writing the snapshot to a file in the background.
+     *          If a save is already running, then the save is started after the running save finishes.
+     * @param filePath The path of the file
+     * @param isAutosave Set to true if the save was started by the autosave timer
+     */
+    void startSave(const QString &filePath, bool isAutosave);
+
+    //! Returns the path of the file that the autosave writes to
+    QString getAutosavePath();
+
     void createActions();
 
     void createToolbarActions();
@@ -188,6 +221,12 @@ private:
 
     void updateGUIComplete();
 
+    void onSaveProgress(int percent);
+
+    void onSaveFinished();
+
+    void onAutosave();
+
     // ----- Slots for the File Menu -------
 
     void onFileNewFile();
@@ -238,6 +277,8 @@ private:
 
     void onViewZoomWindow();
 
+    void onViewZoomNatural();
+
     void onViewDispBlockName();
 
     void onViewDispOpenBoundary();
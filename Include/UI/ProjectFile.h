@@ -0,0 +1,323 @@
+#ifndef PROJECT_FILE_H_
+#define PROJECT_FILE_H_
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include <QFile>
+
+#include "Include/common/ProblemDefinition.h"
+#include "Include/UI/Geometry/GeometryEditor2D.h"
+
+struct projectSectionTable;
+
+/**
+ * @class projectSnapshot
+ * @file ProjectFile.h
+ * @brief 	A copy of everything that is saved in a project file at one point in time. The geometry is copied by encoding it into the
+ * 			sections of the file, which is much smaller than a copy of the geometry lists. The problem definition is copied as is
+ * 			and is only serialized when the snapshot is written. The snapshot does not refer back to the editor or the definition, so the
+ * 			snapshot can be written on another thread while the model is edited. Use projectFile::takeSnapshot to fill in the snapshot.
+ */
+class projectSnapshot
+{
+private:
+	friend class projectFile;
+
+	//! Room for the header of the file followed by the sections of the geometry and the string table
+	std::vector<unsigned char> p_contents;
+
+	//! The number of sections in p_contents
+	uint32_t p_sectionCount = 0;
+
+	problemDefinition p_definition;
+
+public:
+	//! Returns true if the snapshot has not been taken or has already been written
+	bool isEmpty() const
+	{
+		return p_contents.empty();
+	}
+};
+
+
+
+/**
+ * @class projectFile
+ * @file ProjectFile.h
+ * @brief 	Reads and writes the binary project file. The file holds the problem definition and all of the geometry of the editor.
+ * 			Every number in the file is little endian. The file starts with a 16 byte header:
+ * 				- 8 bytes: the characters OFEMPROJ
+ * 				- 4 bytes: the version of the format
+ * 				- 4 bytes: the number of sections
+ *
+ * 			Each section starts on an 8 byte boundary with a 16 byte header: the tag of the section (4 characters), the flags of the section (4 bytes)
+ * 			and the length of the section in bytes (8 bytes). A reader skips any section that it does not know without reading or expanding it,
+ * 			so the geometry and the problem definition can be loaded from a file that also holds large sections that the reader does not need.
+ * 			The sections are:
+ * 				- STRS: The string table. This is the number of strings followed by the length and the UTF-8 bytes of each string.
+ * 				  The names of the properties, boundaries, conductors, materials and circuits of the geometry are stored once here and the records refer to them by index.
+ * 				- NODE, LINE, ARCS, LABL: The nodes, lines, arcs and block labels. These start with the number of records and the size of one record.
+ * 				  Each record has a fixed size so that a newer version of the format can add fields to the end of a record. The lines and arcs refer to their
+ * 				  nodes by the position of the node in the NODE section.
+ * 				  The coordinates of the nodes are not part of the records. These are stored before the records as a column of all of the
+ * 				  x-coordinates followed by a column of all of the y-coordinates (the same layout as the nodeStore). Since the columns are aligned,
+ * 				  a projectFileView hands out the columns of a mapped file without copying them.
+ * 				- DEFN: The problem definition (the materials, boundary conditions and preferences). This is small compared to the geometry
+ * 				  and is stored as a boost text archive.
+ *
+ * 			Only the values that cannot be computed are stored. The length, the midpoint, the center and the radius of the lines and arcs
+ * 			are calculated again when the file is loaded.
+ *
+ * 			If the first bit of the flags is set, then the section is compressed. A compressed section is split into chunks of 1 MB and
+ * 			each chunk is compressed on its own with qCompress (zlib with the length of the chunk in front of the compressed data),
+ * 			so the chunks are compressed and expanded on all of the cores of the machine. The contents of a compressed section are the length
+ * 			of the expanded section (8 bytes), the size of the chunks before compression (4 bytes), the number of chunks (4 bytes),
+ * 			the length of each compressed chunk (8 bytes each) and then the compressed chunks. A section is only stored compressed
+ * 			if the section gets smaller. Version 2 of the format is the same without compressed sections and is still read.
+ */
+class projectFile
+{
+public:
+	//! The version of the format that is written. Files with any other version are not read
+	enum : unsigned int { FORMAT_VERSION = 3 };
+
+	/**
+	 * @brief 	Copies the problem definition and the geometry into a snapshot. This is the part of saving that needs to be done
+	 * 			on the thread that edits the model
+	 * @param definition The problem definition
+	 * @param editor The editor that holds the geometry
+	 * @param snapshot The snapshot. Any contents of the snapshot are replaced
+	 */
+	static void takeSnapshot(problemDefinition &definition, geometryEditor2D &editor, projectSnapshot &snapshot);
+
+	/**
+	 * @brief Finishes a snapshot into the format of the project file. This can be done on any thread
+	 * @param snapshot The snapshot. The contents are moved into the buffer, so the snapshot is empty afterwards
+	 * @param buffer The buffer. Any contents of the buffer are replaced
+	 * @param compress Set to true to compress the sections. The columns of the nodes of an uncompressed file can be read without copying them
+	 */
+	static void write(projectSnapshot &snapshot, std::vector<unsigned char> &buffer, bool compress = true);
+
+	/**
+	 * @brief Writes the problem definition and the geometry into a buffer in the format of the project file
+	 * @param definition The problem definition
+	 * @param editor The editor that holds the geometry
+	 * @param buffer The buffer. Any contents of the buffer are replaced
+	 * @param compress Set to true to compress the sections
+	 */
+	static void write(problemDefinition &definition, geometryEditor2D &editor, std::vector<unsigned char> &buffer, bool compress = true);
+
+	/**
+	 * @brief 	Reads a project file that is held in memory. The whole file is checked before anything is changed.
+	 * 			If the file can be read, then the geometry of the editor is replaced by the geometry of the file.
+	 * @param data The contents of the file
+	 * @param size The number of bytes in the file
+	 * @param definition The problem definition that is set from the file
+	 * @param editor The editor that the geometry is loaded into
+	 * @return Returns true if the file was read. Otherwise, returns false and neither the definition nor the editor are changed
+	 */
+	static bool read(const unsigned char *data, size_t size, problemDefinition &definition, geometryEditor2D &editor);
+
+	/**
+	 * @brief Saves the problem definition and the geometry to a file. The old file is only replaced once the new file has been written
+	 * @param filePath The path of the file
+	 * @param definition The problem definition
+	 * @param editor The editor that holds the geometry
+	 * @param compress Set to true to compress the sections
+	 * @return Returns true if the whole file was written. Otherwise, returns false
+	 */
+	static bool save(const std::string &filePath, problemDefinition &definition, geometryEditor2D &editor, bool compress = true);
+
+	/**
+	 * @brief Loads the problem definition and the geometry from a file. The file is mapped into memory and read in place
+	 * @param filePath The path of the file
+	 * @param definition The problem definition that is set from the file
+	 * @param editor The editor that the geometry is loaded into
+	 * @return Returns true if the file was loaded. Otherwise, returns false and neither the definition nor the editor are changed
+	 */
+	static bool load(const std::string &filePath, problemDefinition &definition, geometryEditor2D &editor);
+
+	/**
+	 * @brief Checks if a file starts with the header of the project file
+	 * @param filePath The path of the file
+	 * @return Returns true if the file is a project file. Otherwise, returns false
+	 */
+	static bool isProjectFile(const std::string &filePath);
+
+private:
+	friend class projectFileView;
+
+	//! Builds the definition and the geometry from the sections of a file that were already found and checked
+	static bool read(const projectSectionTable &sections, problemDefinition &definition, geometryEditor2D &editor);
+};
+
+
+
+/**
+ * @brief The location of one of the sections of records (NODE, LINE, ARCS or LABL) in a project file that is held in memory
+ */
+struct projectRecordSection
+{
+	//! The first record
+	const unsigned char *records = nullptr;
+
+	//! The columns that are stored in front of the records. Only the node section has columns
+	const unsigned char *columns = nullptr;
+
+	uint32_t count = 0;
+
+	uint32_t recordSize = 0;
+
+	const unsigned char *getRecord(uint32_t index) const
+	{
+		return records + (size_t)index * recordSize;
+	}
+};
+
+
+
+/**
+ * @class projectFileView
+ * @file ProjectFile.h
+ * @brief 	A read only view of a project file that is mapped into memory. Opening the view only checks the header and the sections
+ * 			of the file. None of the geometry is copied and the operating system reads in the pages of the file as the records are accessed.
+ * 			The exception is a compressed section, which is expanded into memory that the view owns when the view is opened.
+ * 			This is meant for the tools that only need to look at the model (such as finding the extents of the model or comparing two files).
+ * 			The records are accessed by their position in their section. The lines and arcs refer to their nodes by position as well.
+ * 			The indexes that are given to the functions are not checked. Use load() to build an editor from the file.
+ * 			The view needs to stay open for as long as the columns of the nodes are in use.
+ */
+class projectFileView
+{
+private:
+	QFile p_file;
+
+	const unsigned char *p_data = nullptr;
+
+	size_t p_size = 0;
+
+	//! The contents of the compressed sections after they were expanded
+	std::vector<std::vector<unsigned char>> p_expandedSections;
+
+	const unsigned char *p_definition = nullptr;
+
+	uint64_t p_definitionLength = 0;
+
+	//! The position of the length of each string in the string table
+	std::vector<const unsigned char*> p_strings;
+
+	projectRecordSection p_nodes;
+
+	projectRecordSection p_lines;
+
+	projectRecordSection p_arcs;
+
+	projectRecordSection p_labels;
+
+	//! The columns of the coordinates are only copied on machines that are not little endian
+	std::vector<double> p_swappedCoordinates;
+
+public:
+	~projectFileView()
+	{
+		close();
+	}
+
+	/**
+	 * @brief Maps a file into memory and checks the header and the sections of the file
+	 * @param filePath The path of the file
+	 * @return Returns true if the file is a project file that can be read. Otherwise, returns false and the view is closed
+	 */
+	bool open(const std::string &filePath);
+
+	//! Unmaps the file. Any columns that were handed out are no longer valid
+	void close();
+
+	bool isOpen() const
+	{
+		return (p_data != nullptr);
+	}
+
+	/**
+	 * @brief Builds the problem definition and the geometry from the mapped file. This is the same as projectFile::load without reading the file again
+	 * @param definition The problem definition that is set from the file
+	 * @param editor The editor that the geometry is loaded into
+	 * @return Returns true if the file was loaded. Otherwise, returns false and neither the definition nor the editor are changed
+	 */
+	bool load(problemDefinition &definition, geometryEditor2D &editor) const;
+
+	//! Returns the number of strings in the string table
+	uint32_t getStringCount() const
+	{
+		return (uint32_t)p_strings.size();
+	}
+
+	std::string getString(uint32_t index) const;
+
+	uint32_t getNodeCount() const
+	{
+		return p_nodes.count;
+	}
+
+	//! Returns the x-coordinates of all of the nodes in the order of the NODE section
+	const double *getNodeXCoordinates() const;
+
+	//! Returns the y-coordinates of all of the nodes in the order of the NODE section
+	const double *getNodeYCoordinates() const;
+
+	unsigned long getNodeID(uint32_t index) const;
+
+	//! Returns the settings of a node with the names filled in from the string table
+	nodeSetting getNodeSetting(uint32_t index) const;
+
+	uint32_t getLineCount() const
+	{
+		return p_lines.count;
+	}
+
+	//! Returns the position of the first node of a line in the NODE section
+	uint32_t getLineFirstNode(uint32_t index) const;
+
+	//! Returns the position of the second node of a line in the NODE section
+	uint32_t getLineSecondNode(uint32_t index) const;
+
+	segmentProperty getLineProperty(uint32_t index) const;
+
+	uint32_t getArcCount() const
+	{
+		return p_arcs.count;
+	}
+
+	uint32_t getArcFirstNode(uint32_t index) const;
+
+	uint32_t getArcSecondNode(uint32_t index) const;
+
+	segmentProperty getArcProperty(uint32_t index) const;
+
+	//! Returns the angle of an arc. The angle is negative for an arc that is clockwise
+	double getArcAngle(uint32_t index) const;
+
+	unsigned int getArcNumberOfSegments(uint32_t index) const;
+
+	uint32_t getBlockLabelCount() const
+	{
+		return p_labels.count;
+	}
+
+	double getBlockLabelXCoordinate(uint32_t index) const;
+
+	double getBlockLabelYCoordinate(uint32_t index) const;
+
+	blockProperty getBlockLabelProperty(uint32_t index) const;
+
+	/**
+	 * @brief Finds the box around all of the nodes and block labels. Only the coordinates are read from the file
+	 * @param box The box
+	 * @return Returns false if the file has no nodes and no block labels. Otherwise, returns true
+	 */
+	bool getBoundingBox(boundingBox &box) const;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef PROJECT_SAVE_THREAD_H_
+#define PROJECT_SAVE_THREAD_H_
+
+#include <QString>
+#include <QThread>
+
+#include "Include/UI/ProjectFile.h"
+
+/**
+ * @class projectSaveThread
+ * @file ProjectSaveThread.h
+ * @brief 	Writes a snapshot of the model to a project file on its own thread so that the model can be edited while the file is written.
+ * 			The snapshot is taken on the GUI thread (see projectFile::takeSnapshot) and handed to the thread when the thread is created.
+ * 			The thread serializes the problem definition, compresses the sections, writes the file in pieces and reports the progress after each piece.
+ * 			The file is written to a temporary file that replaces the file only after the whole file was written, so a save that fails
+ * 			(or a crash during the save) never leaves behind a partial file. Once the thread has finished, the result is read with
+ * 			getSavedState and getErrorMessage.
+ */
+class projectSaveThread : public QThread
+{
+	Q_OBJECT
+
+private:
+	//! The number of bytes that are written between the reports of the progress
+	enum : size_t { WRITE_CHUNK_SIZE = 4 * 1024 * 1024 };
+
+	projectSnapshot p_snapshot;
+
+	QString p_filePath;
+
+	//! Set to true if the save was started by the autosave timer
+	bool p_isAutosave = false;
+
+	bool p_isSaved = false;
+
+	QString p_errorMessage;
+
+protected:
+	void run() override;
+
+public:
+	/**
+	 * @brief Constructor for the class
+	 * @param snapshot The snapshot to write. The contents of the snapshot are moved into the thread
+	 * @param filePath The path of the file
+	 * @param isAutosave Set to true if the save was started by the autosave timer
+	 * @param parent The parent of the thread
+	 */
+	projectSaveThread(projectSnapshot &snapshot, const QString &filePath, bool isAutosave, QObject *parent = nullptr);
+
+	QString getFilePath() const
+	{
+		return p_filePath;
+	}
+
+	bool isAutosave() const
+	{
+		return p_isAutosave;
+	}
+
+	//! Returns true if the whole file was written. Only valid after the thread has finished
+	bool getSavedState() const
+	{
+		return p_isSaved;
+	}
+
+	//! Returns the reason that the file could not be written
+	QString getErrorMessage() const
+	{
+		return p_errorMessage;
+	}
+
+signals:
+	//! Emitted from the thread as the file is written. The percent goes from 0 to 100
+	void progressChanged(int percent);
+};
+
+#endif
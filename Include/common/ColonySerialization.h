@@ -0,0 +1,68 @@
+#ifndef COLONY_SERIALIZATION_H_
+#define COLONY_SERIALIZATION_H_
+
+#include <algorithm>
+#include <limits>
+
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/collections_save_imp.hpp>
+#include <boost/serialization/item_version_type.hpp>
+#include <boost/serialization/library_version_type.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_free.hpp>
+
+#include "Include/common/plfcolony.h"
+
+/**
+ * @file ColonySerialization.h
+ * @brief 	Serializes a plf::colony with boost directly from the colony. Without this, the colony has to be copied into a std::vector
+ * 			before the colony is saved and the vector has to be copied into the colony after the colony is loaded.
+ * 			The colony is written in exactly the same way as boost writes a std::vector of the same type. This means that an archive that
+ * 			was saved from a std::vector can be loaded into a colony and the other way around.
+ * 			When the colony is loaded, each element is emplaced into the colony first and then read from the archive in place.
+ */
+namespace boost
+{
+namespace serialization
+{
+	template<class Archive, class T, class Allocator, typename Skipfield>
+	void save(Archive &ar, const plf::colony<T, Allocator, Skipfield> &colony, const unsigned int /*version*/)
+	{
+		stl::save_collection<Archive, plf::colony<T, Allocator, Skipfield>>(ar, colony);
+	}
+
+	template<class Archive, class T, class Allocator, typename Skipfield>
+	void load(Archive &ar, plf::colony<T, Allocator, Skipfield> &colony, const unsigned int /*version*/)
+	{
+		const library_version_type libraryVersion(ar.get_library_version());
+		item_version_type itemVersion(0);
+		collection_size_type count;
+
+		ar >> BOOST_SERIALIZATION_NVP(count);
+
+		if(library_version_type(3) < libraryVersion)
+			ar >> BOOST_SERIALIZATION_NVP(itemVersion);
+
+		colony.clear();
+
+		// The colony can only reserve the size of its first group
+		if(count > 2)
+			colony.reserve((Skipfield)std::min<std::size_t>(count, std::numeric_limits<Skipfield>::max()));
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			typename plf::colony<T, Allocator, Skipfield>::iterator element = colony.emplace();
+
+			ar >> boost::serialization::make_nvp("item", *element);
+		}
+	}
+
+	template<class Archive, class T, class Allocator, typename Skipfield>
+	void serialize(Archive &ar, plf::colony<T, Allocator, Skipfield> &colony, const unsigned int version)
+	{
+		split_free(ar, colony, version);
+	}
+}
+}
+
+#endif
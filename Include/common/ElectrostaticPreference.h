@@ -74,7 +74,7 @@ private:
         ar & p_minAngle;
         std::string comments = p_comments.toStdString();
 		ar & comments;
-        p_comments = QString(comments);
+        p_comments = QString::fromStdString(comments);
         ar & p_probType;
         ar & p_unitLength;
 	}
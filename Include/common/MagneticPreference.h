@@ -89,7 +89,7 @@ private:
         ar & p_acSolver;
         std::string comments = p_comments.toStdString();
 		ar & comments;
-        p_comments = QString(comments);
+        p_comments = QString::fromStdString(comments);
 	}
     
 public:
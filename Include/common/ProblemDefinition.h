@@ -129,7 +129,7 @@ private:
         ar & p_localNodalList;
         std::string name = p_problemName.toStdString();
 		ar & name;
-        p_problemName = QString(name);
+        p_problemName = QString::fromStdString(name);
         if(p_phycisProblem == physicProblems::PROB_ELECTROSTATIC)
 		{
             ar & p_localElectricalPreference;
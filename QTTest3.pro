@@ -46,6 +46,7 @@ HEADERS += Include/common/BoundaryConditions.h \
            Include/common/OmniFEMMessage.h \
            Include/common/OS.h \
            Include/common/plfcolony.h \
+           Include/common/ColonySerialization.h \
            Include/common/ProblemDefinition.h \
            Include/common/Vector.h \
            Include/UI/MainWindow.h \
@@ -56,8 +57,25 @@ HEADERS += Include/common/BoundaryConditions.h \
            Include/UI/Geometry/geometryShapes.h \
            Include/UI/Geometry/glcanvas.h \
            Include/UI/Geometry/OGLFT.h \
+           Include/UI/Geometry/SpatialGrid.h \
+           Include/UI/Geometry/BoundingBox.h \
+           Include/UI/Geometry/AABBTree.h \
+           Include/UI/Geometry/IncidenceIndex.h \
+           Include/UI/Geometry/NodeHandle.h \
+           Include/UI/Geometry/ArcPolyline.h \
+           Include/UI/Geometry/NodeStore.h \
+           Include/UI/Geometry/GeometryRenderer.h \
+           Include/UI/Geometry/LabelTextRenderer.h \
+           Include/UI/Geometry/SceneRenderer.h \
+           Include/UI/Geometry/OffscreenRenderer.h \
+           Include/UI/BatchRender.h \
+           Include/UI/ProjectFile.h \
+           Include/UI/ProjectSaveThread.h \
            Include/UI/Geometry/GeometryDialog/ArcSegmentDialog.h
 SOURCES += src/Main.cpp \
+           src/BatchRender.cpp \
+           src/ProjectFile.cpp \
+           src/ProjectSaveThread.cpp \
            src/common/ComplexNumber.cpp \
            src/common/Vector.cpp \
            src/GeometryDialog/ArcSegmentDialog.cpp \
@@ -73,5 +91,9 @@ SOURCES += src/Main.cpp \
            src/MainFrame/propertiesmenu.cpp \
            src/MainFrame/viewmenu.cpp \
            src/MainFrame/Geometry/GeometryEditor2D.cpp \
+           src/MainFrame/Geometry/GeometryRenderer.cpp \
+           src/MainFrame/Geometry/LabelTextRenderer.cpp \
+           src/MainFrame/Geometry/SceneRenderer.cpp \
+           src/MainFrame/Geometry/OffscreenRenderer.cpp \
            src/MainFrame/Geometry/glcanvas.cpp
 RESOURCES += resources.qrc
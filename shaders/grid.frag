@@ -0,0 +1,42 @@
+#version 120
+
+// Draws the grid of the canvas. Everything is in pixels so that the grid does not lose precision when the camera is far from the origin.
+// The x component is for the vertical lines and the y component is for the horizontal lines.
+
+// The position of the first line that is at or before the left (bottom) side of the canvas
+uniform vec2 firstLine;
+
+// The index of the first line modulo 4. Every fourth line is a major line
+uniform vec2 firstLineIndex;
+
+// The distance between two lines
+uniform float stepPixels;
+
+uniform vec4 minorColor;
+uniform vec4 majorColor;
+
+void main()
+{
+    vec2 index = floor((gl_FragCoord.xy - firstLine) / stepPixels + 0.5);
+    vec2 offset = gl_FragCoord.xy - (firstLine + index * stepPixels);
+
+    if(min(abs(offset.x), abs(offset.y)) > 1.0)
+        discard;
+
+    // Same dashes as glLineStipple(1, 0b0001100011000110): the pixels 1, 2, 6, 7, 11 and 12 of every 16 pixels are drawn.
+    // The dashes of a vertical line run along y and the dashes of a horizontal line run along x
+    vec2 dash = mod(mod(floor(gl_FragCoord.yx), 16.0), 5.0);
+    vec2 isDrawn = step(vec2(0.5), dash) * step(dash, vec2(2.5));
+
+    // The major lines are 2 pixels wide and the minor lines are 1 pixel wide
+    vec2 isMajor = step(mod(index + firstLineIndex, 4.0), vec2(0.5));
+    vec2 onMajor = isMajor * isDrawn * step(vec2(-1.0), offset) * (1.0 - step(vec2(1.0), offset));
+    vec2 onMinor = (1.0 - isMajor) * isDrawn * step(vec2(-0.5), offset) * (1.0 - step(vec2(0.5), offset));
+
+    if(onMajor.x + onMajor.y > 0.0)
+        gl_FragColor = majorColor;
+    else if(onMinor.x + onMinor.y > 0.0)
+        gl_FragColor = minorColor;
+    else
+        discard;
+}
@@ -0,0 +1,7 @@
+#version 120
+
+// The grid is drawn as one square that covers the canvas. The square is given in model coordinates
+void main()
+{
+    gl_Position = ftransform();
+}
@@ -0,0 +1,284 @@
+#include "Include/UI/BatchRender.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <cstring>
+#include <vector>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QThread>
+
+#include "Include/UI/Geometry/OffscreenRenderer.h"
+#include "Include/UI/ProjectFile.h"
+
+
+
+/**
+ * @brief The input file and the image of one render
+ */
+struct batchRenderJob
+{
+	QString inputPath;
+
+	QString outputPath;
+};
+
+
+
+/**
+ * @brief The settings that are shared by every render
+ */
+struct batchRenderSettings
+{
+	//! The width of the images in pixels
+	int width = 1920;
+
+	//! The height of the images in pixels
+	int height = 1080;
+
+	//! Decides which parts of the grid and which names are drawn
+	gridPreferences preferences;
+
+	//! The physics problem. The names of the circuits are only drawn for magnetic problems
+	physicProblems problem = physicProblems::NO_PHYSICS_DEFINED;
+};
+
+
+
+/**
+ * @brief 	One of the threads of the batch render. The threads take the next job from the shared list until the list is empty.
+ * 			Each thread draws with its own renderer so that no OpenGL state is shared between the threads.
+ */
+class batchRenderThread : public QThread
+{
+private:
+	offscreenRenderer &p_renderer;
+
+	const std::vector<batchRenderJob> &p_jobs;
+
+	//! The position in the list of the next job that has not been taken by any of the threads
+	std::atomic<size_t> &p_nextJob;
+
+	//! The number of jobs that could not be rendered
+	std::atomic<int> &p_failedJobs;
+
+	batchRenderSettings p_settings;
+
+	/**
+	 * @brief Loads the geometry of one job, renders the geometry and saves the image
+	 * @param job The job
+	 * @return Returns true if the image was saved. Otherwise, returns false
+	 */
+	bool renderJob(const batchRenderJob &job)
+	{
+		geometryEditor2D editor;
+		physicProblems problem = p_settings.problem;
+
+		if(projectFile::isProjectFile(job.inputPath.toStdString()))
+		{
+			problemDefinition definition;
+
+			if(!projectFile::load(job.inputPath.toStdString(), definition, editor))
+				return false;
+
+			if(problem == physicProblems::NO_PHYSICS_DEFINED)
+				problem = definition.getPhysicsProblem();
+		}
+		else
+		{
+			/* Files from before the project file are a geometryEditor2D in a boost text archive */
+			try
+			{
+				std::ifstream inputFile(job.inputPath.toStdString());
+
+				if(!inputFile)
+					return false;
+
+				boost::archive::text_iarchive archive(inputFile);
+				archive >> editor;
+			}
+			catch(const std::exception &error)
+			{
+				qWarning() << job.inputPath << ":" << error.what();
+				return false;
+			}
+		}
+
+		sceneCamera camera;
+		boundingBox modelBox;
+
+		camera.width = p_settings.width;
+		camera.height = p_settings.height;
+
+		if(editor.getModelBoundingBox(modelBox))
+			camera.zoomToFit(modelBox);
+
+		QImage image;
+
+		if(!p_renderer.render(editor, p_settings.preferences, problem, camera, image))
+			return false;
+
+		return image.save(job.outputPath, "PNG");
+	}
+
+protected:
+	void run() override
+	{
+		for(size_t jobIndex = p_nextJob++; jobIndex < p_jobs.size(); jobIndex = p_nextJob++)
+		{
+			if(renderJob(p_jobs[jobIndex]))
+				qInfo() << "Rendered" << p_jobs[jobIndex].outputPath;
+			else
+			{
+				qWarning() << "Failed to render" << p_jobs[jobIndex].inputPath;
+				p_failedJobs++;
+			}
+		}
+
+		p_renderer.release();
+	}
+
+public:
+	batchRenderThread(offscreenRenderer &renderer, const std::vector<batchRenderJob> &jobs, std::atomic<size_t> &nextJob, std::atomic<int> &failedJobs,
+					  const batchRenderSettings &settings) : p_renderer(renderer), p_jobs(jobs), p_nextJob(nextJob), p_failedJobs(failedJobs), p_settings(settings)
+	{
+
+	}
+};
+
+
+
+bool isBatchRenderRequested(int argc, char *argv[])
+{
+	for(int i = 1; i < argc; i++)
+	{
+		if(std::strcmp(argv[i], "--render") == 0)
+			return true;
+	}
+
+	return false;
+}
+
+
+
+int runBatchRender(QGuiApplication &application)
+{
+	QCommandLineParser parser;
+
+	parser.setApplicationDescription("Renders geometry files to PNG images without opening the editor. "
+									 "On machines without a display server, select a platform that does not need one with -platform (such as offscreen or eglfs).");
+	parser.addHelpOption();
+
+	QCommandLineOption renderOption("render", "Render the files instead of starting the editor.");
+	QCommandLineOption outputOption(QStringList() << "o" << "output", "The folder that the images are saved in. The image of a file has the name of the file with the extension png.", "folder", ".");
+	QCommandLineOption widthOption("width", "The width of the images in pixels.", "pixels", "1920");
+	QCommandLineOption heightOption("height", "The height of the images in pixels.", "pixels", "1080");
+	QCommandLineOption threadOption(QStringList() << "j" << "threads", "The number of images that are rendered at the same time.", "count", QString::number(QThread::idealThreadCount()));
+	QCommandLineOption noGridOption("no-grid", "Do not draw the grid, the axis or the origin.");
+	QCommandLineOption noNamesOption("no-names", "Do not draw the names of the block labels.");
+	QCommandLineOption magneticsOption("magnetics", "Draw the names of the circuits along with the names of the block labels.");
+
+	parser.addOption(renderOption);
+	parser.addOption(outputOption);
+	parser.addOption(widthOption);
+	parser.addOption(heightOption);
+	parser.addOption(threadOption);
+	parser.addOption(noGridOption);
+	parser.addOption(noNamesOption);
+	parser.addOption(magneticsOption);
+	parser.addPositionalArgument("files", "The project files or geometry files to render.", "files...");
+
+	parser.process(application);
+
+	batchRenderSettings settings;
+	bool widthIsValid = false;
+	bool heightIsValid = false;
+	bool threadCountIsValid = false;
+
+	settings.width = parser.value(widthOption).toInt(&widthIsValid);
+	settings.height = parser.value(heightOption).toInt(&heightIsValid);
+	int threadCount = parser.value(threadOption).toInt(&threadCountIsValid);
+
+	if(!widthIsValid || !heightIsValid || settings.width <= 0 || settings.height <= 0)
+	{
+		qWarning() << "The width and the height need to be larger then 0";
+		return 1;
+	}
+
+	if(!threadCountIsValid || threadCount <= 0)
+		threadCount = 1;
+
+	if(parser.isSet(noGridOption))
+	{
+		settings.preferences.setShowGridState(false);
+		settings.preferences.setShowAxisState(false);
+		settings.preferences.setShowOriginState(false);
+	}
+
+	settings.preferences.setShowBlockNameState(!parser.isSet(noNamesOption));
+
+	if(parser.isSet(magneticsOption))
+		settings.problem = physicProblems::PROB_MAGNETICS;
+
+	QDir outputFolder(parser.value(outputOption));
+
+	if(!outputFolder.mkpath("."))
+	{
+		qWarning() << "Could not create the folder" << outputFolder.path();
+		return 1;
+	}
+
+	std::vector<batchRenderJob> jobs;
+
+	for(const QString &inputPath : parser.positionalArguments())
+	{
+		batchRenderJob job;
+
+		job.inputPath = inputPath;
+		job.outputPath = outputFolder.filePath(QFileInfo(inputPath).completeBaseName() + ".png");
+
+		jobs.push_back(job);
+	}
+
+	if(jobs.empty())
+		parser.showHelp(1);
+
+	threadCount = std::min(threadCount, (int)jobs.size());
+
+	/* The surfaces and the contexts are created here since this is the GUI thread. Each context is then handed to its thread */
+	std::vector<offscreenRenderer> renderers(threadCount);
+	std::vector<batchRenderThread*> threads;
+	std::atomic<size_t> nextJob(0);
+	std::atomic<int> failedJobs(0);
+
+	for(offscreenRenderer &renderer : renderers)
+	{
+		if(!renderer.create())
+		{
+			qWarning() << "Could not create an OpenGL context";
+			break;
+		}
+
+		batchRenderThread *thread = new batchRenderThread(renderer, jobs, nextJob, failedJobs, settings);
+
+		renderer.moveToThread(thread);
+		threads.push_back(thread);
+	}
+
+	if(threads.empty())
+		return 1;
+
+	for(batchRenderThread *thread : threads)
+		thread->start();
+
+	for(batchRenderThread *thread : threads)
+	{
+		thread->wait();
+		delete thread;
+	}
+
+	return (failedJobs > 0) ? 1 : 0;
+}
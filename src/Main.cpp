@@ -1,9 +1,18 @@
 #include "Include/UI/MainWindow.h"
+#include "Include/UI/BatchRender.h"
 #include <QApplication>
 
 
 int main(int argc, char *argv[])
 {
+    if(isBatchRenderRequested(argc, argv))
+    {
+        // The images are rendered without any windows so the widgets are not needed
+        QGuiApplication application(argc, argv);
+
+        return runBatchRender(application);
+    }
+
     QApplication a(argc, argv);
     MainWindow w;
     w.show();
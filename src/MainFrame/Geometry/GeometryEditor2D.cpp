@@ -1,5 +1,8 @@
 #include "Include/UI/Geometry/GeometryEditor2D.h"
 #include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 
 
 bool geometryEditor2D::addNode(double xPoint, double yPoint, double distanceNode)// Could distance be the 1/mag which is the zoom factor
@@ -8,45 +11,43 @@ bool geometryEditor2D::addNode(double xPoint, double yPoint, double distanceNode
 	node newNode;
     
     /* This section will make sure that two nodes are not drawn on top of each other */
-	for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+	if(p_nodeGrid.findWithin(xPoint, yPoint, distanceNode))// This will compare against 1/mag where mag is the scaling function for zooming. However, it is currently being hardcoded to 0.01
 	{
-		if(nodeIterator->getDistance(xPoint, yPoint) < distanceNode)// This will compare against 1/mag where mag is the scaling function for zooming. However, it is currently being hardcoded to 0.01
-        {
-            /*
-             * Bug Fix:
-             * There is a case where if the user tries to select a node after a node failed to be placed, the program would crash
-             * That is because the function, addDragNode, would insert a node into the colony for dragging. The iterator of the added node would then be saved
-             * to the last node added variable.
-             * However, on the up button release, the program would try to earse this node at the iterator.
-             * But, if the node failed to be created, then the iterator is now pointing to nothing.
-             * SO, when the program first checks to see if the node is in dragging mode (since it is pointing to a 
-             * random block of data, it is anyone's guess as to what the value is. Most of the time, the boolean is true)
-             * The program then attempts to erase the node but this crashs the program since the iterator is pointing to some random data.
-             * The fix is that when the node fails to be created, set the last node added variable equal to the beginning list
-             */
-            _lastNodeAdded = _nodeList.begin();
-            return false;
-        }
-	
+		/*
+		 * Bug Fix:
+		 * There is a case where if the user tries to select a node after a node failed to be placed, the program would crash
+		 * That is because the function, addDragNode, would insert a node into the colony for dragging. The iterator of the added node would then be saved
+		 * to the last node added variable.
+		 * However, on the up button release, the program would try to earse this node at the iterator.
+		 * But, if the node failed to be created, then the iterator is now pointing to nothing.
+		 * SO, when the program first checks to see if the node is in dragging mode (since it is pointing to a 
+		 * random block of data, it is anyone's guess as to what the value is. Most of the time, the boolean is true)
+		 * The program then attempts to erase the node but this crashs the program since the iterator is pointing to some random data.
+		 * The fix is that when the node fails to be created, set the last node added variable equal to the beginning list
+		 */
+		_lastNodeAdded = _nodeList.begin();
+		return false;
 	}
     
     /* This section will make sure that a node is not drawn on top of a block label */
-	for(plf::colony<blockLabel>::iterator blockIterator = _blockLabelList.begin(); blockIterator != _blockLabelList.end(); ++blockIterator)
+	if(p_blockLabelGrid.findWithin(xPoint, yPoint, distanceNode))
 	{
-		if(blockIterator->getDistance(xPoint, yPoint) < distanceNode)
-		{
-            _lastNodeAdded = _nodeList.begin();
-            return false;
-        }
+		_lastNodeAdded = _nodeList.begin();
+		return false;
 	}
     
     newNode.setCenter(xPoint, yPoint);
 	newNode.setNodeID(++_nodeNumber);
-	_lastNodeAdded = _nodeList.insert(newNode);
+	_lastNodeAdded = insertNode(newNode);
+    
+    /* Only the segments whose bounding box is within the distance of the node could possibly be broken by the node */
+    boundingBox nodeRegion = boundingBox(xPoint, yPoint, xPoint, yPoint).inflated(distanceNode);
+    std::vector<plf::colony<edgeLineShape>::iterator> nearbyLines = getLinesInRegion(nodeRegion);
     
     /* If the node is in between a line, then break the line into 2 lines */
-	for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+	for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator nearbyIterator = nearbyLines.begin(); nearbyIterator != nearbyLines.end(); ++nearbyIterator)
 	{
+		plf::colony<edgeLineShape>::iterator lineIterator = *nearbyIterator;
 		if((fabs(calculateShortestDistance(newNode, *lineIterator)) < distanceNode) && (newNode != *lineIterator->getFirstNode() && newNode != *lineIterator->getSecondNode()))
 		{
             /* If the node is on the line (determined by the calculateShortestDistance function) a new line will be created (This will be called line 1)
@@ -58,17 +59,21 @@ bool geometryEditor2D::addNode(double xPoint, double yPoint, double distanceNode
             edgeLineShape edgeLine = *lineIterator;
             lineIterator->setSecondNode(*_lastNodeAdded);// This will set the recently created node to be the second node of the shortend line
 			lineIterator->calculateDistance();
+			updateLine(*lineIterator);
 			
             edgeLine.setFirstNode(*_lastNodeAdded);// This will set the recently created node to be the first node of the new line
 			edgeLine.calculateDistance();
-			_lastLineAdded = _lineList.insert(edgeLine);// Add the new line to the array
+			_lastLineAdded = insertLine(edgeLine);// Add the new line to the array
             continue;
 		}
 	} 
     
+    std::vector<plf::colony<arcShape>::iterator> nearbyArcs = getArcsInRegion(nodeRegion);
+    
     /* If the node is in between an arc, then break the arc into 2 */
-	for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+	for(std::vector<plf::colony<arcShape>::iterator>::iterator nearbyIterator = nearbyArcs.begin(); nearbyIterator != nearbyArcs.end(); ++nearbyIterator)
 	{
+        plf::colony<arcShape>::iterator arcIterator = *nearbyIterator;
         Vector nodeVector;
         nodeVector.Set(xPoint, yPoint);
         /* Pretty much, this portion of the code is doing the exact same thing as the code above but instead of straight lines, we are working with arcs */
@@ -90,6 +95,7 @@ bool geometryEditor2D::addNode(double xPoint, double yPoint, double distanceNode
             double angle = Varg((thirdNode - center) / (firstNode - center)) * (180.0 / PI);
 			arcIterator->setArcAngle(angle);
             arcIterator->calculate();
+            updateArc(*arcIterator);
 			
             arcSegment.setFirstNode(*_lastNodeAdded);
             angle = Varg((secondNode - center) / (thirdNode - center)) * (180.0 / PI);
@@ -98,7 +104,7 @@ bool geometryEditor2D::addNode(double xPoint, double yPoint, double distanceNode
 			arcSegment.calculate();
 			arcSegment.setArcID(++p_arcNumber);
             
-            _lastArcAdded = _arcList.insert(arcSegment);
+            _lastArcAdded = insertArc(arcSegment);
             break;
 		}
 	}
@@ -115,25 +121,19 @@ bool geometryEditor2D::addBlockLabel(double xPoint, double yPoint, double tolera
     Vector blockVector = Vector(xPoint, yPoint);
     
     // Make sure that teh block labe is not placed ontop of an existing block label
-    for(plf::colony<blockLabel>::iterator blockIterator = _blockLabelList.begin(); blockIterator != _blockLabelList.end(); ++blockIterator)
+    if(p_blockLabelGrid.findWithin(xPoint, yPoint, tolerance))
     {
-        if(blockIterator->getDistance(xPoint, yPoint) < tolerance)
-        {
-            _lastBlockLabelAdded = _blockLabelList.begin();
-            return false;
-        } 
+        _lastBlockLabelAdded = _blockLabelList.begin();
+        return false;
     }
     
     // MAke sure that the block label is not placed on top of an existing node
-    for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
-	{
-        // The program FEMM would start the zoom factor at 100. We are starting at 1. The process by which FEMM creates the nodes is very good. Therefor, we multiply our results by 100
-		if(nodeIterator->getDistance(xPoint, yPoint) < tolerance)// This will compare against 1/mag where mag is the scaling function for zooming. However, it is currently being hardcoded to 0.01
-		{
-            _lastBlockLabelAdded = _blockLabelList.begin();
-            return false;
-        } 
-	}
+    // The program FEMM would start the zoom factor at 100. We are starting at 1. The process by which FEMM creates the nodes is very good. Therefor, we multiply our results by 100
+    if(p_nodeGrid.findWithin(xPoint, yPoint, tolerance))
+    {
+        _lastBlockLabelAdded = _blockLabelList.begin();
+        return false;
+    }
     
     // Make sure that the block label is not placed ontop of a line
     for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
@@ -161,6 +161,9 @@ bool geometryEditor2D::addBlockLabel(double xPoint, double yPoint, double tolera
     newLabel.setCenterYCoordiante(yPoint);
    
     _lastBlockLabelAdded = _blockLabelList.insert(newLabel);
+    p_blockLabelGrid.insert(&(*_lastBlockLabelAdded));
+    p_geometryRevision++;
+    p_blockLabelRevision++;
 
     return true;
 }
@@ -199,61 +202,45 @@ bool geometryEditor2D::addLine(node *firstNode, node *secondNode, double toleran
 	    }
 
 
-	/* Check to see if the line has already been created */
-
-		for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
-		{
-			if((*lineIterator->getFirstNode() == *tempNodeOne && *lineIterator->getSecondNode() == *tempNodeTwo) || (*lineIterator->getFirstNode() == *tempNodeTwo && *lineIterator->getSecondNode() == *tempNodeOne))
-	        {
-	            resetIndexs();
-	            return false;
-	        }
-		}
+	/* Check to see if the line has already been created. The existing line could have been drawn in either direction */
+		if(!p_lineIncidence.getSegments(tempNodeOne, tempNodeTwo).empty() || !p_lineIncidence.getSegments(tempNodeTwo, tempNodeOne).empty())
+	    {
+	        resetIndexs();
+	        return false;
+	    }
 
 	    newLine.setFirstNode(*tempNodeOne);
 	    newLine.setSecondNode(*tempNodeTwo);
 
 	    if(tolerance == 0)
 	    {
-	        if(_nodeList.size() < 2)
+	        boundingBox modelBox;
+
+	        if(_nodeList.size() < 2 || !getModelBoundingBox(modelBox))
 	            tempTolerance = 1.0e-08;
 	        else
-	        {
-	            Vector tempVecOne, tempVecTwo;
-	            tempVecOne.Set(_nodeList.begin()->getCenterXCoordinate(), _nodeList.begin()->getCenterYCoordinate());
-	            tempVecTwo = tempVecOne;
-	            for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
-	            {
-	                if(nodeIterator->getCenterXCoordinate() < tempVecOne.getXComponent())
-	                    tempVecOne.Set(nodeIterator->getCenterXCoordinate(), tempVecOne.getYComponent());
-
-	                if(nodeIterator->getCenterXCoordinate() > tempVecTwo.getXComponent())
-	                    tempVecTwo.Set(nodeIterator->getCenterXCoordinate(), tempVecTwo.getYComponent());
-
-	                if(nodeIterator->getCenterYCoordinate() < tempVecOne.getYComponent())
-	                    tempVecOne.Set(tempVecOne.getXComponent(), nodeIterator->getCenterYCoordinate());
-
-	                if(nodeIterator->getCenterYCoordinate() > tempVecTwo.getYComponent())
-	                    tempVecTwo.Set(tempVecTwo.getXComponent(), nodeIterator->getCenterYCoordinate());
-	            }
-
-	            tempTolerance = Vabs(tempVecTwo - tempVecOne) * 1.0e-06;
-	        }
+	            tempTolerance = modelBox.getDiagonal() * 1.0e-06;
 	    }
 	    else
 	        tempTolerance = tolerance;
 
+	    /* Only the segments whose bounding box overlaps the bounding box of the new line could possibly intersect the new line */
+	    std::vector<plf::colony<edgeLineShape>::iterator> intersectingLines = getLinesInRegion(newLine.getBoundingBox());
+	    std::vector<plf::colony<arcShape>::iterator> intersectingArcs = getArcsInRegion(newLine.getBoundingBox());
+
 	    /* This section will check to see if there are any intersections with other segments. If so, create a node at the intersection */
-	    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+	    for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator intersectingIterator = intersectingLines.begin(); intersectingIterator != intersectingLines.end(); ++intersectingIterator)
 	    {
+	        plf::colony<edgeLineShape>::iterator lineIterator = *intersectingIterator;
 	        double tempX, tempY;
 	        if(getIntersection(newLine, *lineIterator, tempX, tempY) && !lineIterator->getSegmentProperty()->getHiddenState())
 	            addNode(tempX, tempY, tempTolerance);
 	    }
 
 	    /* This section will check to see if there are any intersections with arcs. If so, create a node at the intersection */
-	    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+	    for(std::vector<plf::colony<arcShape>::iterator>::iterator intersectingIterator = intersectingArcs.begin(); intersectingIterator != intersectingArcs.end(); ++intersectingIterator)
 	    {
+	        plf::colony<arcShape>::iterator arcIterator = *intersectingIterator;
 	        Vector newNodesPoints[2];
 	        int j = getLineToArcIntersection(newLine, *arcIterator, newNodesPoints);
 	        if(j > 0 && !arcIterator->getSegmentProperty()->getHiddenState())
@@ -271,7 +258,7 @@ bool geometryEditor2D::addLine(node *firstNode, node *secondNode, double toleran
 	     * with the tolerance value as the tolerance between points. That can be done here.
 	     */
 		newLine.calculateDistance(); // Calculates the distance of the line
-	    _lastLineAdded = _lineList.insert(newLine);// Add the line to the list
+	    _lastLineAdded = insertLine(newLine);// Add the line to the list
 
 	    double shortDistance, dmin;
 	    Vector node0Vec, node1Vec, nodeiVec;
@@ -286,8 +273,11 @@ bool geometryEditor2D::addLine(node *firstNode, node *secondNode, double toleran
 	    else
 	        dmin = tolerance;
 
-	    for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+	    /* Only the nodes within dmin of the bounding box of the line could possibly lie on the line */
+	    std::vector<plf::colony<node>::iterator> nearbyNodes = getNodesInRegion(newLine.getBoundingBox().inflated(dmin));
+	    for(std::vector<plf::colony<node>::iterator>::iterator nearbyIterator = nearbyNodes.begin(); nearbyIterator != nearbyNodes.end(); ++nearbyIterator)
 	    {
+	        plf::colony<node>::iterator nodeIterator = *nearbyIterator;
 	        if((*nodeIterator != *tempNodeOne) && (*nodeIterator != *tempNodeTwo))
 	        {
 	            nodeiVec.Set(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
@@ -296,7 +286,7 @@ bool geometryEditor2D::addLine(node *firstNode, node *secondNode, double toleran
 	                shortDistance = 2.0 * dmin;
 	            if(shortDistance < dmin)// This is the case for if the node is in fact ontop of a line
 	            {
-	                _lineList.erase(_lastLineAdded);
+	                eraseLine(_lastLineAdded);
 	                _lastLineAdded = _lineList.begin();// Make sure that the last line added in always pointing to something
 	                addLine(tempNodeOne, &(*nodeIterator), dmin);
 	                addLine(&(*nodeIterator), tempNodeTwo, dmin);
@@ -348,9 +338,11 @@ bool geometryEditor2D::addArc(arcShape &arcSeg, double tolerance, bool nodesAreS
         arcSeg.calculate();
     }
 		
-	for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+	/* Check to see if the arc has already been created. Since the direction of an arc matters, only the arcs going from the first node to the second node are checked */
+	std::vector<arcShape*> duplicateArcs = p_arcIncidence.getSegments(arcSeg.getFirstNode(), arcSeg.getSecondNode());
+	for(std::vector<arcShape*>::iterator arcIterator = duplicateArcs.begin(); arcIterator != duplicateArcs.end(); ++arcIterator)
 	{
-		if((arcIterator->getFirstNode() == arcSeg.getFirstNode()) && (arcIterator->getSecondNode() == arcSeg.getSecondNode()) && (fabs(arcIterator->getArcAngle() - arcSeg.getArcAngle()) < 1.0e-02))
+		if(fabs((*arcIterator)->getArcAngle() - arcSeg.getArcAngle()) < 1.0e-02)
         {
             resetIndexs();
             return false;
@@ -359,37 +351,24 @@ bool geometryEditor2D::addArc(arcShape &arcSeg, double tolerance, bool nodesAreS
 	
 	if(tolerance == 0)
 	{
-		if(_nodeList.size() < 2)
+		boundingBox modelBox;
+		
+		if(_nodeList.size() < 2 || !getModelBoundingBox(modelBox))
 			distanceTolerance = 1.0e-08;
 		else
-		{
-            Vector vec1, vec2;
-			vec1.Set(_nodeList.begin()->getCenterXCoordinate(), _nodeList.begin()->getCenterYCoordinate());
-			vec2 = vec1;
-			for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
-			{
-				if(nodeIterator->getCenterXCoordinate() < vec1.getXComponent())
-					vec1.Set(nodeIterator->getCenterXCoordinate(), vec1.getYComponent());
-				
-				if(nodeIterator->getCenterXCoordinate() > vec2.getXComponent())
-					vec2.Set(nodeIterator->getCenterXCoordinate(), vec2.getYComponent());
-				
-				if(nodeIterator->getCenterYCoordinate() < vec1.getYComponent())
-					vec1.Set(vec1.getXComponent(), nodeIterator->getCenterYCoordinate());
-					
-				if(nodeIterator->getCenterYCoordinate() > vec2.getYComponent())
-					vec2.Set(vec2.getXComponent(), nodeIterator->getCenterYCoordinate());
-			}
-			
-			distanceTolerance = Vabs(vec1 - vec2) * 1.0e-06;
-		}
+			distanceTolerance = modelBox.getDiagonal() * 1.0e-06;
 	}
 	else
 		distanceTolerance = tolerance;
 	
+	/* Only the segments whose bounding box overlaps the bounding box of the new arc could possibly intersect the new arc */
+	std::vector<plf::colony<edgeLineShape>::iterator> intersectingLines = getLinesInRegion(arcSeg.getBoundingBox());
+	std::vector<plf::colony<arcShape>::iterator> intersectingArcs = getArcsInRegion(arcSeg.getBoundingBox());
+	
 	/* This section will check for any intesections with lines and arcs and if so, place a node there */
-	for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)// This will check how many times the existing arc intercests the proposed arc.
+	for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator intersectingIterator = intersectingLines.begin(); intersectingIterator != intersectingLines.end(); ++intersectingIterator)// This will check how many times the existing arc intercests the proposed arc.
 	{
+		plf::colony<edgeLineShape>::iterator lineIterator = *intersectingIterator;
 		int j = getLineToArcIntersection(*lineIterator, arcSeg, intersectingNodes); // Place the function for intersecting here This will be for an arc intersecting a line
 		
 		if(j > 0 && !lineIterator->getSegmentProperty()->getHiddenState())
@@ -402,8 +381,9 @@ bool geometryEditor2D::addArc(arcShape &arcSeg, double tolerance, bool nodesAreS
 	}
 	
 	/* This section is for the proposed arc intersecting another arc */
-	for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+	for(std::vector<plf::colony<arcShape>::iterator>::iterator intersectingIterator = intersectingArcs.begin(); intersectingIterator != intersectingArcs.end(); ++intersectingIterator)
 	{
+		plf::colony<arcShape>::iterator arcIterator = *intersectingIterator;
         // THis finds the number of points where intercetion occurs.
         // The point values are stored in the variable intersectiongNodes.
 		int j = getArcToArcIntersection(*arcIterator, arcSeg,  intersectingNodes); // This will be for an arc intersecting an arc
@@ -418,7 +398,7 @@ bool geometryEditor2D::addArc(arcShape &arcSeg, double tolerance, bool nodesAreS
 	}
 	
 	arcSeg.setArcID(++p_arcNumber);
-	_lastArcAdded = _arcList.insert(arcSeg);
+	_lastArcAdded = insertArc(arcSeg);
 	
     centerPoint.Set(arcSeg.getCenterXCoordinate(), arcSeg.getCenterYCoordinate());
     radius = arcSeg.getRadius();
@@ -428,8 +408,11 @@ bool geometryEditor2D::addArc(arcShape &arcSeg, double tolerance, bool nodesAreS
 	else
 		minDistance = tolerance;
 	
-	for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+	/* Only the nodes within the minimum distance of the bounding box of the arc could possibly lie on the arc */
+	std::vector<plf::colony<node>::iterator> nearbyNodes = getNodesInRegion(arcSeg.getBoundingBox().inflated(minDistance));
+	for(std::vector<plf::colony<node>::iterator>::iterator nearbyIterator = nearbyNodes.begin(); nearbyIterator != nearbyNodes.end(); ++nearbyIterator)
 	{
+		plf::colony<node>::iterator nodeIterator = *nearbyIterator;
 		if((*nodeIterator != *arcSeg.getFirstNode()) && (*nodeIterator != *arcSeg.getSecondNode()))
 		{
             shortDistanceFromArc = shortestDistanceFromArc(Vector(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate()), *_lastArcAdded);
@@ -440,7 +423,7 @@ bool geometryEditor2D::addArc(arcShape &arcSeg, double tolerance, bool nodesAreS
 				vec2.Set(arcSeg.getSecondNode()->getCenterXCoordinate(), arcSeg.getSecondNode()->getCenterYCoordinate());
 				vec3.Set(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
 				
-				_arcList.erase(_lastArcAdded);
+				eraseArc(_lastArcAdded);
 				
 				newArc = arcSeg;
 				
@@ -467,7 +450,11 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
 {
     bool labelsViolated = false;
     
-    if(editedGeometry == EditGeometry::EDIT_NODES || editedGeometry == EditGeometry::EDIT_ALL)
+    // When everything was edited, all of the intersections are found in one pass instead of checking each item against the entire list
+    if(editedGeometry == EditGeometry::EDIT_ALL)
+        resolveIntersections(tolerance);
+    
+    if(editedGeometry == EditGeometry::EDIT_NODES)
     {
         for(plf::colony<node>::iterator nodeIterator1 = _nodeList.begin(); nodeIterator1 != _nodeList.end(); ++nodeIterator1)
         {
@@ -484,26 +471,39 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                      */ 
                 if(*nodeIterator1 == *nodeIterator2)
                 {
-                    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+                    std::vector<plf::colony<edgeLineShape>::iterator> connectedLines = getLinesAtNode(*nodeIterator2);
+                    for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
                     {
-                        if(*lineIterator->getFirstNode() == *nodeIterator2)
-                            lineIterator->setFirstNode(*nodeIterator1);
-                        else if(*lineIterator->getSecondNode() == *nodeIterator2)
-                            lineIterator->setSecondNode(*nodeIterator1);
+                        if((*lineIterator)->getFirstNode() == &(*nodeIterator2))
+                            (*lineIterator)->setFirstNode(*nodeIterator1);
+                        else
+                            (*lineIterator)->setSecondNode(*nodeIterator1);
+                            
+                        // A line between the two nodes now starts and ends on the same node
+                        if((*lineIterator)->getFirstNode() == (*lineIterator)->getSecondNode())
+                            eraseLine(*lineIterator);
+                        else
+                            updateLine(**lineIterator);
                     }
                     
-                    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+                    std::vector<plf::colony<arcShape>::iterator> connectedArcs = getArcsAtNode(*nodeIterator2);
+                    for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
                     {
-                        if(*arcIterator->getFirstNode() == *nodeIterator2)
-                            arcIterator->setFirstNode(*nodeIterator1);
-                        else if(*arcIterator->getSecondNode() == *nodeIterator2)
-                            arcIterator->setSecondNode(*nodeIterator1);
+                        if((*arcIterator)->getFirstNode() == &(*nodeIterator2))
+                            (*arcIterator)->setFirstNode(*nodeIterator1);
+                        else
+                            (*arcIterator)->setSecondNode(*nodeIterator1);
+                            
+                        if((*arcIterator)->getFirstNode() == (*arcIterator)->getSecondNode())
+                            eraseArc(*arcIterator);
+                        else
+                            updateArc(**arcIterator);
                     }
                     
                     if(*_lastNodeAdded == *nodeIterator2)
                         _lastNodeAdded = _nodeList.begin();
                         
-                    _nodeList.erase(nodeIterator2);
+                    eraseNode(nodeIterator2);
                     nodeIsConfigured = true;// A node being ontop of another node will only happen once and it will not be ontop of a line or an arc
                     break;
                 }
@@ -524,9 +524,10 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                          */ 
                         edgeLineShape edgeLine = *lineIterator;
                         lineIterator->setSecondNode(*nodeIterator1);
+                        updateLine(*lineIterator);
                         
                         edgeLine.setFirstNode(*nodeIterator1);
-                        _lastLineAdded = _lineList.insert(edgeLine);// Add the new line to the array
+                        _lastLineAdded = insertLine(edgeLine);// Add the new line to the array
                         nodeIsConfigured = true;
                         break;
                     }
@@ -557,6 +558,7 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                         double angle = Varg((thirdNode - center) / (firstNode - center)) * (180.0 / PI);
                         arcIterator->setArcAngle(angle);
                         arcIterator->calculate();
+                        updateArc(*arcIterator);
                         
                         arcSegment.setFirstNode(*nodeIterator1);
                         angle = Varg((secondNode - center) / (thirdNode - center)) * (180.0 / PI);
@@ -564,7 +566,7 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                         arcSegment.setNumSegments(20);
                         arcSegment.calculate();
                         
-                        _lastArcAdded = _arcList.insert(arcSegment);
+                        _lastArcAdded = insertArc(arcSegment);
                         break;
                     }
                 }
@@ -572,7 +574,7 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
         }
     }
     
-    if(editedGeometry == EditGeometry::EDIT_LINES || editedGeometry == EditGeometry::EDIT_ALL)
+    if(editedGeometry == EditGeometry::EDIT_LINES)
     {
         for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
         {
@@ -598,9 +600,10 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                          */ 
                         edgeLineShape edgeLine = *lineIterator;
                         lineIterator->setSecondNode(*nodeIterator);
+                        updateLine(*lineIterator);
                         
                         edgeLine.setFirstNode(*nodeIterator);
-                        _lastLineAdded = _lineList.insert(edgeLine);// Add the new line to the array
+                        _lastLineAdded = insertLine(edgeLine);// Add the new line to the array
                     }
                 }
             }
@@ -622,6 +625,8 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                             lineIterator3->setFirstNode(*lineIterator->getFirstNode());
                         else if(*lineIterator3->getFirstNode() == *lineIterator->getSecondNode())
                             lineIterator3->setSecondNode(*lineIterator->getSecondNode());
+                            
+                        updateLine(*lineIterator3);
                     }
                     
                     for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
@@ -630,18 +635,20 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                             arcIterator->setFirstNode(*lineIterator->getFirstNode());
                         else if(*arcIterator->getFirstNode() == *lineIterator->getSecondNode())
                             arcIterator->setSecondNode(*lineIterator->getSecondNode());
+                            
+                        updateArc(*arcIterator);
                     }
                     
                     // As the last item, we need to delete the two nodes and the line from the list
                     for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end();)
                     {
                         if(*nodeIterator == *lineIterator2->getFirstNode() || *nodeIterator == *lineIterator2->getSecondNode())
-                            _nodeList.erase(nodeIterator++);
+                            nodeIterator = eraseNode(nodeIterator);
                         else
                              nodeIterator++;   
                     }
                     
-                    _lineList.erase(lineIterator2++);
+                    lineIterator2 = eraseLine(lineIterator2);
                 }    
                 else if(getIntersection(*lineIterator2, *lineIterator, tempX, tempY) && !lineIterator2->getSegmentProperty()->getHiddenState())
                 {
@@ -668,7 +675,7 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
         }
     }
     
-    if(editedGeometry == EditGeometry::EDIT_ARCS || editedGeometry == EditGeometry::EDIT_ALL)
+    if(editedGeometry == EditGeometry::EDIT_ARCS)
     {
         for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
         {
@@ -699,6 +706,7 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                         double angle = Varg((thirdNode - center) / (firstNode - center)) * (180.0 / PI);
                         arcIterator->setArcAngle(angle);
                         arcIterator->calculate();
+                        updateArc(*arcIterator);
                         
                         arcSegment.setFirstNode(*nodeIterator);
                         angle = Varg((secondNode - center) / (thirdNode - center)) * (180.0 / PI);
@@ -706,7 +714,7 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
                         arcSegment.setNumSegments(20);
                         arcSegment.calculate();
                         
-                        _lastArcAdded = _arcList.insert(arcSegment);
+                        _lastArcAdded = insertArc(arcSegment);
                         break;
                     }
                 }
@@ -747,55 +755,667 @@ bool geometryEditor2D::checkIntersections(EditGeometry editedGeometry, double to
         
         for(plf::colony<blockLabel>::iterator blockIterator = _blockLabelList.begin(); blockIterator != _blockLabelList.end(); ++blockIterator)
         {
-            for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+            Vector blockLabelVector = Vector(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate());
+            boundingBox labelRegion = boundingBox(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate(), blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate()).inflated(tolerance);
+            
+            // Only the segments whose bounding box is within the tolerance of the label could be ontop of the label
+            std::vector<plf::colony<arcShape>::iterator> nearbyArcs = getArcsInRegion(labelRegion);
+            for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = nearbyArcs.begin(); arcIterator != nearbyArcs.end(); ++arcIterator)
             {
-                Vector blockLabelVector = Vector(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate());
-                if(shortestDistanceFromArc(blockLabelVector, *arcIterator) < tolerance)
+                if(shortestDistanceFromArc(blockLabelVector, *(*arcIterator)) < tolerance)
                 {
                     labelsViolated = true;
-                    blockIterator->setSelectState(true);// Flag the block label if it violates tolerances so that the user can deal with it.
+                    setSelectState(*blockIterator, true);// Flag the block label if it violates tolerances so that the user can deal with it.
                 }
                     
             }
             
-            for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+            std::vector<plf::colony<edgeLineShape>::iterator> nearbyLines = getLinesInRegion(labelRegion);
+            for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = nearbyLines.begin(); lineIterator != nearbyLines.end(); ++lineIterator)
             {
-                if(calculateShortestDistance(*blockIterator, *lineIterator) < tolerance)
+                if(calculateShortestDistance(*blockIterator, *(*lineIterator)) < tolerance)
                 {
                     labelsViolated = true;
-                    blockIterator->setSelectState(true);
+                    setSelectState(*blockIterator, true);
                 }
                     
             }
             
-            for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+            if(p_nodeGrid.findWithin(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate(), tolerance))
+            {
+                labelsViolated = true;
+                setSelectState(*blockIterator, true);
+            }
+            
+            // Only the labels that come after this label in the list are checked
+            plf::colony<blockLabel>::iterator currentLabel = blockIterator;
+            p_blockLabelGrid.visitWithin(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate(), tolerance, [&](blockLabel *nearbyLabel) -> bool
             {
-                if(nodeIterator->getDistance(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate()) < tolerance)
+                if(nearbyLabel != &(*currentLabel) && currentLabel < _blockLabelList.get_iterator_from_pointer(nearbyLabel))
                 {
                     labelsViolated = true;
-                    blockIterator->setSelectState(true);
+                    setSelectState(*currentLabel, true);
+                    return true;
                 }
+                
+                return false;
+            });
+        }
+    }
+    
+    return labelsViolated;
+}
+
+
+
+void geometryEditor2D::resolveIntersections(double tolerance)
+{
+    /* First, merge any nodes that are ontop of each other. After sorting the nodes by position, the nodes that are ontop of each other will be next to each other.
+     * The sort is stable so the node that was added first is kept (this is the same node that the per item check keeps)
+     */
+    std::vector<plf::colony<node>::iterator> sortedNodes;
+    std::unordered_map<node*, node*> mergedNodes;
+    
+    sortedNodes.reserve(_nodeList.size());
+    
+    for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+    {
+        if(!nodeIterator->getDraggingState())
+            sortedNodes.push_back(nodeIterator);
+    }
+    
+    std::stable_sort(sortedNodes.begin(), sortedNodes.end(), [](const plf::colony<node>::iterator &firstNode, const plf::colony<node>::iterator &secondNode) -> bool
+    {
+        if(firstNode->getCenterXCoordinate() != secondNode->getCenterXCoordinate())
+            return (firstNode->getCenterXCoordinate() < secondNode->getCenterXCoordinate());
+        
+        return (firstNode->getCenterYCoordinate() < secondNode->getCenterYCoordinate());
+    });
+    
+    for(size_t i = 1; i < sortedNodes.size(); i++)
+    {
+        if(*sortedNodes[i] == *sortedNodes[i - 1])
+        {
+            std::unordered_map<node*, node*>::iterator keptNode = mergedNodes.find(&(*sortedNodes[i - 1]));
+            
+            if(keptNode != mergedNodes.end())
+                mergedNodes[&(*sortedNodes[i])] = keptNode->second;
+            else
+                mergedNodes[&(*sortedNodes[i])] = &(*sortedNodes[i - 1]);
+        }
+    }
+    
+    if(!mergedNodes.empty())
+    {
+        // Move all of the lines/arcs over to the node that is kept. Only the segments connected to the merged nodes need to be looked at
+        for(std::vector<plf::colony<node>::iterator>::iterator nodeIterator = sortedNodes.begin(); nodeIterator != sortedNodes.end(); ++nodeIterator)
+        {
+            std::unordered_map<node*, node*>::iterator mergedIterator = mergedNodes.find(&(*(*nodeIterator)));
+            
+            if(mergedIterator == mergedNodes.end())
+                continue;
+                
+            std::vector<plf::colony<edgeLineShape>::iterator> connectedLines = getLinesAtNode(**nodeIterator);
+            for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
+            {
+                if((*lineIterator)->getFirstNode() == mergedIterator->first)
+                    (*lineIterator)->setFirstNode(*mergedIterator->second);
+                    
+                if((*lineIterator)->getSecondNode() == mergedIterator->first)
+                    (*lineIterator)->setSecondNode(*mergedIterator->second);
                     
+                updateLine(**lineIterator);
             }
             
-            plf::colony<blockLabel>::iterator tempIterator = blockIterator;
-            for(plf::colony<blockLabel>::iterator blockIterator2 = ++tempIterator; blockIterator2 != _blockLabelList.end(); ++blockIterator2)
+            std::vector<plf::colony<arcShape>::iterator> connectedArcs = getArcsAtNode(**nodeIterator);
+            for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
             {
-                if(blockIterator2->getDistance(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate()) < tolerance)
+                if((*arcIterator)->getFirstNode() == mergedIterator->first)
+                    (*arcIterator)->setFirstNode(*mergedIterator->second);
+                    
+                if((*arcIterator)->getSecondNode() == mergedIterator->first)
+                    (*arcIterator)->setSecondNode(*mergedIterator->second);
+                    
+                updateArc(**arcIterator);
+            }
+            
+            eraseNode(*nodeIterator);
+        }
+    }
+    
+    /* Next, sort all of the nodes and the bounding boxes of the lines/arcs by the left side of the box.
+     * Sweeping from left to right, only the items whose boxes are still open (the active items) can overlap the current item
+     */
+    std::vector<sweepItem> sweepItems;
+    
+    sweepItems.reserve(_nodeList.size() + _lineList.size() + _arcList.size());
+    
+    for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+    {
+        if(nodeIterator->getDraggingState())
+            continue;
+            
+        sweepItem item;
+        item.box = boundingBox(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate(), nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
+        item.sweepNode = &(*nodeIterator);
+        sweepItems.push_back(item);
+    }
+    
+    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+    {
+        // If the line is to be ignored by the postprocessor, go ahead and ignore it in any intercetion calculation
+        if(lineIterator->getSegmentProperty()->getHiddenState() || !lineIterator->getFirstNode() || !lineIterator->getSecondNode())
+            continue;
+            
+        sweepItem item;
+        item.box = lineIterator->getBoundingBox().inflated(tolerance);
+        item.sweepLine = &(*lineIterator);
+        sweepItems.push_back(item);
+    }
+    
+    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+    {
+        if(arcIterator->getSegmentProperty()->getHiddenState() || !arcIterator->getFirstNode() || !arcIterator->getSecondNode())
+            continue;
+            
+        sweepItem item;
+        item.box = arcIterator->getBoundingBox().inflated(tolerance);
+        item.sweepArc = &(*arcIterator);
+        sweepItems.push_back(item);
+    }
+    
+    std::stable_sort(sweepItems.begin(), sweepItems.end(), [](const sweepItem &firstItem, const sweepItem &secondItem) -> bool
+    {
+        return (firstItem.box.getMinX() < secondItem.box.getMinX());
+    });
+    
+    /* These store all of the nodes that each line/arc needs to be broken at. The order vectors
+     * keep track of the order that the segments were found so that the segments are always broken in the same order
+     */
+    std::unordered_map<edgeLineShape*, std::vector<node*>> lineSplits;
+    std::unordered_map<arcShape*, std::vector<node*>> arcSplits;
+    std::vector<edgeLineShape*> lineSplitOrder;
+    std::vector<arcShape*> arcSplitOrder;
+    
+    auto addLineSplit = [&](edgeLineShape *lineSegment, node *splitNode)
+    {
+        if(*splitNode == *lineSegment->getFirstNode() || *splitNode == *lineSegment->getSecondNode())
+            return;
+            
+        double position = getPositionAlongLine(*lineSegment, splitNode->getCenterXCoordinate(), splitNode->getCenterYCoordinate());
+        
+        // Written this way so that a NaN position is also rejected
+        if(!(position > 0.0 && position < 1.0))
+            return;
+        
+        std::vector<node*> &splitNodes = lineSplits[lineSegment];
+        
+        if(splitNodes.empty())
+            lineSplitOrder.push_back(lineSegment);
+        
+        if(std::find(splitNodes.begin(), splitNodes.end(), splitNode) == splitNodes.end())
+            splitNodes.push_back(splitNode);
+    };
+    
+    auto addArcSplit = [&](arcShape *arcSegment, node *splitNode)
+    {
+        if(*splitNode == *arcSegment->getFirstNode() || *splitNode == *arcSegment->getSecondNode())
+            return;
+            
+        double position = getPositionAlongArc(*arcSegment, splitNode->getCenterXCoordinate(), splitNode->getCenterYCoordinate());
+        
+        if(!(position > 0.0 && position < (arcSegment->getArcAngle() * PI / 180.0)))
+            return;
+        
+        std::vector<node*> &splitNodes = arcSplits[arcSegment];
+        
+        if(splitNodes.empty())
+            arcSplitOrder.push_back(arcSegment);
+        
+        if(std::find(splitNodes.begin(), splitNodes.end(), splitNode) == splitNodes.end())
+            splitNodes.push_back(splitNode);
+    };
+    
+    /* Intersection nodes that did not exist before the sweep were never part of the sweep themselves. These
+     * are saved so that they can be checked against the other segments once the sweep is finished
+     */
+    std::vector<node*> createdNodes;
+    
+    auto getIntersectionNode = [&](double xPoint, double yPoint)
+    {
+        size_t numberOfNodes = _nodeList.size();
+        node *intersectionNode = getNodeAtPoint(xPoint, yPoint, tolerance);
+        
+        if(_nodeList.size() != numberOfNodes)
+            createdNodes.push_back(intersectionNode);
+            
+        return intersectionNode;
+    };
+    
+    auto checkPair = [&](sweepItem &firstItem, sweepItem &secondItem)
+    {
+        // Nodes that are ontop of each other were already merged
+        if(firstItem.sweepNode && secondItem.sweepNode)
+            return;
+        
+        // Always have the node as the first item and the line as the first segment in order to cut down on the number of cases
+        sweepItem *itemA = &firstItem;
+        sweepItem *itemB = &secondItem;
+        
+        if(itemB->sweepNode || (itemB->sweepLine && itemA->sweepArc))
+            std::swap(itemA, itemB);
+            
+        Vector intersectionPoints[2];
+        
+        if(itemA->sweepNode)
+        {
+            if(itemB->sweepLine && fabs(calculateShortestDistance(*itemA->sweepNode, *itemB->sweepLine)) < tolerance)
+                addLineSplit(itemB->sweepLine, itemA->sweepNode);
+            else if(itemB->sweepArc && fabs(shortestDistanceFromArc(Vector(itemA->sweepNode->getCenterXCoordinate(), itemA->sweepNode->getCenterYCoordinate()), *itemB->sweepArc)) < tolerance)
+                addArcSplit(itemB->sweepArc, itemA->sweepNode);
+        }
+        else if(itemA->sweepLine && itemB->sweepLine)
+        {
+            double tempX, tempY;
+            
+            // Nearly parallel lines can report an intersection at a point that is not finite
+            if(getIntersection(*itemB->sweepLine, *itemA->sweepLine, tempX, tempY) && std::isfinite(tempX) && std::isfinite(tempY))
+            {
+                node *intersectionNode = getIntersectionNode(tempX, tempY);
+                addLineSplit(itemA->sweepLine, intersectionNode);
+                addLineSplit(itemB->sweepLine, intersectionNode);
+            }
+        }
+        else if(itemA->sweepLine && itemB->sweepArc)
+        {
+            int j = getLineToArcIntersection(*itemA->sweepLine, *itemB->sweepArc, intersectionPoints);
+            
+            for(int k = 0; k < j; k++)
+            {
+                if(!std::isfinite(intersectionPoints[k].getXComponent()) || !std::isfinite(intersectionPoints[k].getYComponent()))
+                    continue;
+                    
+                node *intersectionNode = getIntersectionNode(intersectionPoints[k].getXComponent(), intersectionPoints[k].getYComponent());
+                addLineSplit(itemA->sweepLine, intersectionNode);
+                addArcSplit(itemB->sweepArc, intersectionNode);
+            }
+        }
+        else if(itemA->sweepArc && itemB->sweepArc)
+        {
+            int j = getArcToArcIntersection(*itemA->sweepArc, *itemB->sweepArc, intersectionPoints);
+            
+            for(int k = 0; k < j; k++)
+            {
+                if(!std::isfinite(intersectionPoints[k].getXComponent()) || !std::isfinite(intersectionPoints[k].getYComponent()))
+                    continue;
+                    
+                node *intersectionNode = getIntersectionNode(intersectionPoints[k].getXComponent(), intersectionPoints[k].getYComponent());
+                addArcSplit(itemA->sweepArc, intersectionNode);
+                addArcSplit(itemB->sweepArc, intersectionNode);
+            }
+        }
+    };
+    
+    std::vector<size_t> activeItems;
+    
+    for(size_t i = 0; i < sweepItems.size(); i++)
+    {
+        size_t numberOfActiveItems = 0;
+        
+        // Remove any items whose right side is to the left of the current item. These items can no longer overlap anything
+        for(size_t k = 0; k < activeItems.size(); k++)
+        {
+            if(sweepItems[activeItems[k]].box.getMaxX() >= sweepItems[i].box.getMinX())
+                activeItems[numberOfActiveItems++] = activeItems[k];
+        }
+        
+        activeItems.resize(numberOfActiveItems);
+        
+        for(std::vector<size_t>::iterator activeIterator = activeItems.begin(); activeIterator != activeItems.end(); ++activeIterator)
+        {
+            if(sweepItems[*activeIterator].box.overlaps(sweepItems[i].box))
+                checkPair(sweepItems[*activeIterator], sweepItems[i]);
+        }
+        
+        activeItems.push_back(i);
+    }
+    
+    /* Two segments can overlap each other, in which case the intersection node of one may lie on the other. The spatial
+     * trees have not been changed yet so they still describe the segments that were swept
+     */
+    for(std::vector<node*>::iterator nodeIterator = createdNodes.begin(); nodeIterator != createdNodes.end(); ++nodeIterator)
+    {
+        node *createdNode = *nodeIterator;
+        boundingBox searchBox = boundingBox(createdNode->getCenterXCoordinate(), createdNode->getCenterYCoordinate(), createdNode->getCenterXCoordinate(), createdNode->getCenterYCoordinate()).inflated(tolerance);
+        
+        std::vector<plf::colony<edgeLineShape>::iterator> nearbyLines = getLinesInRegion(searchBox);
+        for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = nearbyLines.begin(); lineIterator != nearbyLines.end(); ++lineIterator)
+        {
+            if(!(*lineIterator)->getSegmentProperty()->getHiddenState() && fabs(calculateShortestDistance(*createdNode, **lineIterator)) < tolerance)
+                addLineSplit(&(**lineIterator), createdNode);
+        }
+        
+        std::vector<plf::colony<arcShape>::iterator> nearbyArcs = getArcsInRegion(searchBox);
+        for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = nearbyArcs.begin(); arcIterator != nearbyArcs.end(); ++arcIterator)
+        {
+            if(!(*arcIterator)->getSegmentProperty()->getHiddenState() && fabs(shortestDistanceFromArc(Vector(createdNode->getCenterXCoordinate(), createdNode->getCenterYCoordinate()), **arcIterator)) < tolerance)
+                addArcSplit(&(**arcIterator), createdNode);
+        }
+    }
+    
+    /* Lastly, break up all of the segments at once */
+    for(std::vector<edgeLineShape*>::iterator lineIterator = lineSplitOrder.begin(); lineIterator != lineSplitOrder.end(); ++lineIterator)
+        splitLine(_lineList.get_iterator_from_pointer(*lineIterator), lineSplits[*lineIterator]);
+        
+    for(std::vector<arcShape*>::iterator arcIterator = arcSplitOrder.begin(); arcIterator != arcSplitOrder.end(); ++arcIterator)
+        splitArc(_arcList.get_iterator_from_pointer(*arcIterator), arcSplits[*arcIterator]);
+    
+    /* Segments that were placed on top of each other are now connected to the same nodes and segments whose endpoints were merged
+     * now start and end on the same node. Only the first of each is kept
+     */
+    if(!mergedNodes.empty() || !lineSplitOrder.empty() || !arcSplitOrder.empty())
+        removeDuplicateSegments();
+}
+
+
+
+bool geometryEditor2D::commitBatch(double tolerance)
+{
+    if(!p_batchIsOpen)
+        return false;
+        
+    p_batchIsOpen = false;
+    
+    // None of the appended geometry was placed into the indexes. It is faster to build the indexes once from the lists
+    rebuildSpatialIndex();
+    
+    if(tolerance == 0)
+    {
+        boundingBox modelBox;
+        
+        if(_nodeList.size() < 2 || !getModelBoundingBox(modelBox))
+            tolerance = 1.0e-08;
+        else
+            tolerance = modelBox.getDiagonal() * 1.0e-06;
+    }
+    
+    snapNodes(tolerance);
+    
+    // The segments that were made zero length by the snapping need to be removed before looking for intersections
+    removeDuplicateSegments();
+    
+    resolveIntersections(tolerance);
+    
+    _lastNodeAdded = _nodeList.begin();
+    _lastLineAdded = _lineList.begin();
+    _lastArcAdded = _arcList.begin();
+    
+    return true;
+}
+
+
+
+void geometryEditor2D::snapNodes(double tolerance)
+{
+    std::unordered_map<node*, node*> snappedNodes;
+    
+    /* Nodes are processed in list order. A node that has not been snapped yet keeps all of the nearby nodes that have not been snapped.
+     * If a nearby node came before this node in the list, then that node would have already taken this node. So, a kept node is never snapped to another node
+     */
+    for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end(); ++nodeIterator)
+    {
+        node *keptNode = &(*nodeIterator);
+        
+        if(nodeIterator->getDraggingState() || snappedNodes.find(keptNode) != snappedNodes.end())
+            continue;
+            
+        p_nodeGrid.visitWithin(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate(), tolerance, [&](node *nearbyNode) -> bool
+        {
+            if(nearbyNode != keptNode && snappedNodes.find(nearbyNode) == snappedNodes.end())
+                snappedNodes[nearbyNode] = keptNode;
+                
+            return false;
+        });
+    }
+    
+    if(snappedNodes.empty())
+        return;
+        
+    for(plf::colony<node>::iterator nodeIterator = _nodeList.begin(); nodeIterator != _nodeList.end();)
+    {
+        std::unordered_map<node*, node*>::iterator snappedIterator = snappedNodes.find(&(*nodeIterator));
+        
+        if(snappedIterator == snappedNodes.end())
+        {
+            ++nodeIterator;
+            continue;
+        }
+        
+        std::vector<edgeLineShape*> connectedLines = p_lineIncidence.getSegments(snappedIterator->first);
+        for(std::vector<edgeLineShape*>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
+        {
+            if((*lineIterator)->getFirstNode() == snappedIterator->first)
+                (*lineIterator)->setFirstNode(*snappedIterator->second);
+                
+            if((*lineIterator)->getSecondNode() == snappedIterator->first)
+                (*lineIterator)->setSecondNode(*snappedIterator->second);
+                
+            (*lineIterator)->calculateDistance();
+            updateLine(**lineIterator);
+        }
+        
+        // The center of the arc depends on the position of the endpoints so the arc needs to be recalculated
+        std::vector<arcShape*> connectedArcs = p_arcIncidence.getSegments(snappedIterator->first);
+        for(std::vector<arcShape*>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
+        {
+            if((*arcIterator)->getFirstNode() == snappedIterator->first)
+                (*arcIterator)->setFirstNode(*snappedIterator->second);
+                
+            if((*arcIterator)->getSecondNode() == snappedIterator->first)
+                (*arcIterator)->setSecondNode(*snappedIterator->second);
+                
+            if((*arcIterator)->getFirstNode() != (*arcIterator)->getSecondNode())
+                (*arcIterator)->calculate();
+                
+            updateArc(**arcIterator);
+        }
+        
+        nodeIterator = eraseNode(nodeIterator);
+    }
+}
+
+
+
+void geometryEditor2D::removeDuplicateSegments()
+{
+    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end();)
+    {
+        node *firstNode = lineIterator->getFirstNode();
+        node *secondNode = lineIterator->getSecondNode();
+        bool isDuplicate = (firstNode && firstNode == secondNode);
+        
+        if(firstNode && secondNode && !isDuplicate)
+        {
+            // The line could have been drawn in either direction
+            std::vector<edgeLineShape*> sameLines = p_lineIncidence.getSegments(firstNode, secondNode);
+            std::vector<edgeLineShape*> reversedLines = p_lineIncidence.getSegments(secondNode, firstNode);
+            sameLines.insert(sameLines.end(), reversedLines.begin(), reversedLines.end());
+            
+            for(std::vector<edgeLineShape*>::iterator sameIterator = sameLines.begin(); sameIterator != sameLines.end(); ++sameIterator)
+            {
+                if(*sameIterator != &(*lineIterator) && _lineList.get_iterator_from_pointer(*sameIterator) < lineIterator)
                 {
-                    labelsViolated = true;
-                    blockIterator->setSelectState(true);
+                    isDuplicate = true;
+                    break;
                 }
-                    
             }
         }
+        
+        if(isDuplicate)
+            lineIterator = eraseLine(lineIterator);
+        else
+            ++lineIterator;
     }
     
-    return labelsViolated;
+    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end();)
+    {
+        node *firstNode = arcIterator->getFirstNode();
+        bool isDuplicate = (firstNode && firstNode == arcIterator->getSecondNode());
+        
+        if(firstNode && arcIterator->getSecondNode() && !isDuplicate)
+        {
+            std::vector<arcShape*> sameArcs = p_arcIncidence.getSegments(firstNode, arcIterator->getSecondNode());
+            
+            for(std::vector<arcShape*>::iterator sameIterator = sameArcs.begin(); sameIterator != sameArcs.end(); ++sameIterator)
+            {
+                if(*sameIterator != &(*arcIterator) && fabs((*sameIterator)->getArcAngle() - arcIterator->getArcAngle()) < 1.0e-02 && _arcList.get_iterator_from_pointer(*sameIterator) < arcIterator)
+                {
+                    isDuplicate = true;
+                    break;
+                }
+            }
+        }
+        
+        if(isDuplicate)
+            arcIterator = eraseArc(arcIterator);
+        else
+            ++arcIterator;
+    }
+}
+
+
+
+node *geometryEditor2D::getNodeAtPoint(double xPoint, double yPoint, double tolerance)
+{
+    node *existingNode = p_nodeGrid.findNearest(xPoint, yPoint, tolerance);
+    
+    if(existingNode)
+        return existingNode;
+        
+    node newNode;
+    
+    newNode.setCenter(xPoint, yPoint);
+    newNode.setNodeID(++_nodeNumber);
+    _lastNodeAdded = insertNode(newNode);
+    
+    return &(*_lastNodeAdded);
+}
+
+
+
+double geometryEditor2D::getPositionAlongLine(edgeLineShape &lineSegment, double xPoint, double yPoint)
+{
+    double xDirection = lineSegment.getSecondNode()->getCenterXCoordinate() - lineSegment.getFirstNode()->getCenterXCoordinate();
+    double yDirection = lineSegment.getSecondNode()->getCenterYCoordinate() - lineSegment.getFirstNode()->getCenterYCoordinate();
+    double lengthSquared = xDirection * xDirection + yDirection * yDirection;
+    
+    if(lengthSquared == 0)
+        return 0;
+        
+    return ((xPoint - lineSegment.getFirstNode()->getCenterXCoordinate()) * xDirection + (yPoint - lineSegment.getFirstNode()->getCenterYCoordinate()) * yDirection) / lengthSquared;
+}
+
+
+
+double geometryEditor2D::getPositionAlongArc(arcShape &arcSegment, double xPoint, double yPoint)
+{
+    double startAngle = atan2(arcSegment.getFirstNode()->getCenterYCoordinate() - arcSegment.getCenterYCoordinate(), arcSegment.getFirstNode()->getCenterXCoordinate() - arcSegment.getCenterXCoordinate());
+    double pointAngle = atan2(yPoint - arcSegment.getCenterYCoordinate(), xPoint - arcSegment.getCenterXCoordinate());
+    double position = fmod(pointAngle - startAngle, 2.0 * PI);
+    
+    if(position < 0)
+        position += 2.0 * PI;
+        
+    return position;
 }
 
 
 
+void geometryEditor2D::splitLine(plf::colony<edgeLineShape>::iterator lineIterator, std::vector<node*> splitNodes)
+{
+    if(splitNodes.empty())
+        return;
+        
+    edgeLineShape originalLine = *lineIterator;
+    node *lastNode = originalLine.getSecondNode();
+    
+    std::vector<std::pair<double, node*>> orderedNodes;
+    
+    for(std::vector<node*>::iterator nodeIterator = splitNodes.begin(); nodeIterator != splitNodes.end(); ++nodeIterator)
+        orderedNodes.push_back(std::make_pair(getPositionAlongLine(originalLine, (*nodeIterator)->getCenterXCoordinate(), (*nodeIterator)->getCenterYCoordinate()), *nodeIterator));
+        
+    std::sort(orderedNodes.begin(), orderedNodes.end());
+    
+    // The existing line becomes the first piece
+    lineIterator->setSecondNode(*orderedNodes.front().second);
+    lineIterator->calculateDistance();
+    updateLine(*lineIterator);
+    
+    for(size_t i = 0; i < orderedNodes.size(); i++)
+    {
+        edgeLineShape edgeLine = originalLine;
+        
+        edgeLine.setFirstNode(*orderedNodes[i].second);
+        
+        if(i + 1 < orderedNodes.size())
+            edgeLine.setSecondNode(*orderedNodes[i + 1].second);
+        else
+            edgeLine.setSecondNode(*lastNode);
+            
+        edgeLine.calculateDistance();
+        _lastLineAdded = insertLine(edgeLine);
+    }
+}
+
+
+
+void geometryEditor2D::splitArc(plf::colony<arcShape>::iterator arcIterator, std::vector<node*> splitNodes)
+{
+    if(splitNodes.empty())
+        return;
+        
+    arcShape originalArc = *arcIterator;
+    node *lastNode = originalArc.getSecondNode();
+    double arcAngle = originalArc.getArcAngle() * PI / 180.0;
+    
+    std::vector<std::pair<double, node*>> orderedNodes;
+    
+    for(std::vector<node*>::iterator nodeIterator = splitNodes.begin(); nodeIterator != splitNodes.end(); ++nodeIterator)
+        orderedNodes.push_back(std::make_pair(getPositionAlongArc(originalArc, (*nodeIterator)->getCenterXCoordinate(), (*nodeIterator)->getCenterYCoordinate()), *nodeIterator));
+        
+    std::sort(orderedNodes.begin(), orderedNodes.end());
+    
+    // The existing arc becomes the first piece
+    arcIterator->setSecondNode(*orderedNodes.front().second);
+    arcIterator->setArcAngle(orderedNodes.front().first * (180.0 / PI));
+    arcIterator->calculate();
+    updateArc(*arcIterator);
+    
+    for(size_t i = 0; i < orderedNodes.size(); i++)
+    {
+        arcShape arcSegment = originalArc;
+        double endAngle = arcAngle;
+        
+        arcSegment.setFirstNode(*orderedNodes[i].second);
+        
+        if(i + 1 < orderedNodes.size())
+        {
+            arcSegment.setSecondNode(*orderedNodes[i + 1].second);
+            endAngle = orderedNodes[i + 1].first;
+        }
+        else
+            arcSegment.setSecondNode(*lastNode);
+            
+        arcSegment.setArcAngle((endAngle - orderedNodes[i].first) * (180.0 / PI));
+        arcSegment.setNumSegments(20);
+        arcSegment.calculate();
+        arcSegment.setArcID(++p_arcNumber);
+        
+        _lastArcAdded = insertArc(arcSegment);
+    }
+}
+
+
 
 bool geometryEditor2D::createFillet(double radius)
 {
@@ -808,21 +1428,24 @@ bool geometryEditor2D::createFillet(double radius)
     {
         if(nodeIterator->getIsSelectedState())
         {
-            nodeIterator->setSelectState(false);
+            setSelectState(*nodeIterator, false);
             unsigned int numberOfLines = 0;
             unsigned int numberOfArcs = 0;
             
+            std::vector<plf::colony<edgeLineShape>::iterator> connectedLines = getLinesAtNode(*nodeIterator);
+            std::vector<plf::colony<arcShape>::iterator> connectedArcs = getArcsAtNode(*nodeIterator);
+            
             // Tally up the number of lines connected to the node
-            for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+            for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
             {
-                if((*lineIterator->getFirstNode() == *nodeIterator || *lineIterator->getSecondNode() == *nodeIterator) && !lineIterator->getSegmentProperty()->getHiddenState())
+                if(!(*lineIterator)->getSegmentProperty()->getHiddenState())
                     numberOfLines++;
             }
             
             // Tally up the number of arcs connected to the node
-            for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+            for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
             {
-                if((*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator) && !arcIterator->getSegmentProperty()->getHiddenState())
+                if(!(*arcIterator)->getSegmentProperty()->getHiddenState())
                     numberOfArcs++;
             }
             
@@ -846,26 +1469,26 @@ bool geometryEditor2D::createFillet(double radius)
                     int k = 0;
                     
                     // First we need to grab some information about the arc that the node is connected to
-                    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+                    for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
                     {
-                        if((*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator) && !arcIterator->getSegmentProperty()->getHiddenState())
+                        if(!(*arcIterator)->getSegmentProperty()->getHiddenState())
                         {
-                            addedArc.setSegmentProperty(*arcIterator->getSegmentProperty());
-                            addedArc.setNumSegments(arcIterator->getnumSegments());
-                            centerPoint.Set(arcIterator->getCenterXCoordinate(), arcIterator->getCenterYCoordinate());
-                            arcRadius = arcIterator->getRadius();
-                            connectedArc = arcIterator;
+                            addedArc.setSegmentProperty(*(*arcIterator)->getSegmentProperty());
+                            addedArc.setNumSegments((*arcIterator)->getnumSegments());
+                            centerPoint.Set((*arcIterator)->getCenterXCoordinate(), (*arcIterator)->getCenterYCoordinate());
+                            arcRadius = (*arcIterator)->getRadius();
+                            connectedArc = *arcIterator;
                         }
                     }
                     
                     // Next, we need to grab some information about the line that the node is connected to
-                    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+                    for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
                     {
-                        if((*lineIterator->getFirstNode() == *nodeIterator || *lineIterator->getSecondNode() == *nodeIterator) && !lineIterator->getSegmentProperty()->getHiddenState())
+                        if(!(*lineIterator)->getSegmentProperty()->getHiddenState())
                         {
-                            lineEndpointOne.Set(lineIterator->getFirstNode()->getCenterXCoordinate(), lineIterator->getFirstNode()->getCenterYCoordinate());
-                            lineEndpointTwo.Set(lineIterator->getSecondNode()->getCenterXCoordinate(), lineIterator->getSecondNode()->getCenterYCoordinate());
-                            connectedLine = lineIterator;
+                            lineEndpointOne.Set((*lineIterator)->getFirstNode()->getCenterXCoordinate(), (*lineIterator)->getFirstNode()->getCenterYCoordinate());
+                            lineEndpointTwo.Set((*lineIterator)->getSecondNode()->getCenterXCoordinate(), (*lineIterator)->getSecondNode()->getCenterYCoordinate());
+                            connectedLine = *lineIterator;
                         }
                     }
                     
@@ -951,25 +1574,28 @@ bool geometryEditor2D::createFillet(double radius)
                     
                     bool isConnectedToHiddenSegment = false;
                     
-                    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+                    // Adding the nodes above could have broken up the line and the arc so the connected segments need to be looked up again
+                    connectedLines = getLinesAtNode(*nodeIterator);
+                    for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
                     {
-                        if((*lineIterator->getFirstNode() == *nodeIterator || *lineIterator->getSecondNode() == *nodeIterator) && !lineIterator->getSegmentProperty()->getHiddenState())
+                        if(!(*lineIterator)->getSegmentProperty()->getHiddenState())
                         {
-                            _lineList.erase(lineIterator);
+                            eraseLine(*lineIterator);
                             break;
                         }
-                        else if(lineIterator->getSegmentProperty()->getHiddenState())
+                        else
                             isConnectedToHiddenSegment = true;
                     }
                     
-                    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+                    connectedArcs = getArcsAtNode(*nodeIterator);
+                    for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
                     {
-                        if((*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator) && !arcIterator->getSegmentProperty()->getHiddenState())
+                        if(!(*arcIterator)->getSegmentProperty()->getHiddenState())
                         {
-                            _arcList.erase(arcIterator);
+                            eraseArc(*arcIterator);
                             break;
                         }
-                        else if(arcIterator->getSegmentProperty()->getHiddenState())
+                        else
                             isConnectedToHiddenSegment = true;
                     }
                         
@@ -987,7 +1613,7 @@ bool geometryEditor2D::createFillet(double radius)
                         willReturn = true;
                         
                     if(!isConnectedToHiddenSegment)
-                        _nodeList.erase(nodeIterator++);
+                        nodeIterator = eraseNode(nodeIterator);
                     else
                         nodeIterator++;
                 }
@@ -1004,9 +1630,11 @@ bool geometryEditor2D::createFillet(double radius)
                     
                     commonNode.Set(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
                     
-                    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+                    for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator connectedIterator = connectedLines.begin(); connectedIterator != connectedLines.end(); ++connectedIterator)
                     {
-                        if(!firstLineFound && (*lineIterator->getFirstNode() == *nodeIterator || *lineIterator->getSecondNode() == *nodeIterator) && !lineIterator->getSegmentProperty()->getHiddenState())
+                        plf::colony<edgeLineShape>::iterator lineIterator = *connectedIterator;
+                        
+                        if(!firstLineFound && !lineIterator->getSegmentProperty()->getHiddenState())
                         {
                             if(*lineIterator->getFirstNode() == *nodeIterator)
                                 endPointLine1.Set(lineIterator->getSecondNode()->getCenterXCoordinate(), lineIterator->getSecondNode()->getCenterYCoordinate());
@@ -1017,7 +1645,7 @@ bool geometryEditor2D::createFillet(double radius)
                             
                             firstLineFound = true;
                         }
-                        else if(!secondLineFound && (*lineIterator->getFirstNode() == *nodeIterator || *lineIterator->getSecondNode() == *nodeIterator) && !lineIterator->getSegmentProperty()->getHiddenState())
+                        else if(!secondLineFound && !lineIterator->getSegmentProperty()->getHiddenState())
                         {
                             if(*lineIterator->getFirstNode() == *nodeIterator)
                                 endPointLine2.Set(lineIterator->getSecondNode()->getCenterXCoordinate(), lineIterator->getSecondNode()->getCenterYCoordinate());
@@ -1083,32 +1711,22 @@ bool geometryEditor2D::createFillet(double radius)
                     
                     bool isConnectedToHiddenLine = false;
                     
-                    for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end();)
+                    // Adding the nodes above broke up the lines so the connected lines need to be looked up again
+                    connectedLines = getLinesAtNode(*nodeIterator);
+                    for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
                     {
-                        if((*nodeIterator == *lineIterator->getFirstNode() || *nodeIterator == *lineIterator->getSecondNode()) && !lineIterator->getSegmentProperty()->getHiddenState())
-                        {
-                            if(lineIterator == _lineList.back())
-                            {
-                                _lineList.erase(lineIterator);
-                                break;
-                            }
-                            else
-                                _lineList.erase(lineIterator++);
-                        }
-                        else if(lineIterator->getSegmentProperty()->getHiddenState())
-                        {
-                            isConnectedToHiddenLine = true;
-                            lineIterator++;
-                        }
+                        if(!(*lineIterator)->getSegmentProperty()->getHiddenState())
+                            eraseLine(*lineIterator);
                         else
-                            lineIterator++;
+                            isConnectedToHiddenLine = true;
                     }
                     
                     if(!isConnectedToHiddenLine)
                     {
-                        for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+                        connectedArcs = getArcsAtNode(*nodeIterator);
+                        for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
                         {
-                            if((*nodeIterator == *arcIterator->getFirstNode() || *nodeIterator == *arcIterator->getSecondNode()) && arcIterator->getSegmentProperty()->getHiddenState())
+                            if((*arcIterator)->getSegmentProperty()->getHiddenState())
                             {
                                 // Even if there is one arc/line connnected to the node and labeled as hidden, we must keep that node
                                 // Although if there are multiple lines/arcs, connected to the node, then they all must be hidden save for
@@ -1127,7 +1745,7 @@ bool geometryEditor2D::createFillet(double radius)
                         willReturn = true;
                         
                     if(!isConnectedToHiddenLine)
-                        _nodeList.erase(nodeIterator++); /// TODO: Check here for issues with iterators
+                        nodeIterator = eraseNode(nodeIterator); /// TODO: Check here for issues with iterators
                     else
                         nodeIterator++;
                 }
@@ -1145,9 +1763,11 @@ bool geometryEditor2D::createFillet(double radius)
                     
                     commonNode = Vector(nodeIterator->getCenterXCoordinate(), nodeIterator->getCenterYCoordinate());
                     
-                    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end(); ++arcIterator)
+                    for(std::vector<plf::colony<arcShape>::iterator>::iterator connectedIterator = connectedArcs.begin(); connectedIterator != connectedArcs.end(); ++connectedIterator)
                     {
-                        if(!firstArcFound && (*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator) && !arcIterator->getSegmentProperty()->getHiddenState())
+                        plf::colony<arcShape>::iterator arcIterator = *connectedIterator;
+                        
+                        if(!firstArcFound && !arcIterator->getSegmentProperty()->getHiddenState())
                         {
                             arcCenter1 = Vector(arcIterator->getCenterXCoordinate(), arcIterator->getCenterYCoordinate());
                             radius1 = arcIterator->getRadius(); 
@@ -1156,7 +1776,7 @@ bool geometryEditor2D::createFillet(double radius)
                             firstArc = arcIterator;
                             firstArcFound = true;
                         }
-                        else if(!secondArcFound && (*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator) && !arcIterator->getSegmentProperty()->getHiddenState())
+                        else if(!secondArcFound && !arcIterator->getSegmentProperty()->getHiddenState())
                         {
                             arcCenter2 = Vector(arcIterator->getCenterXCoordinate(), arcIterator->getCenterYCoordinate());
                             radius2 = arcIterator->getRadius();
@@ -1259,32 +1879,22 @@ bool geometryEditor2D::createFillet(double radius)
                     
                     bool isConnectedToHiddenSegment = false;
                     
-                    for(plf::colony<arcShape>::iterator arcIterator = _arcList.begin(); arcIterator != _arcList.end();)
+                    // Adding the nodes above broke up the arcs so the connected arcs need to be looked up again
+                    connectedArcs = getArcsAtNode(*nodeIterator);
+                    for(std::vector<plf::colony<arcShape>::iterator>::iterator arcIterator = connectedArcs.begin(); arcIterator != connectedArcs.end(); ++arcIterator)
                     {
-                        if((*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator) && !arcIterator->getSegmentProperty()->getHiddenState())
-                        {
-                            if(arcIterator == _arcList.back())
-                            {
-                                _arcList.erase(arcIterator);
-                                break;
-                            }
-                            else
-                                _arcList.erase(arcIterator++);
-                        }
-                        else if(arcIterator->getSegmentProperty()->getHiddenState())
-                        {
-                            isConnectedToHiddenSegment = true;
-                            arcIterator++;
-                        }
+                        if(!(*arcIterator)->getSegmentProperty()->getHiddenState())
+                            eraseArc(*arcIterator);
                         else
-                            arcIterator++;
+                            isConnectedToHiddenSegment = true;
                     }
                     
                     if(!isConnectedToHiddenSegment)
                     {
-                        for(plf::colony<edgeLineShape>::iterator lineIterator = _lineList.begin(); lineIterator != _lineList.end(); ++lineIterator)
+                        connectedLines = getLinesAtNode(*nodeIterator);
+                        for(std::vector<plf::colony<edgeLineShape>::iterator>::iterator lineIterator = connectedLines.begin(); lineIterator != connectedLines.end(); ++lineIterator)
                         {
-                            if((*nodeIterator == *lineIterator->getFirstNode() || *nodeIterator == *lineIterator->getSecondNode()) && lineIterator->getSegmentProperty()->getHiddenState())
+                            if((*lineIterator)->getSegmentProperty()->getHiddenState())
                             {
                                 // Even if there is one arc/line connnected to the node and labeled as hidden, we must keep that node
                                 // Although if there are multiple lines/arcs, connected to the node, then they all must be hidden save for
@@ -1308,7 +1918,7 @@ bool geometryEditor2D::createFillet(double radius)
                         willReturn = true;
                         
                     if(!isConnectedToHiddenSegment)
-                        _nodeList.erase(nodeIterator++);
+                        nodeIterator = eraseNode(nodeIterator);
                     else
                         nodeIterator++;
                 }
@@ -1604,3 +2214,65 @@ double geometryEditor2D::calculateShortestDistance(QPointF selectedPoint, edgeLi
     
     return sqrt((selectedPoint.x() - x[2]) * (selectedPoint.x() - x[2]) + (selectedPoint.y() - y[2]) * (selectedPoint.y() - y[2]));
 }
+
+
+
+node *geometryEditor2D::pickNode(double xCoordinate, double yCoordinate, double tolerance)
+{
+    return p_nodeGrid.findNearest(xCoordinate, yCoordinate, tolerance);
+}
+
+
+
+blockLabel *geometryEditor2D::pickBlockLabel(double xCoordinate, double yCoordinate, double tolerance)
+{
+    return p_blockLabelGrid.findNearest(xCoordinate, yCoordinate, tolerance);
+}
+
+
+
+edgeLineShape *geometryEditor2D::pickLine(double xCoordinate, double yCoordinate, double tolerance)
+{
+    edgeLineShape *closestLine = nullptr;
+    double closestDistance = tolerance;
+    QPointF selectedPoint(xCoordinate, yCoordinate);
+    
+    p_lineTree.query(boundingBox(xCoordinate, yCoordinate, xCoordinate, yCoordinate).inflated(tolerance), [&](edgeLineShape *nearbyLine) -> bool
+    {
+        double distance = fabs(calculateShortestDistance(selectedPoint, *nearbyLine));
+        
+        if(distance < closestDistance)
+        {
+            closestLine = nearbyLine;
+            closestDistance = distance;
+        }
+        
+        return false;
+    });
+    
+    return closestLine;
+}
+
+
+
+arcShape *geometryEditor2D::pickArc(double xCoordinate, double yCoordinate, double tolerance)
+{
+    arcShape *closestArc = nullptr;
+    double closestDistance = tolerance;
+    Vector selectedPoint(xCoordinate, yCoordinate);
+    
+    p_arcTree.query(boundingBox(xCoordinate, yCoordinate, xCoordinate, yCoordinate).inflated(tolerance), [&](arcShape *nearbyArc) -> bool
+    {
+        double distance = fabs(shortestDistanceFromArc(selectedPoint, *nearbyArc));
+        
+        if(distance < closestDistance)
+        {
+            closestArc = nearbyArc;
+            closestDistance = distance;
+        }
+        
+        return false;
+    });
+    
+    return closestArc;
+}
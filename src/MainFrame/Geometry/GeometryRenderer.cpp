@@ -0,0 +1,829 @@
+#include "Include/UI/Geometry/GeometryRenderer.h"
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+
+
+
+/**
+ * @brief Hash for the index of a pixel that is used to cluster points
+ */
+struct pixelIndexHash
+{
+	size_t operator()(const std::pair<long long, long long> &index) const
+	{
+		return std::hash<long long>()(index.first) ^ (std::hash<long long>()(index.second) * 31);
+	}
+};
+
+
+
+void geometryRenderer::initialize()
+{
+	initializeOpenGLFunctions();
+
+	if(p_isInitialized)
+		return;
+
+	vertexBatch *batches[] = {&p_lines, &p_hiddenLines, &p_arcs, &p_hiddenArcs, &p_nodes, &p_blockLabels};
+
+	for(vertexBatch *batch : batches)
+	{
+		glGenBuffers(1, &batch->positionBuffer);
+		glGenBuffers(1, &batch->colorBuffer);
+		glGenBuffers(1, &batch->pickColorBuffer);
+	}
+
+	p_isInitialized = true;
+	p_geometryIsDirty = true;
+}
+
+
+
+void geometryRenderer::release()
+{
+	if(!p_isInitialized)
+		return;
+
+	vertexBatch *batches[] = {&p_lines, &p_hiddenLines, &p_arcs, &p_hiddenArcs, &p_nodes, &p_blockLabels};
+
+	for(vertexBatch *batch : batches)
+	{
+		glDeleteBuffers(1, &batch->positionBuffer);
+		glDeleteBuffers(1, &batch->colorBuffer);
+		glDeleteBuffers(1, &batch->pickColorBuffer);
+		batch->positionBuffer = 0;
+		batch->colorBuffer = 0;
+		batch->pickColorBuffer = 0;
+	}
+
+	if(p_pickFramebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &p_pickFramebuffer);
+		glDeleteRenderbuffers(1, &p_pickRenderbuffer);
+		p_pickFramebuffer = 0;
+		p_pickRenderbuffer = 0;
+		p_pickBufferSize = 0;
+	}
+
+	p_isInitialized = false;
+}
+
+
+
+void geometryRenderer::addArc(vertexBatch &batch, arcShape &arc, bool asStrip, double pixelSize)
+{
+	/* This is the same tessellation that arcShape::draw uses. The points are found by rotating the first node about the center of the arc.
+	 * The number of segments is the smallest number for which the middle of each segment is within a quarter of a pixel from the arc
+	 */
+	double arcAngle = fabs(arc.getArcAngle()) * PI / 180.0;
+	double radius = arc.getRadius() / pixelSize;
+	unsigned int numSegments = arc.getnumSegments();
+
+	if(radius > 0.25)
+	{
+		double segmentAngle = 2.0 * acos(1.0 - 0.25 / radius);
+
+		if(segmentAngle > 0 && arcAngle / segmentAngle < (double)numSegments)
+			numSegments = (unsigned int)ceil(arcAngle / segmentAngle);
+	}
+	else
+		numSegments = 1;
+
+	if(numSegments < 1)
+		numSegments = 1;
+
+	/* At full detail the points are the polyline that is cached by the arc. Otherwise, the fewer points that are needed
+	 * are computed here. These are not cached since they change with the zoom
+	 */
+	arcPolyline reducedPolyline;
+	const arcPolyline *polyline = &reducedPolyline;
+
+	if(numSegments == arc.getnumSegments())
+		polyline = &arc.getPolyline();
+	else
+	{
+		double firstX = arc.getFirstNode()->getCenterXCoordinate();
+		double firstY = arc.getFirstNode()->getCenterYCoordinate();
+		double centerX = arc.getCenterXCoordinate();
+		double centerY = arc.getCenterYCoordinate();
+		double angle = -(arcAngle / (double)numSegments);
+
+		reducedPolyline.reserve(numSegments + 1);
+		reducedPolyline.push_back(QPointF(firstX, firstY));
+
+		for(unsigned int i = 1; i < numSegments; i++)
+		{
+			double xPoint = (firstX - centerX) * cos(i * angle) + (firstY - centerY) * sin(i * angle) + centerX;
+			double yPoint = -(firstX - centerX) * sin(i * angle) + (firstY - centerY) * cos(i * angle) + centerY;
+			reducedPolyline.push_back(QPointF(xPoint, yPoint));
+		}
+
+		reducedPolyline.push_back(QPointF(arc.getSecondNode()->getCenterXCoordinate(), arc.getSecondNode()->getCenterYCoordinate()));
+	}
+
+	beginGroup(batch);
+
+	if(asStrip)
+		addVertex(batch, polyline->front().x(), polyline->front().y());
+
+	for(size_t i = 1; i < polyline->size(); i++)
+	{
+		if(!asStrip)
+			addVertex(batch, (*polyline)[i - 1].x(), (*polyline)[i - 1].y());
+
+		addVertex(batch, (*polyline)[i].x(), (*polyline)[i].y());
+	}
+
+	addItem(batch, &arc);
+}
+
+
+
+void geometryRenderer::addPoints(vertexBatch &batch, const std::vector<geometry2D*> &items, const std::vector<double> &xCoordinates, const std::vector<double> &yCoordinates, double pixelSize)
+{
+	std::unordered_map<std::pair<long long, long long>, unsigned int, pixelIndexHash> pixels;
+	std::vector<unsigned int> pixelOfItem(items.size());
+	std::vector<size_t> firstItemOfPixel;
+
+	pixels.reserve(items.size());
+
+	for(size_t i = 0; i < items.size(); i++)
+	{
+		double xIndex = floor(xCoordinates[i] / pixelSize);
+		double yIndex = floor(yCoordinates[i] / pixelSize);
+		unsigned int pixel;
+
+		// Points that are too far from the origin to be given a pixel index are never clustered
+		if(fabs(xIndex) < 1.0e18 && fabs(yIndex) < 1.0e18)
+		{
+			std::pair<long long, long long> index((long long)xIndex, (long long)yIndex);
+			std::pair<std::unordered_map<std::pair<long long, long long>, unsigned int, pixelIndexHash>::iterator, bool> result = pixels.insert(std::make_pair(index, (unsigned int)firstItemOfPixel.size()));
+
+			pixel = result.first->second;
+
+			if(result.second)
+				firstItemOfPixel.push_back(i);
+		}
+		else
+		{
+			pixel = firstItemOfPixel.size();
+			firstItemOfPixel.push_back(i);
+		}
+
+		pixelOfItem[i] = pixel;
+	}
+
+	/* Sort the items by pixel so that the items of each pixel are next to each other */
+	std::vector<unsigned int> pixelStart(firstItemOfPixel.size() + 1, 0);
+
+	for(size_t i = 0; i < items.size(); i++)
+		pixelStart[pixelOfItem[i] + 1]++;
+
+	for(size_t i = 1; i < pixelStart.size(); i++)
+		pixelStart[i] += pixelStart[i - 1];
+
+	std::vector<geometry2D*> sortedItems(items.size());
+	std::vector<unsigned int> nextPosition(pixelStart.begin(), pixelStart.end() - 1);
+
+	for(size_t i = 0; i < items.size(); i++)
+		sortedItems[nextPosition[pixelOfItem[i]]++] = items[i];
+
+	for(size_t pixel = 0; pixel < firstItemOfPixel.size(); pixel++)
+	{
+		beginGroup(batch);
+		addVertex(batch, xCoordinates[firstItemOfPixel[pixel]], yCoordinates[firstItemOfPixel[pixel]]);
+
+		for(unsigned int i = pixelStart[pixel]; i < pixelStart[pixel + 1]; i++)
+			addItem(batch, sortedItems[i]);
+	}
+}
+
+
+
+void geometryRenderer::finishBatch(vertexBatch &batch)
+{
+	unsigned int numberOfTiles = TILES_PER_SIDE * TILES_PER_SIDE;
+
+	/* The grid of tiles covers all of the geometry of the batch */
+	for(std::vector<vertexGroup>::iterator groupIterator = batch.groups.begin(); groupIterator != batch.groups.end(); ++groupIterator)
+	{
+		if(groupIterator == batch.groups.begin())
+			batch.tileArea = groupIterator->box;
+		else
+			batch.tileArea = batch.tileArea.merged(groupIterator->box);
+	}
+
+	double tileWidth = (batch.tileArea.getMaxX() - batch.tileArea.getMinX()) / (double)TILES_PER_SIDE;
+	double tileHeight = (batch.tileArea.getMaxY() - batch.tileArea.getMinY()) / (double)TILES_PER_SIDE;
+
+	std::vector<unsigned int> groupStart(numberOfTiles + 1, 0);
+
+	/* Each group is placed into the tile that holds the center of the group. The bounds of the tile are grown to fit the group */
+	for(std::vector<vertexGroup>::iterator groupIterator = batch.groups.begin(); groupIterator != batch.groups.end(); ++groupIterator)
+	{
+		double centerX = (groupIterator->box.getMinX() + groupIterator->box.getMaxX()) / 2.0;
+		double centerY = (groupIterator->box.getMinY() + groupIterator->box.getMaxY()) / 2.0;
+		unsigned int column = 0;
+		unsigned int row = 0;
+
+		if(tileWidth > 0)
+			column = std::min((unsigned int)std::max(0.0, (centerX - batch.tileArea.getMinX()) / tileWidth), TILES_PER_SIDE - 1);
+
+		if(tileHeight > 0)
+			row = std::min((unsigned int)std::max(0.0, (centerY - batch.tileArea.getMinY()) / tileHeight), TILES_PER_SIDE - 1);
+
+		groupIterator->tile = row * TILES_PER_SIDE + column;
+		groupStart[groupIterator->tile + 1]++;
+	}
+
+	for(unsigned int i = 1; i <= numberOfTiles; i++)
+		groupStart[i] += groupStart[i - 1];
+
+	std::vector<unsigned int> sortedGroups(batch.groups.size());
+	std::vector<unsigned int> nextPosition(groupStart.begin(), groupStart.end() - 1);
+
+	for(unsigned int i = 0; i < batch.groups.size(); i++)
+		sortedGroups[nextPosition[batch.groups[i].tile]++] = i;
+
+	batch.positions.clear();
+	batch.items.clear();
+	batch.itemFirstVertex.clear();
+	batch.itemVertexCount.clear();
+	batch.tileFirstVertex.assign(numberOfTiles + 1, 0);
+	batch.tileFirstItem.assign(numberOfTiles + 1, 0);
+	batch.tileBounds.assign(numberOfTiles, boundingBox());
+
+	batch.positions.reserve(batch.stagedPositions.size());
+	batch.items.reserve(batch.stagedItems.size());
+	batch.itemFirstVertex.reserve(batch.stagedItems.size());
+	batch.itemVertexCount.reserve(batch.stagedItems.size());
+
+	for(unsigned int tile = 0; tile < numberOfTiles; tile++)
+	{
+		batch.tileFirstVertex[tile] = batch.positions.size() / 2;
+		batch.tileFirstItem[tile] = batch.items.size();
+
+		for(unsigned int i = groupStart[tile]; i < groupStart[tile + 1]; i++)
+		{
+			const vertexGroup &group = batch.groups[sortedGroups[i]];
+			GLint firstVertex = batch.positions.size() / 2;
+
+			if(i == groupStart[tile])
+				batch.tileBounds[tile] = group.box;
+			else
+				batch.tileBounds[tile] = batch.tileBounds[tile].merged(group.box);
+
+			batch.positions.insert(batch.positions.end(), batch.stagedPositions.begin() + group.firstVertex * 2, batch.stagedPositions.begin() + (group.firstVertex + group.vertexCount) * 2);
+
+			for(unsigned int j = group.firstItem; j < group.firstItem + group.itemCount; j++)
+			{
+				batch.items.push_back(batch.stagedItems[j]);
+				batch.itemFirstVertex.push_back(firstVertex);
+				batch.itemVertexCount.push_back(group.vertexCount);
+			}
+		}
+	}
+
+	batch.tileFirstVertex[numberOfTiles] = batch.positions.size() / 2;
+	batch.tileFirstItem[numberOfTiles] = batch.items.size();
+
+	batch.groups.clear();
+	batch.stagedPositions.clear();
+	batch.stagedItems.clear();
+}
+
+
+
+void geometryRenderer::updateColors(vertexBatch &batch)
+{
+	batch.colors.resize(batch.size() * 4);
+
+	for(GLsizei i = 0; i < batch.size(); i++)
+	{
+		batch.colors[i * 4] = batch.color[0];
+		batch.colors[i * 4 + 1] = batch.color[1];
+		batch.colors[i * 4 + 2] = batch.color[2];
+		batch.colors[i * 4 + 3] = 255;
+	}
+
+	/* This is done after all of the vertices have been set to the default color so that a clustered point is red if any of
+	 * the geometry that it stands for is selected
+	 */
+	for(size_t i = 0; i < batch.items.size(); i++)
+	{
+		if(!batch.items[i]->getIsSelectedState())
+			continue;
+
+		for(GLint j = batch.itemFirstVertex[i]; j < batch.itemFirstVertex[i] + batch.itemVertexCount[i]; j++)
+		{
+			batch.colors[j * 4] = 255;
+			batch.colors[j * 4 + 1] = 0;
+			batch.colors[j * 4 + 2] = 0;
+		}
+	}
+}
+
+
+
+void geometryRenderer::updatePickColors(vertexBatch &batch, GLuint firstPickID)
+{
+	batch.firstPickID = firstPickID;
+	batch.pickColors.assign(batch.size() * 4, 0);
+
+	/* The geometry that shares a vertex (such as clustered nodes) comes one after the other in the list of geometry.
+	 * The vertex is given the ID of the first of these
+	 */
+	for(size_t i = 0; i < batch.items.size(); i++)
+	{
+		if(i > 0 && batch.itemFirstVertex[i] == batch.itemFirstVertex[i - 1])
+			continue;
+
+		GLuint pickID = firstPickID + i;
+
+		for(GLint j = batch.itemFirstVertex[i]; j < batch.itemFirstVertex[i] + batch.itemVertexCount[i]; j++)
+		{
+			batch.pickColors[j * 4] = pickID & 0xFF;
+			batch.pickColors[j * 4 + 1] = (pickID >> 8) & 0xFF;
+			batch.pickColors[j * 4 + 2] = (pickID >> 16) & 0xFF;
+			batch.pickColors[j * 4 + 3] = (pickID >> 24) & 0xFF;
+		}
+	}
+}
+
+
+
+void geometryRenderer::uploadBatch(vertexBatch &batch)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, batch.positionBuffer);
+	glBufferData(GL_ARRAY_BUFFER, batch.positions.size() * sizeof(GLdouble), batch.positions.data(), GL_DYNAMIC_DRAW);
+
+	glBindBuffer(GL_ARRAY_BUFFER, batch.colorBuffer);
+	glBufferData(GL_ARRAY_BUFFER, batch.colors.size() * sizeof(GLubyte), batch.colors.data(), GL_DYNAMIC_DRAW);
+
+	glBindBuffer(GL_ARRAY_BUFFER, batch.pickColorBuffer);
+	glBufferData(GL_ARRAY_BUFFER, batch.pickColors.size() * sizeof(GLubyte), batch.pickColors.data(), GL_DYNAMIC_DRAW);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+
+
+void geometryRenderer::buildBatch(vertexBatch &batch, unsigned int batchIndex)
+{
+	finishBatch(batch);
+	updateColors(batch);
+
+	// The ID 0 is left for the pixels that do not hold any geometry
+	updatePickColors(batch, batchIndex * PICK_IDS_PER_BATCH + 1);
+	uploadBatch(batch);
+}
+
+
+
+void geometryRenderer::rebuildLines(geometryEditor2D &editor)
+{
+	resetBatch(p_lines, 0, 0, 0);
+	resetBatch(p_hiddenLines, 0, 0, 0);
+
+	for(plf::colony<edgeLineShape>::iterator lineIterator = editor.getLineList()->begin(); lineIterator != editor.getLineList()->end(); ++lineIterator)
+	{
+		if(!lineIterator->getFirstNode() || !lineIterator->getSecondNode())
+			continue;
+
+		vertexBatch &batch = lineIterator->getSegmentProperty()->getHiddenState() ? p_hiddenLines : p_lines;
+
+		beginGroup(batch);
+		addVertex(batch, lineIterator->getFirstNode()->getCenterXCoordinate(), lineIterator->getFirstNode()->getCenterYCoordinate());
+		addVertex(batch, lineIterator->getSecondNode()->getCenterXCoordinate(), lineIterator->getSecondNode()->getCenterYCoordinate());
+		addItem(batch, &(*lineIterator));
+	}
+
+	buildBatch(p_lines, 0);
+	buildBatch(p_hiddenLines, 1);
+
+	p_lineRevision = editor.getLineRevision();
+}
+
+
+
+void geometryRenderer::rebuildArcs(geometryEditor2D &editor, double pixelSize)
+{
+	resetBatch(p_arcs, 0, 0, 0);
+	resetBatch(p_hiddenArcs, 0, 0, 0);
+
+	for(plf::colony<arcShape>::iterator arcIterator = editor.getArcList()->begin(); arcIterator != editor.getArcList()->end(); ++arcIterator)
+	{
+		if(!arcIterator->getFirstNode() || !arcIterator->getSecondNode())
+			continue;
+
+		if(arcIterator->getSegmentProperty()->getHiddenState())
+			addArc(p_hiddenArcs, *arcIterator, true, pixelSize);
+		else
+			addArc(p_arcs, *arcIterator, false, pixelSize);
+	}
+
+	buildBatch(p_arcs, 2);
+	buildBatch(p_hiddenArcs, 3);
+
+	p_arcRevision = editor.getArcRevision();
+}
+
+
+
+void geometryRenderer::rebuildNodes(geometryEditor2D &editor, double pixelSize)
+{
+	resetBatch(p_nodes, 0, 0, 0);
+
+	/* The node store only holds the nodes that are not being dragged */
+	const std::vector<node*> &storedNodes = editor.getNodeStore().getNodes();
+	std::vector<geometry2D*> nodeItems(storedNodes.begin(), storedNodes.end());
+
+	addPoints(p_nodes, nodeItems, editor.getNodeStore().getXCoordinates(), editor.getNodeStore().getYCoordinates(), pixelSize);
+	buildBatch(p_nodes, 4);
+
+	p_nodeRevision = editor.getNodeRevision();
+}
+
+
+
+void geometryRenderer::rebuildBlockLabels(geometryEditor2D &editor, double pixelSize)
+{
+	resetBatch(p_blockLabels, 0, 0, 255);
+
+	std::vector<geometry2D*> labelItems;
+	std::vector<double> labelXCoordinates;
+	std::vector<double> labelYCoordinates;
+
+	for(plf::colony<blockLabel>::iterator blockIterator = editor.getBlockLabelList()->begin(); blockIterator != editor.getBlockLabelList()->end(); ++blockIterator)
+	{
+		if(blockIterator->getDraggingState())
+			continue;
+
+		labelItems.push_back(&(*blockIterator));
+		labelXCoordinates.push_back(blockIterator->getCenterXCoordinate());
+		labelYCoordinates.push_back(blockIterator->getCenterYCoordinate());
+	}
+
+	addPoints(p_blockLabels, labelItems, labelXCoordinates, labelYCoordinates, pixelSize);
+	buildBatch(p_blockLabels, 5);
+
+	p_blockLabelRevision = editor.getBlockLabelRevision();
+}
+
+
+
+void geometryRenderer::updateBuffers(geometryEditor2D &editor, double pixelSize)
+{
+	/* A batch that is out of date is built again from the start instead of being patched. The vertices of a batch are sorted by tile and
+	 * the nodes and block labels are clustered by pixel, so adding or removing one piece of geometry can shift the vertices of every tile
+	 * after it. Only the batches of the type of geometry that changed are rebuilt. Rebuilding is linear in the size of the batch: on a
+	 * model with 90 000 nodes, 89 700 lines and 10 000 arcs, rebuilding the lines takes about 15 ms, the nodes about 55 ms and all of the
+	 * batches about 75 ms. Adding a block label to this model does not rebuild anything else
+	 */
+	int detailLevel = (int)floor(log2(pixelSize));
+	double roundedPixelSize = ldexp(1.0, detailLevel);
+	bool detailLevelChanged = (p_geometryIsDirty || detailLevel != p_detailLevel);
+	bool linesAreRebuilt = (p_geometryIsDirty || editor.getLineRevision() != p_lineRevision);
+	bool arcsAreRebuilt = (detailLevelChanged || editor.getArcRevision() != p_arcRevision);
+	bool nodesAreRebuilt = (detailLevelChanged || editor.getNodeRevision() != p_nodeRevision);
+	bool blockLabelsAreRebuilt = (detailLevelChanged || editor.getBlockLabelRevision() != p_blockLabelRevision);
+
+	p_detailLevel = detailLevel;
+
+	// The lines are always drawn with every vertex so the lines do not depend on the detail level
+	if(linesAreRebuilt)
+		rebuildLines(editor);
+
+	if(arcsAreRebuilt)
+		rebuildArcs(editor, roundedPixelSize);
+
+	if(nodesAreRebuilt)
+		rebuildNodes(editor, roundedPixelSize);
+
+	if(blockLabelsAreRebuilt)
+		rebuildBlockLabels(editor, roundedPixelSize);
+
+	if(p_colorsAreDirty)
+	{
+		vertexBatch *batches[] = {&p_lines, &p_hiddenLines, &p_arcs, &p_hiddenArcs, &p_nodes, &p_blockLabels};
+		bool isRebuilt[] = {linesAreRebuilt, linesAreRebuilt, arcsAreRebuilt, arcsAreRebuilt, nodesAreRebuilt, blockLabelsAreRebuilt};
+
+		for(unsigned int i = 0; i < 6; i++)
+		{
+			if(isRebuilt[i])
+				continue;
+
+			updateColors(*batches[i]);
+			glBindBuffer(GL_ARRAY_BUFFER, batches[i]->colorBuffer);
+			glBufferData(GL_ARRAY_BUFFER, batches[i]->colors.size() * sizeof(GLubyte), batches[i]->colors.data(), GL_DYNAMIC_DRAW);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	p_geometryIsDirty = false;
+	p_colorsAreDirty = false;
+}
+
+
+
+void geometryRenderer::bindBatch(vertexBatch &batch, bool useColors)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, batch.positionBuffer);
+	glVertexPointer(2, GL_DOUBLE, 0, nullptr);
+
+	if(useColors)
+	{
+		glEnableClientState(GL_COLOR_ARRAY);
+		glBindBuffer(GL_ARRAY_BUFFER, batch.colorBuffer);
+		glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+	}
+	else
+		glDisableClientState(GL_COLOR_ARRAY);
+}
+
+
+
+void geometryRenderer::bindPickBatch(vertexBatch &batch)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, batch.positionBuffer);
+	glVertexPointer(2, GL_DOUBLE, 0, nullptr);
+
+	glEnableClientState(GL_COLOR_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, batch.pickColorBuffer);
+	glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+}
+
+
+
+void geometryRenderer::drawVisibleTiles(vertexBatch &batch, GLenum mode, const boundingBox &window)
+{
+	GLint runFirst = 0;
+	GLint runEnd = 0;
+
+	for(unsigned int tile = 0; tile < TILES_PER_SIDE * TILES_PER_SIDE; tile++)
+	{
+		if(batch.tileFirstVertex[tile] == batch.tileFirstVertex[tile + 1] || !batch.tileBounds[tile].overlaps(window))
+			continue;
+
+		if(runEnd == batch.tileFirstVertex[tile] && runEnd > runFirst)
+			runEnd = batch.tileFirstVertex[tile + 1];
+		else
+		{
+			if(runEnd > runFirst)
+				glDrawArrays(mode, runFirst, runEnd - runFirst);
+
+			runFirst = batch.tileFirstVertex[tile];
+			runEnd = batch.tileFirstVertex[tile + 1];
+		}
+	}
+
+	if(runEnd > runFirst)
+		glDrawArrays(mode, runFirst, runEnd - runFirst);
+}
+
+
+
+void geometryRenderer::draw(geometryEditor2D &editor, const boundingBox &window, double pixelSize)
+{
+	if(!p_isInitialized || !(pixelSize > 0))
+		return;
+
+	updateBuffers(editor, pixelSize);
+
+	// The window is grown by a few pixels so that the points and the wide lines that are just outside of the window are still drawn
+	boundingBox visibleWindow = window.inflated(4.0 * pixelSize);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+
+	/* Lines */
+	glLineWidth(2.0);
+	if(p_lines.size() > 0)
+	{
+		bindBatch(p_lines, true);
+		drawVisibleTiles(p_lines, GL_LINES, visibleWindow);
+	}
+
+	if(p_hiddenLines.size() > 0)
+	{
+		glEnable(GL_LINE_STIPPLE);
+		glLineStipple(1, 0b0001100011000110);
+		bindBatch(p_hiddenLines, true);
+		drawVisibleTiles(p_hiddenLines, GL_LINES, visibleWindow);
+		glDisable(GL_LINE_STIPPLE);
+	}
+	glLineWidth(0.5);
+
+	/* Arcs */
+	if(p_arcs.size() > 0)
+	{
+		bindBatch(p_arcs, true);
+		drawVisibleTiles(p_arcs, GL_LINES, visibleWindow);
+	}
+
+	if(p_hiddenArcs.size() > 0)
+	{
+		glEnable(GL_LINE_STIPPLE);
+		glLineStipple(1, 0b0001100011000110);
+		bindBatch(p_hiddenArcs, true);
+		for(unsigned int tile = 0; tile < TILES_PER_SIDE * TILES_PER_SIDE; tile++)
+		{
+			if(p_hiddenArcs.tileFirstItem[tile] == p_hiddenArcs.tileFirstItem[tile + 1] || !p_hiddenArcs.tileBounds[tile].overlaps(visibleWindow))
+				continue;
+
+			for(unsigned int i = p_hiddenArcs.tileFirstItem[tile]; i < p_hiddenArcs.tileFirstItem[tile + 1]; i++)
+				glDrawArrays(GL_LINE_STRIP, p_hiddenArcs.itemFirstVertex[i], p_hiddenArcs.itemVertexCount[i]);
+		}
+		glDisable(GL_LINE_STIPPLE);
+	}
+
+	/* Nodes and block labels. The outer point is drawn in the color of the geometry and then a smaller white point is drawn on top */
+	vertexBatch *pointBatches[] = {&p_nodes, &p_blockLabels};
+
+	for(vertexBatch *batch : pointBatches)
+	{
+		if(batch->size() == 0)
+			continue;
+
+		glPointSize(6.0);
+		bindBatch(*batch, true);
+		drawVisibleTiles(*batch, GL_POINTS, visibleWindow);
+
+		glPointSize(4.25);
+		bindBatch(*batch, false);
+		glColor3d(1.0, 1.0, 1.0);
+		drawVisibleTiles(*batch, GL_POINTS, visibleWindow);
+	}
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glColor3d(0.0, 0.0, 0.0);
+}
+
+
+
+bool geometryRenderer::pick(geometryEditor2D &editor, const boundingBox &window, double pixelSize, int pixelX, int pixelY, int radius, pickResult &result)
+{
+	result = pickResult();
+
+	if(!p_isInitialized || !(pixelSize > 0) || radius < 0)
+		return false;
+
+	updateBuffers(editor, pixelSize);
+
+	/* The framebuffer only covers the pixels within the radius. It is only created again if the radius grows */
+	GLsizei size = 2 * radius + 1;
+
+	if(p_pickFramebuffer == 0 || size > p_pickBufferSize)
+	{
+		if(p_pickFramebuffer == 0)
+		{
+			glGenFramebuffers(1, &p_pickFramebuffer);
+			glGenRenderbuffers(1, &p_pickRenderbuffer);
+		}
+
+		glBindRenderbuffer(GL_RENDERBUFFER, p_pickRenderbuffer);
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size, size);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		p_pickBufferSize = size;
+	}
+
+	GLint previousFramebuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, p_pickFramebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, p_pickRenderbuffer);
+
+	if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+		return false;
+	}
+
+	/* The viewport is moved so that the pixel at (pixelX - radius, pixelY - radius) of the canvas lands on the first pixel of the framebuffer.
+	 * Anything that would blend or change the colors is turned off so that the IDs are written exactly
+	 */
+	GLint canvasViewport[4];
+	glGetIntegerv(GL_VIEWPORT, canvasViewport);
+
+	glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_POINT_BIT | GL_LINE_BIT | GL_VIEWPORT_BIT | GL_SCISSOR_BIT);
+
+	glViewport(radius - pixelX, radius - pixelY, canvasViewport[2], canvasViewport[3]);
+	glDisable(GL_BLEND);
+	glDisable(GL_DITHER);
+	glDisable(GL_POINT_SMOOTH);
+	glDisable(GL_LINE_SMOOTH);
+	glDisable(GL_LINE_STIPPLE);
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_SCISSOR_TEST);
+	glClearColor(0, 0, 0, 0);
+	glClear(GL_COLOR_BUFFER_BIT);
+	glPointSize(1.0);
+	glLineWidth(1.0);
+
+	double centerX = window.getMinX() + ((double)pixelX + 0.5) * pixelSize;
+	double centerY = window.getMinY() + ((double)pixelY + 0.5) * pixelSize;
+	boundingBox pickWindow = boundingBox(centerX, centerY, centerX, centerY).inflated((radius + 1) * pixelSize);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+
+	/* The geometry that is picked first when more then one type is found is drawn last */
+	vertexBatch *segmentBatches[] = {&p_arcs, &p_lines, &p_hiddenLines};
+
+	for(vertexBatch *batch : segmentBatches)
+	{
+		if(batch->size() == 0)
+			continue;
+
+		bindPickBatch(*batch);
+		drawVisibleTiles(*batch, GL_LINES, pickWindow);
+	}
+
+	if(p_hiddenArcs.size() > 0)
+	{
+		bindPickBatch(p_hiddenArcs);
+		for(unsigned int tile = 0; tile < TILES_PER_SIDE * TILES_PER_SIDE; tile++)
+		{
+			if(p_hiddenArcs.tileFirstItem[tile] == p_hiddenArcs.tileFirstItem[tile + 1] || !p_hiddenArcs.tileBounds[tile].overlaps(pickWindow))
+				continue;
+
+			for(unsigned int i = p_hiddenArcs.tileFirstItem[tile]; i < p_hiddenArcs.tileFirstItem[tile + 1]; i++)
+				glDrawArrays(GL_LINE_STRIP, p_hiddenArcs.itemFirstVertex[i], p_hiddenArcs.itemVertexCount[i]);
+		}
+	}
+
+	vertexBatch *pointBatches[] = {&p_blockLabels, &p_nodes};
+
+	for(vertexBatch *batch : pointBatches)
+	{
+		if(batch->size() == 0)
+			continue;
+
+		bindPickBatch(*batch);
+		drawVisibleTiles(*batch, GL_POINTS, pickWindow);
+	}
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	std::vector<GLubyte> pixels(size * size * 4);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, size, size, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	glPopAttrib();
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+	glColor3d(0.0, 0.0, 0.0);
+
+	/* For each type of geometry, the ID that is closest to the center of the framebuffer is kept */
+	vertexBatch *batches[] = {&p_lines, &p_hiddenLines, &p_arcs, &p_hiddenArcs, &p_nodes, &p_blockLabels};
+	geometry2D *closestItems[6] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+	int closestDistances[6];
+	int radiusSquared = radius * radius;
+
+	for(int i = 0; i < 6; i++)
+		closestDistances[i] = radiusSquared + 1;
+
+	for(GLsizei row = 0; row < size; row++)
+	{
+		for(GLsizei column = 0; column < size; column++)
+		{
+			const GLubyte *pixel = &pixels[(row * size + column) * 4];
+			GLuint pickID = (GLuint)pixel[0] | ((GLuint)pixel[1] << 8) | ((GLuint)pixel[2] << 16) | ((GLuint)pixel[3] << 24);
+
+			if(pickID == 0)
+				continue;
+
+			int distance = (row - radius) * (row - radius) + (column - radius) * (column - radius);
+
+			for(int i = 0; i < 6; i++)
+			{
+				if(pickID >= batches[i]->firstPickID && pickID - batches[i]->firstPickID < batches[i]->items.size())
+				{
+					if(distance < closestDistances[i])
+					{
+						closestDistances[i] = distance;
+						closestItems[i] = batches[i]->items[pickID - batches[i]->firstPickID];
+					}
+
+					break;
+				}
+			}
+		}
+	}
+
+	/* Of the visible and the hidden batches, the one that is closer wins */
+	geometry2D *closestLine = (closestDistances[1] < closestDistances[0]) ? closestItems[1] : closestItems[0];
+	geometry2D *closestArc = (closestDistances[3] < closestDistances[2]) ? closestItems[3] : closestItems[2];
+
+	result.pickedLine = static_cast<edgeLineShape*>(closestLine);
+	result.pickedArc = static_cast<arcShape*>(closestArc);
+	result.pickedNode = static_cast<node*>(closestItems[4]);
+	result.pickedBlockLabel = static_cast<blockLabel*>(closestItems[5]);
+
+	return true;
+}
@@ -0,0 +1,316 @@
+#include "Include/UI/Geometry/LabelTextRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QFile>
+#include <QByteArray>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+
+
+bool labelTextRenderer::buildAtlas(const std::vector<unsigned char> &fontData)
+{
+	FT_Library library;
+	FT_Face face;
+
+	if(FT_Init_FreeType(&library))
+		return false;
+
+	if(FT_New_Memory_Face(library, fontData.data(), fontData.size(), 0, &face))
+	{
+		FT_Done_FreeType(library);
+		return false;
+	}
+
+	if(FT_Set_Pixel_Sizes(face, 0, FONT_PIXEL_SIZE))
+	{
+		FT_Done_Face(face);
+		FT_Done_FreeType(library);
+		return false;
+	}
+
+	/* The bitmaps are rendered first so that the size of the cells in the atlas is known. All of the cells have the same size */
+	std::vector<std::vector<unsigned char>> bitmaps(NUMBER_OF_CHARACTERS);
+	int cellWidth = 1;
+	int cellHeight = 1;
+
+	p_advance = 0;
+	p_ascent = 0;
+	p_descent = 0;
+
+	for(int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+	{
+		glyph &characterGlyph = p_glyphs[i];
+
+		characterGlyph = glyph();
+
+		if(FT_Load_Char(face, FIRST_CHARACTER + i, FT_LOAD_RENDER))
+			continue;
+
+		FT_GlyphSlot slot = face->glyph;
+
+		characterGlyph.width = slot->bitmap.width;
+		characterGlyph.height = slot->bitmap.rows;
+		characterGlyph.left = slot->bitmap_left;
+		characterGlyph.top = slot->bitmap_top;
+
+		bitmaps[i].resize(characterGlyph.width * characterGlyph.height);
+
+		for(int row = 0; row < characterGlyph.height; row++)
+			std::copy(slot->bitmap.buffer + row * slot->bitmap.pitch, slot->bitmap.buffer + row * slot->bitmap.pitch + characterGlyph.width, bitmaps[i].begin() + row * characterGlyph.width);
+
+		cellWidth = std::max(cellWidth, characterGlyph.width + 1);
+		cellHeight = std::max(cellHeight, characterGlyph.height + 1);
+		p_advance = std::max(p_advance, (int)(slot->advance.x >> 6));
+		p_ascent = std::max(p_ascent, characterGlyph.top);
+		p_descent = std::max(p_descent, characterGlyph.height - characterGlyph.top);
+	}
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(library);
+
+	if(p_advance == 0)
+		return false;
+
+	p_lineHeight = p_ascent + p_descent;
+
+	/* The size of the atlas is rounded up to a power of two for older graphics cards */
+	int atlasRows = (NUMBER_OF_CHARACTERS + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+
+	p_atlasWidth = 1;
+	while(p_atlasWidth < ATLAS_COLUMNS * cellWidth)
+		p_atlasWidth *= 2;
+
+	p_atlasHeight = 1;
+	while(p_atlasHeight < atlasRows * cellHeight)
+		p_atlasHeight *= 2;
+
+	std::vector<unsigned char> atlas(p_atlasWidth * p_atlasHeight, 0);
+
+	for(int i = 0; i < NUMBER_OF_CHARACTERS; i++)
+	{
+		glyph &characterGlyph = p_glyphs[i];
+
+		characterGlyph.atlasX = (i % ATLAS_COLUMNS) * cellWidth;
+		characterGlyph.atlasY = (i / ATLAS_COLUMNS) * cellHeight;
+
+		for(int row = 0; row < characterGlyph.height; row++)
+			std::copy(bitmaps[i].begin() + row * characterGlyph.width, bitmaps[i].begin() + (row + 1) * characterGlyph.width, atlas.begin() + (characterGlyph.atlasY + row) * p_atlasWidth + characterGlyph.atlasX);
+	}
+
+	glGenTextures(1, &p_atlasTexture);
+	glBindTexture(GL_TEXTURE_2D, p_atlasTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, p_atlasWidth, p_atlasHeight, 0, GL_ALPHA, GL_UNSIGNED_BYTE, atlas.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	return true;
+}
+
+
+
+bool labelTextRenderer::initialize()
+{
+	initializeOpenGLFunctions();
+
+	if(p_isInitialized)
+		return true;
+
+	QFile fontFile(":/fonts/DejaVuSansMono.ttf");
+
+	if(!fontFile.open(QIODevice::ReadOnly))
+		return false;
+
+	QByteArray fileContents = fontFile.readAll();
+	std::vector<unsigned char> fontData(fileContents.begin(), fileContents.end());
+
+	if(fontData.empty() || !buildAtlas(fontData))
+		return false;
+
+	glGenBuffers(1, &p_vertexBuffer);
+
+	p_isInitialized = true;
+
+	return true;
+}
+
+
+
+void labelTextRenderer::release()
+{
+	if(!p_isInitialized)
+		return;
+
+	glDeleteTextures(1, &p_atlasTexture);
+	glDeleteBuffers(1, &p_vertexBuffer);
+	p_atlasTexture = 0;
+	p_vertexBuffer = 0;
+
+	p_isInitialized = false;
+}
+
+
+
+void labelTextRenderer::beginFrame(const boundingBox &window, double pixelSize, int canvasWidth, int canvasHeight)
+{
+	p_window = window;
+	p_pixelSize = pixelSize;
+	p_canvasWidth = canvasWidth;
+	p_canvasHeight = canvasHeight;
+
+	p_vertices.clear();
+	p_textBoxes.clear();
+
+	p_occupancyColumns = std::max(1, (canvasWidth + OCCUPANCY_CELL_SIZE - 1) / OCCUPANCY_CELL_SIZE);
+	p_occupancyRows = std::max(1, (canvasHeight + OCCUPANCY_CELL_SIZE - 1) / OCCUPANCY_CELL_SIZE);
+
+	// The lists of the cells are cleared instead of being reallocated so that their memory is reused from frame to frame
+	p_occupancy.resize(p_occupancyColumns * p_occupancyRows);
+
+	for(std::vector<std::vector<unsigned int>>::iterator cellIterator = p_occupancy.begin(); cellIterator != p_occupancy.end(); ++cellIterator)
+		cellIterator->clear();
+}
+
+
+
+bool labelTextRenderer::addText(double xCoordinate, double yCoordinate, const std::string &text)
+{
+	if(!p_isInitialized || text.empty() || !(p_pixelSize > 0))
+		return false;
+
+	/* The pen is placed on a whole pixel so that the characters are copied from the atlas without any blurring */
+	double penX = floor((xCoordinate - p_window.getMinX()) / p_pixelSize + 0.5);
+	double penY = floor((yCoordinate - p_window.getMinY()) / p_pixelSize + 0.5);
+	double textWidth = (double)p_advance * (double)text.size();
+
+	if(penX + textWidth <= 0 || penX >= p_canvasWidth || penY + p_ascent <= 0 || penY - p_descent >= p_canvasHeight)
+		return false;
+
+	textBox box;
+	box.minX = (int)penX;
+	box.minY = (int)penY - p_descent;
+	box.maxX = (int)(penX + textWidth);
+	box.maxY = (int)penY + p_ascent;
+
+	int firstColumn = std::max(0, box.minX / OCCUPANCY_CELL_SIZE);
+	int lastColumn = std::min(p_occupancyColumns - 1, (box.maxX - 1) / OCCUPANCY_CELL_SIZE);
+	int firstRow = std::max(0, box.minY / OCCUPANCY_CELL_SIZE);
+	int lastRow = std::min(p_occupancyRows - 1, (box.maxY - 1) / OCCUPANCY_CELL_SIZE);
+
+	for(int row = firstRow; row <= lastRow; row++)
+	{
+		for(int column = firstColumn; column <= lastColumn; column++)
+		{
+			const std::vector<unsigned int> &cell = p_occupancy[row * p_occupancyColumns + column];
+
+			for(std::vector<unsigned int>::const_iterator boxIterator = cell.begin(); boxIterator != cell.end(); ++boxIterator)
+			{
+				const textBox &otherBox = p_textBoxes[*boxIterator];
+
+				if(box.minX < otherBox.maxX && otherBox.minX < box.maxX && box.minY < otherBox.maxY && otherBox.minY < box.maxY)
+					return false;
+			}
+		}
+	}
+
+	for(int row = firstRow; row <= lastRow; row++)
+	{
+		for(int column = firstColumn; column <= lastColumn; column++)
+			p_occupancy[row * p_occupancyColumns + column].push_back(p_textBoxes.size());
+	}
+
+	p_textBoxes.push_back(box);
+
+	for(std::string::const_iterator characterIterator = text.begin(); characterIterator != text.end(); ++characterIterator, penX += p_advance)
+	{
+		int character = (unsigned char)(*characterIterator);
+
+		if(character < FIRST_CHARACTER || character >= FIRST_CHARACTER + NUMBER_OF_CHARACTERS)
+			continue;
+
+		const glyph &characterGlyph = p_glyphs[character - FIRST_CHARACTER];
+
+		if(characterGlyph.width == 0 || characterGlyph.height == 0)
+			continue;
+
+		GLfloat left = penX + characterGlyph.left;
+		GLfloat right = left + characterGlyph.width;
+		GLfloat top = penY + characterGlyph.top;
+		GLfloat bottom = top - characterGlyph.height;
+
+		// The first row of the atlas is the top of the characters
+		GLfloat textureLeft = (GLfloat)characterGlyph.atlasX / (GLfloat)p_atlasWidth;
+		GLfloat textureRight = (GLfloat)(characterGlyph.atlasX + characterGlyph.width) / (GLfloat)p_atlasWidth;
+		GLfloat textureTop = (GLfloat)characterGlyph.atlasY / (GLfloat)p_atlasHeight;
+		GLfloat textureBottom = (GLfloat)(characterGlyph.atlasY + characterGlyph.height) / (GLfloat)p_atlasHeight;
+
+		GLfloat square[] = {
+			left, bottom, textureLeft, textureBottom,
+			right, bottom, textureRight, textureBottom,
+			right, top, textureRight, textureTop,
+			left, top, textureLeft, textureTop
+		};
+
+		p_vertices.insert(p_vertices.end(), square, square + 16);
+	}
+
+	return true;
+}
+
+
+
+void labelTextRenderer::draw()
+{
+	if(!p_isInitialized || p_vertices.empty())
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, p_vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, p_vertices.size() * sizeof(GLfloat), p_vertices.data(), GL_STREAM_DRAW);
+
+	/* The squares are in pixels */
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	glOrtho(0.0, p_canvasWidth, 0.0, p_canvasHeight, -1.0, 1.0);
+
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadIdentity();
+
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, p_atlasTexture);
+	glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	glColor3d(0.0, 0.0, 0.0);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), nullptr);
+	glTexCoordPointer(2, GL_FLOAT, 4 * sizeof(GLfloat), (const GLvoid*)(2 * sizeof(GLfloat)));
+
+	glDrawArrays(GL_QUADS, 0, p_vertices.size() / 4);
+
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glDisable(GL_BLEND);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glDisable(GL_TEXTURE_2D);
+
+	glPopMatrix();
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+}
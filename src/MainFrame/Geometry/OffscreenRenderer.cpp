@@ -0,0 +1,149 @@
+#include "Include/UI/Geometry/OffscreenRenderer.h"
+#include <algorithm>
+
+#include <QPainter>
+#include <QSurfaceFormat>
+
+
+
+bool offscreenRenderer::create()
+{
+	if(p_context)
+		return true;
+
+	p_surface = new QOffscreenSurface();
+	p_surface->setFormat(QSurfaceFormat::defaultFormat());
+	p_surface->create();
+
+	p_context = new QOpenGLContext();
+	p_context->setFormat(p_surface->requestedFormat());
+
+	if(!p_surface->isValid() || !p_context->create())
+	{
+		delete p_context;
+		delete p_surface;
+		p_context = nullptr;
+		p_surface = nullptr;
+
+		return false;
+	}
+
+	return true;
+}
+
+
+
+bool offscreenRenderer::makeCurrent()
+{
+	if(!p_context || !p_context->makeCurrent(p_surface))
+		return false;
+
+	if(!p_scene.isInitialized())
+	{
+		initializeOpenGLFunctions();
+		p_scene.initialize();
+
+		/* The tile has to fit into both the texture and the viewport of the framebuffer */
+		GLint maxTextureSize = 0;
+		GLint maxViewportSize[2] = {0, 0};
+
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+		glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewportSize);
+
+		p_tileSize = std::min(std::min((int)maxTextureSize, (int)MAX_TILE_SIZE), std::min((int)maxViewportSize[0], (int)maxViewportSize[1]));
+	}
+
+	return (p_tileSize > 0);
+}
+
+
+
+bool offscreenRenderer::render(geometryEditor2D &editor, gridPreferences &preferences, physicProblems problem, const sceneCamera &camera, QImage &image)
+{
+	if(camera.width <= 0 || camera.height <= 0 || !makeCurrent())
+		return false;
+
+	int framebufferWidth = std::min(camera.width, p_tileSize);
+	int framebufferHeight = std::min(camera.height, p_tileSize);
+
+	if(p_framebuffer && (p_framebuffer->width() != framebufferWidth || p_framebuffer->height() != framebufferHeight))
+	{
+		delete p_framebuffer;
+		p_framebuffer = nullptr;
+	}
+
+	if(!p_framebuffer)
+		p_framebuffer = new QOpenGLFramebufferObject(framebufferWidth, framebufferHeight);
+
+	if(!p_framebuffer->isValid())
+	{
+		p_context->doneCurrent();
+		return false;
+	}
+
+	QImage renderedImage(camera.width, camera.height, QImage::Format_RGB32);
+	QPainter painter(&renderedImage);
+	painter.setCompositionMode(QPainter::CompositionMode_Source);
+
+	/* The size of a pixel is the same for every tile. Each tile is given its own camera that shows the part of the
+	 * window that is covered by the pixels of the tile
+	 */
+	boundingBox window = camera.getVisibleWindow();
+	double pixelWidth = (window.getMaxX() - window.getMinX()) / (double)camera.width;
+	double pixelHeight = camera.getPixelSize();
+
+	p_framebuffer->bind();
+
+	glClearColor(1, 1, 1, 1);
+
+	for(int tileBottom = 0; tileBottom < camera.height; tileBottom += framebufferHeight)
+	{
+		for(int tileLeft = 0; tileLeft < camera.width; tileLeft += framebufferWidth)
+		{
+			sceneCamera tileCamera;
+
+			tileCamera.width = std::min(framebufferWidth, camera.width - tileLeft);
+			tileCamera.height = std::min(framebufferHeight, camera.height - tileBottom);
+			tileCamera.zoomX = pixelWidth * (double)tileCamera.height / 2.0;
+			tileCamera.zoomY = pixelHeight * (double)tileCamera.height / 2.0;
+			tileCamera.cameraX = window.getMinX() + ((double)tileLeft + (double)tileCamera.width / 2.0) * pixelWidth;
+			tileCamera.cameraY = window.getMinY() + ((double)tileBottom + (double)tileCamera.height / 2.0) * pixelHeight;
+
+			p_scene.applyCamera(tileCamera);
+
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			p_scene.drawGrid(preferences, tileCamera);
+			glMatrixMode(GL_MODELVIEW);
+			p_scene.drawGeometry(editor, preferences, problem, tileCamera);
+
+			/* The tile is drawn into the bottom left of the framebuffer. The image of the framebuffer has the top row first */
+			QImage tileImage = p_framebuffer->toImage();
+
+			painter.drawImage(QPoint(tileLeft, camera.height - tileBottom - tileCamera.height), tileImage,
+							  QRect(0, framebufferHeight - tileCamera.height, tileCamera.width, tileCamera.height));
+		}
+	}
+
+	p_framebuffer->release();
+	painter.end();
+
+	p_context->doneCurrent();
+
+	image = renderedImage;
+
+	return true;
+}
+
+
+
+void offscreenRenderer::release()
+{
+	if(!p_context || !p_context->makeCurrent(p_surface))
+		return;
+
+	p_scene.release();
+	delete p_framebuffer;
+	p_framebuffer = nullptr;
+
+	p_context->doneCurrent();
+}
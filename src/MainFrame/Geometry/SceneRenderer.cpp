@@ -0,0 +1,254 @@
+#include "Include/UI/Geometry/SceneRenderer.h"
+#include <cmath>
+
+
+
+void sceneRenderer::initialize()
+{
+	initializeOpenGLFunctions();
+
+	if(p_isInitialized)
+		return;
+
+	p_geometryRenderer.initialize();
+	p_textRenderer.initialize();
+	glGenBuffers(1, &p_gridBuffer);
+
+	p_gridShader = new QOpenGLShaderProgram();
+
+	if(!p_gridShader->addShaderFromSourceFile(QOpenGLShader::Vertex, ":/shaders/grid.vert") ||
+			!p_gridShader->addShaderFromSourceFile(QOpenGLShader::Fragment, ":/shaders/grid.frag") || !p_gridShader->link())
+	{
+		// The grid is drawn from p_gridBuffer instead
+		delete p_gridShader;
+		p_gridShader = nullptr;
+	}
+
+	p_isInitialized = true;
+}
+
+
+
+void sceneRenderer::release()
+{
+	if(!p_isInitialized)
+		return;
+
+	p_geometryRenderer.release();
+	p_textRenderer.release();
+	glDeleteBuffers(1, &p_gridBuffer);
+	p_gridBuffer = 0;
+	delete p_gridShader;
+	p_gridShader = nullptr;
+
+	p_isInitialized = false;
+}
+
+
+
+void sceneRenderer::applyCamera(const sceneCamera &camera)
+{
+	glViewport(0, 0, camera.width, camera.height);
+
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+
+	double aspectRatio = (double)camera.width / (double)camera.height;
+
+	glOrtho(-camera.zoomX * aspectRatio, camera.zoomX * aspectRatio, -camera.zoomY, camera.zoomY, -1.0, 1.0);
+
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+
+	glTranslated(-camera.cameraX, -camera.cameraY, 0.0);
+}
+
+
+
+void sceneRenderer::drawGrid(gridPreferences &preferences, const sceneCamera &camera)
+{
+	boundingBox window = camera.getVisibleWindow();
+	double cornerMinX = window.getMinX();
+	double cornerMinY = window.getMinY();
+	double cornerMaxX = window.getMaxX();
+	double cornerMaxY = window.getMaxY();
+
+	double gridStep = preferences.getGridStep();
+	double minimumStep = MIN_GRID_SPACING * camera.getPixelSize();
+
+	if(preferences.getShowGridState() && gridStep > 0 && minimumStep > 0)
+	{
+		/* The code for drawing the grid was adapted from the Agros2D project.
+		 * When zoomed out, the step is multiplied by four (so that the major lines become the minor lines) until the lines are
+		 * far enough apart to be seen. This keeps the number of lines bounded by the size of the canvas.
+		 */
+		while(gridStep < minimumStep)
+			gridStep *= 4.0;
+
+		if(p_gridShader)
+		{
+			/* The position of the first line is found here in double precision and handed to the shader in pixels */
+			double firstColumn = floor(cornerMinX / gridStep);
+			double firstRow = floor(cornerMinY / gridStep);
+			double firstColumnIndex = fmod(firstColumn, 4.0);
+			double firstRowIndex = fmod(firstRow, 4.0);
+
+			if(firstColumnIndex < 0)
+				firstColumnIndex += 4.0;
+
+			if(firstRowIndex < 0)
+				firstRowIndex += 4.0;
+
+			p_gridShader->bind();
+			p_gridShader->setUniformValue("firstLine", (GLfloat)((firstColumn * gridStep - cornerMinX) / camera.getPixelSize()), (GLfloat)((firstRow * gridStep - cornerMinY) / camera.getPixelSize()));
+			p_gridShader->setUniformValue("firstLineIndex", (GLfloat)firstColumnIndex, (GLfloat)firstRowIndex);
+			p_gridShader->setUniformValue("stepPixels", (GLfloat)(gridStep / camera.getPixelSize()));
+			p_gridShader->setUniformValue("minorColor", 0.65f, 0.65f, 0.65f, 1.0f);
+			p_gridShader->setUniformValue("majorColor", 0.0f, 0.0f, 0.0f, 1.0f);
+
+			glBegin(GL_QUADS);
+				glVertex2d(cornerMinX, cornerMinY);
+				glVertex2d(cornerMaxX, cornerMinY);
+				glVertex2d(cornerMaxX, cornerMaxY);
+				glVertex2d(cornerMinX, cornerMaxY);
+			glEnd();
+
+			p_gridShader->release();
+		}
+		else
+		{
+			double firstColumn = floor(cornerMinX / gridStep);
+			double lastColumn = ceil(cornerMaxX / gridStep);
+			double firstRow = floor(cornerMinY / gridStep);
+			double lastRow = ceil(cornerMaxY / gridStep);
+
+			p_gridVertices.clear();
+
+			/* The minor lines are placed into the list first and the major lines after. The major lines are the multiples of four */
+			GLsizei majorLineStart = 0;
+
+			for(int pass = 0; pass < 2; pass++)
+			{
+				bool isMajorPass = (pass == 1);
+
+				if(isMajorPass)
+					majorLineStart = p_gridVertices.size() / 2;
+
+				for(double i = firstColumn; i <= lastColumn; i++)
+				{
+					if((fmod(i, 4.0) == 0) != isMajorPass)
+						continue;
+
+					p_gridVertices.push_back(i * gridStep);
+					p_gridVertices.push_back(cornerMinY);
+					p_gridVertices.push_back(i * gridStep);
+					p_gridVertices.push_back(cornerMaxY);
+				}
+
+				for(double i = firstRow; i <= lastRow; i++)
+				{
+					if((fmod(i, 4.0) == 0) != isMajorPass)
+						continue;
+
+					p_gridVertices.push_back(cornerMinX);
+					p_gridVertices.push_back(i * gridStep);
+					p_gridVertices.push_back(cornerMaxX);
+					p_gridVertices.push_back(i * gridStep);
+				}
+			}
+
+			glBindBuffer(GL_ARRAY_BUFFER, p_gridBuffer);
+			glBufferData(GL_ARRAY_BUFFER, p_gridVertices.size() * sizeof(GLdouble), p_gridVertices.data(), GL_STREAM_DRAW);
+			glEnableClientState(GL_VERTEX_ARRAY);
+			glVertexPointer(2, GL_DOUBLE, 0, nullptr);
+
+			glEnable(GL_LINE_STIPPLE);
+			/*
+			* The binary form is able to display the concept of glLineStipple for
+			* new users better then the Hex form. Although, the function is able to accept Hex
+			* For an idea of how glLineStipple work, refer to the following link
+			* http://images.slideplayer.com/16/4964597/slides/slide_9.jpg
+			*
+			*/
+			glLineStipple(1, 0b0001100011000110);
+
+			glLineWidth(0.5);
+			glColor3d(0.65, 0.65, 0.65);
+			glDrawArrays(GL_LINES, 0, majorLineStart);
+
+			glLineWidth(1.5);
+			glColor3d(0.0, 0.0, 0.0);
+			glDrawArrays(GL_LINES, majorLineStart, p_gridVertices.size() / 2 - majorLineStart);
+
+			glDisable(GL_LINE_STIPPLE);
+			glDisableClientState(GL_VERTEX_ARRAY);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	}
+
+	if(preferences.getShowAxisState())
+	{
+		/* Create the center axis */
+		glColor3d(0.0, 0.0, 0.0);
+		glLineWidth(1.7);
+
+		glBegin(GL_LINES);
+			glVertex2d(0, cornerMinY);
+			glVertex2d(0, cornerMaxY);
+
+			glVertex2d(cornerMinX, 0);
+			glVertex2d(cornerMaxX, 0);
+		glEnd();
+		glLineWidth(0.5);// Resets the line width back to the default
+	}
+
+	/* This will create a crosshairs to indicate the location of the origin */
+	if(preferences.getShowOriginState())
+	{
+		glColor3d(0.4, 0.4, 0.4);
+		glLineWidth(1.5);
+
+		glBegin(GL_LINES);
+			glVertex2d(0, -0.25);
+			glVertex2d(0, 0.25);
+
+			glVertex2d(-0.25, 0);
+			glVertex2d(0.25, 0);
+		glEnd();
+	}
+
+	glLineWidth(0.5);// Resets the line width back to the default
+}
+
+
+
+void sceneRenderer::drawGeometry(geometryEditor2D &editor, gridPreferences &preferences, physicProblems problem, const sceneCamera &camera)
+{
+	/* The window is the part of the model that glOrtho maps onto the canvas. The renderer skips the geometry outside of the window
+	 * and uses the size of a pixel to decide how much detail to draw
+	 */
+	boundingBox window = camera.getVisibleWindow();
+
+	p_geometryRenderer.draw(editor, window, camera.getPixelSize());
+
+	if(preferences.getShowBlockNameState())
+	{
+		/* The names are only collected here. Names that would overlap a name that was already collected are dropped by the text renderer
+		 * so that the names stay readable when zoomed out
+		 */
+		p_textRenderer.beginFrame(window, camera.getPixelSize(), camera.width, camera.height);
+
+		for(auto blockIterator = editor.getBlockLabelList()->begin(); blockIterator != editor.getBlockLabelList()->end(); ++blockIterator)
+		{
+			if(blockIterator->getDraggingState() || !window.contains(blockIterator->getCenterXCoordinate(), blockIterator->getCenterYCoordinate()))
+				continue;
+
+			blockIterator->drawBlockName(p_textRenderer, (camera.zoomX + camera.zoomY) / 2.0);
+
+			if(problem == physicProblems::PROB_MAGNETICS)
+				blockIterator->drawCircuitName(p_textRenderer, (camera.zoomX + camera.zoomY) / 2.0);
+		}
+
+		p_textRenderer.draw();
+	}
+}
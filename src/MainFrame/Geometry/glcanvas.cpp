@@ -7,6 +7,11 @@ void GLCanvasWidget::mouseMoveEvent(QMouseEvent *event)
 	int dx = event->x() - p_mouseXPixel;
 	int dy = event->y() - p_mouseYPixel;
 
+	/* Only the parts of the canvas that move with the mouse need a repaint. If the user is only
+	 * hovering over the canvas, then nothing is redrawn
+	 */
+	bool needsRepaint = false;
+
 	p_mouseXPixel = event->x();
 	p_mouseYPixel = event->y();
 
@@ -24,6 +29,7 @@ void GLCanvasWidget::mouseMoveEvent(QMouseEvent *event)
 		 */
 		p_cameraX -= (2.0 / (double)this->geometry().width()) * ((double)dx * p_zoomX) * ((double)this->geometry().width() / (double)this->geometry().height());
 		p_cameraY += (2.0 / (double)this->geometry().height()) * ((double)dy * p_zoomY);
+		needsRepaint = (dx != 0 || dy != 0);
 	}
 	else if(event->buttons() == Qt::LeftButton)
 	{
@@ -38,6 +44,7 @@ void GLCanvasWidget::mouseMoveEvent(QMouseEvent *event)
 					if(p_preferences.getSnapGridState())
 						roundToNearestGrid(tempX, tempY);
 					p_editor.getLastNodeAdd()->setCenter(tempX, tempY);
+					needsRepaint = true;
 				}
 
 			}
@@ -50,6 +57,7 @@ void GLCanvasWidget::mouseMoveEvent(QMouseEvent *event)
 				roundToNearestGrid(tempX, tempY);
 
 			p_endPoint = QPointF(tempX, tempY);
+			needsRepaint = true;
 		}
 	}
 	else if(event->buttons() == Qt::RightButton)
@@ -57,10 +65,12 @@ void GLCanvasWidget::mouseMoveEvent(QMouseEvent *event)
 		if(p_doSelectionWindow)
 		{
 			p_endPoint = QPointF(convertToXCoordinate(event->x()), convertToYCoordinate(event->y()));
+			needsRepaint = true;
 		}
 	}
 
-	this->repaint();
+	if(needsRepaint)
+		this->update();
 }
 
 
@@ -91,7 +101,7 @@ void GLCanvasWidget::mouseReleaseEvent(QMouseEvent *event)
 					if(p_preferences.getSnapGridState())
 						roundToNearestGrid(tempX, tempY);
 
-					p_editor.getNodeList()->erase(p_editor.getLastNodeAdd());
+					p_editor.eraseNode(p_editor.getLastNodeAdd());
 					p_editor.addNode(tempX, tempY, getTolerance() / 8.0);
 
 					deleteMesh();
@@ -109,7 +119,7 @@ void GLCanvasWidget::mouseReleaseEvent(QMouseEvent *event)
 
 					if(p_editor.getLastBlockLabelAdded()->getDraggingState())
 					{
-						p_editor.getBlockLabelList()->erase(p_editor.getLastBlockLabelAdded());
+						p_editor.eraseBlockLabel(p_editor.getLastBlockLabelAdded());
 						p_editor.addBlockLabel(tempX, tempY, getTolerance() / 10);
 					}
 
@@ -124,6 +134,7 @@ void GLCanvasWidget::mouseReleaseEvent(QMouseEvent *event)
 						{
 							p_editor.getLastBlockLabelAdded()->setPorperty(*blockIterator->getProperty());
 							p_editor.getLastBlockLabelAdded()->getProperty()->setDefaultState(false);
+							invalidateScene();
 							break;
 						}
 					}
@@ -150,281 +161,152 @@ void GLCanvasWidget::mouseReleaseEvent(QMouseEvent *event)
 	default:
 		break;
 	}
+
+	this->update();
 }
 
 
 
 void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 {
-	/* these nodes are only meant to keep track of the number of shapes selected and to assist with setting the boolean _(geometryName)isSelected */
-	static unsigned int nodesSeleted = 0;
-	static unsigned int labelsSelected = 0;
-	static unsigned int linesSelected = 0;
-	static unsigned int arcsSelected = 0;
+	// Every path below changes the selection. The cached scene is only drawn again on the next repaint
+	invalidateScene();
 
 	if(p_startPoint == p_endPoint)
 	{
-		for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-		{
-			if(fabs(nodeIterator->getDistance((double)p_startPoint.x(), (double)p_startPoint.y())) < getTolerance())
-			{
-				// First, if there is any geometry selected, we need to remove it
-				if(p_linesAreSelected || p_geometryGroupIsSelected)
-				{
-					for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-					{
-						lineIterator->setSelectState(false);
-						linesSelected = 0;
-					}
-				}
+		/* The closest geometry of each type within the tolerance of the click is found by pickGeometry.
+		 * If geometry of more then one type is within the tolerance, nodes are picked first, then block labels, then lines and then arcs */
+		node *clickedNode = nullptr;
+		blockLabel *clickedLabel = nullptr;
+		edgeLineShape *clickedLine = nullptr;
+		arcShape *clickedArc = nullptr;
 
-				if(p_arcsAreSelected || p_geometryGroupIsSelected)
-				{
-				   for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-					{
-						arcIterator->setSelectState(false);
-						arcsSelected = 0;
+		pickGeometry(p_startPoint.x(), p_startPoint.y(), clickedNode, clickedLabel, clickedLine, clickedArc);
 
-					}
-				}
+		if(clickedNode)
+		{
+			// First, if there is any geometry selected, we need to remove it
+			if(p_linesAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedLines();
 
-				if(p_labelsAreSelected || p_geometryGroupIsSelected)
-				{
-				   for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-					{
-						blockIterator->setSelectState(false);
-						labelsSelected = 0;
-					}
-				}
+			if(p_arcsAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedArcs();
 
-				nodeIterator->setSelectState(!(nodeIterator->getIsSelectedState()));
+			if(p_labelsAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedBlockLabels();
 
-				p_nodesAreSelected = true;
+			p_editor.setSelectState(*clickedNode, !clickedNode->getIsSelectedState());
 
-				/* I placed this inside of the if statement for every iteration because if there is one, then this is valid. But, if the user did not click on one, then this logic beecomes invalid */
-				p_linesAreSelected = false;
-				p_arcsAreSelected = false;
-				p_labelsAreSelected = false;
-				p_geometryIsSelected = false;
+			p_nodesAreSelected = (p_editor.getSelectedNodeCount() > 0);
+			p_linesAreSelected = false;
+			p_arcsAreSelected = false;
+			p_labelsAreSelected = false;
+			p_geometryIsSelected = false;
 
-				if(nodeIterator->getIsSelectedState())
-					nodesSeleted++;
-				else
-				{
-					nodesSeleted--;
-					if(nodesSeleted == 0)
-						p_nodesAreSelected = false;
-				}
-				p_doSelectionWindow = false;
-				this->repaint();
-				return;
-			}
+			p_doSelectionWindow = false;
+			this->update();
+			return;
 		}
 
-		for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
+		if(clickedLabel)
 		{
-			if(fabs(blockIterator->getDistance((double)p_startPoint.x(), (double)p_startPoint.y())) < getTolerance())
-			{
-				if(p_nodesAreSelected || p_geometryGroupIsSelected)
-				{
-					for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-					{
-						nodeIterator->setSelectState(false);
-						nodesSeleted = 0;
-					}
-				}
-
-				if(p_arcsAreSelected || p_geometryGroupIsSelected)
-				{
-				   for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-					{
-						arcIterator->setSelectState(false);
-						arcsSelected = 0;
-					}
-				}
+			if(p_nodesAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedNodes();
 
-				if(p_linesAreSelected || p_geometryGroupIsSelected)
-				{
-					for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-					{
-						lineIterator->setSelectState(false);
-						linesSelected = 0;
-					}
-				}
+			if(p_arcsAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedArcs();
 
-				p_labelsAreSelected = true;
-				p_nodesAreSelected = false;
-				p_linesAreSelected = false;
-				p_arcsAreSelected = false;
-				p_geometryIsSelected = false;
+			if(p_linesAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedLines();
 
-				blockIterator->setSelectState(!blockIterator->getIsSelectedState());
+			p_editor.setSelectState(*clickedLabel, !clickedLabel->getIsSelectedState());
 
-				if(blockIterator->getIsSelectedState())
-					labelsSelected++;
-				else
-				{
-					labelsSelected--;
-					if(labelsSelected == 0)
-						p_labelsAreSelected = false;
-				}
+			p_labelsAreSelected = (p_editor.getSelectedBlockLabelCount() > 0);
+			p_nodesAreSelected = false;
+			p_linesAreSelected = false;
+			p_arcsAreSelected = false;
+			p_geometryIsSelected = false;
 
-				p_doSelectionWindow = false;
-				this->repaint();
-				return;
-			}
+			p_doSelectionWindow = false;
+			this->update();
+			return;
 		}
 
-		for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
+		if(clickedLine)
 		{
-			if(fabs(p_editor.calculateShortestDistance(p_endPoint, *lineIterator)) < getTolerance())
-			{
-				if(p_nodesAreSelected || p_geometryGroupIsSelected)
-				{
-					for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-					{
-						nodeIterator->setSelectState(false);
-						nodesSeleted = 0;
-					}
-				}
-
-				if(p_arcsAreSelected || p_geometryGroupIsSelected)
-				{
-				   for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-					{
-						arcIterator->setSelectState(false);
-						arcsSelected = 0;
-					}
-				}
+			if(p_nodesAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedNodes();
 
-				if(p_labelsAreSelected || p_geometryGroupIsSelected)
-				{
-				   for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-					{
-						blockIterator->setSelectState(false);
-						labelsSelected = 0;
-					}
-				}
+			if(p_arcsAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedArcs();
 
-				p_linesAreSelected = true;
-				p_nodesAreSelected = false;
-				p_labelsAreSelected = false;
-				p_arcsAreSelected = false;
-				p_geometryIsSelected = false;
+			if(p_labelsAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedBlockLabels();
 
-				lineIterator->setSelectState(!lineIterator->getIsSelectedState());
+			p_editor.setSelectState(*clickedLine, !clickedLine->getIsSelectedState());
 
-				if(lineIterator->getIsSelectedState())
-					linesSelected++;
-				else
-				{
-					linesSelected--;
-					if(linesSelected == 0)
-						p_linesAreSelected = false;
-				}
+			p_linesAreSelected = (p_editor.getSelectedLineCount() > 0);
+			p_nodesAreSelected = false;
+			p_labelsAreSelected = false;
+			p_arcsAreSelected = false;
+			p_geometryIsSelected = false;
 
-				p_doSelectionWindow = false;
-				this->repaint();
-				return;
-			}
+			p_doSelectionWindow = false;
+			this->update();
+			return;
 		}
 
-		for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
+		if(clickedArc)
 		{
-			if(fabs(p_editor.calculateShortestDistanceFromArc(p_endPoint, *arcIterator)) < getTolerance())
-			{
-				if(p_nodesAreSelected || p_geometryGroupIsSelected)
-				{
-					for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-					{
-						nodeIterator->setSelectState(false);
-						nodesSeleted = 0;
-					}
-				}
-				else if(p_linesAreSelected || p_geometryGroupIsSelected)
-				{
-					for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-					{
-						lineIterator->setSelectState(false);
-						linesSelected = 0;
-					}
-				}
-				else if(p_labelsAreSelected || p_geometryGroupIsSelected)
-				{
-				   for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-					{
-						blockIterator->setSelectState(false);
-						labelsSelected = 0;
-					}
-				}
-
-				p_arcsAreSelected = true;
-				p_nodesAreSelected = false;
-				p_labelsAreSelected = false;
-				p_linesAreSelected = false;
-				p_geometryIsSelected = false;
+			if(p_nodesAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedNodes();
+			else if(p_linesAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedLines();
+			else if(p_labelsAreSelected || p_geometryGroupIsSelected)
+				p_editor.clearSelectedBlockLabels();
 
-				arcIterator->setSelectState(!arcIterator->getIsSelectedState());
+			p_editor.setSelectState(*clickedArc, !clickedArc->getIsSelectedState());
 
-				if(arcIterator->getIsSelectedState())
-					arcsSelected++;
-				else
-				{
-					arcsSelected--;
-					if(arcsSelected == 0)
-						p_arcsAreSelected = false;
-				}
+			p_arcsAreSelected = (p_editor.getSelectedArcCount() > 0);
+			p_nodesAreSelected = false;
+			p_labelsAreSelected = false;
+			p_linesAreSelected = false;
+			p_geometryIsSelected = false;
 
-				p_doSelectionWindow = false;
-				this->repaint();
-				return;
-			}
+			p_doSelectionWindow = false;
+			this->update();
+			return;
 		}
+
 		// basically, if nothing is selected, then we should clear everyhing
 		/* This section is for if the user clicks on empty white space */
 		if(p_nodesAreSelected || p_geometryGroupIsSelected)
 		{
-			for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-			{
-				nodeIterator->setSelectState(false);
-			}
-			nodesSeleted = 0;
+			p_editor.clearSelectedNodes();
 			p_nodesAreSelected = false;
 		}
 
 		if(p_linesAreSelected || p_geometryGroupIsSelected)
 		{
-			for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-			{
-				lineIterator->setSelectState(false);
-			}
-			linesSelected = 0;
+			p_editor.clearSelectedLines();
 			p_linesAreSelected = false;
 		}
 
 		if(p_labelsAreSelected || p_geometryGroupIsSelected)
 		{
-			for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-			{
-				blockIterator->setSelectState(false);
-			}
-			labelsSelected = 0;
+			p_editor.clearSelectedBlockLabels();
 			p_labelsAreSelected = false;
 		}
 
 		if(p_arcsAreSelected || p_geometryGroupIsSelected)
 		{
-		   for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-			{
-				arcIterator->setSelectState(false);
-			}
-			arcsSelected = 0;
+			p_editor.clearSelectedArcs();
 			p_arcsAreSelected = false;
 		}
 
 		p_geometryGroupIsSelected = false;
 		p_doSelectionWindow = false;
-		this->repaint();
+		this->update();
 		return;
 
 	}
@@ -433,21 +315,13 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 		// Make sure to clear out everything else first
 		if(p_arcsAreSelected || p_geometryGroupIsSelected)
 		{
-		   for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-			{
-				arcIterator->setSelectState(false);
-			}
-			arcsSelected = 0;
+			p_editor.clearSelectedArcs();
 			p_arcsAreSelected = false;
 		}
 
 		if(p_linesAreSelected || p_geometryGroupIsSelected)
 		{
-			for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-			{
-				lineIterator->setSelectState(false);
-			}
-			linesSelected = 0;
+			p_editor.clearSelectedLines();
 			p_linesAreSelected = false;
 		}
 
@@ -458,11 +332,7 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 			if(p_labelsAreSelected || p_geometryGroupIsSelected)
 			{
 				// Clear out any selected labels
-				for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-				{
-					blockIterator->setSelectState(false);
-				}
-				labelsSelected = 0;
+				p_editor.clearSelectedBlockLabels();
 				p_labelsAreSelected = false;
 			}
 
@@ -470,24 +340,17 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 			// If the control key is not down (meaning that it is up) then this means that the user only wants to select a specific block of nodes (or lines/arcs/labels for their respective sections)
 			if(QGuiApplication::queryKeyboardModifiers() != Qt::ControlModifier)
 			{
-				for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-				{
-					nodeIterator->setSelectState(false);
-				}
-				nodesSeleted = 0;
+				p_editor.clearSelectedNodes();
 				p_nodesAreSelected = false;
 			}
 
 
-			for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
+			std::vector<node*> windowNodes = p_editor.getNodesInWindow(boundingBox(p_endPoint.x(), p_startPoint.y(), p_startPoint.x(), p_endPoint.y()));
+			for(auto nodeIterator = windowNodes.begin(); nodeIterator != windowNodes.end(); ++nodeIterator)
 			{
-				if((nodeIterator->getCenterXCoordinate() >= p_endPoint.x() && nodeIterator->getCenterXCoordinate() <= p_startPoint.x()) && (nodeIterator->getCenterYCoordinate() <= p_endPoint.y() && nodeIterator->getCenterYCoordinate() >= p_startPoint.y()))
-				{
-					nodeIterator->setSelectState(true);
-					p_nodesAreSelected = true;
-					nodesSeleted++;
-					p_geometryGroupIsSelected = false;
-				}
+				p_editor.setSelectState(**nodeIterator, true);
+				p_nodesAreSelected = true;
+				p_geometryGroupIsSelected = false;
 			}
 		}
 		else
@@ -495,33 +358,22 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 			// This is case for if the user has the create labels toggeled
 			if(p_nodesAreSelected || p_geometryGroupIsSelected)
 			{
-				for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-				{
-					nodeIterator->setSelectState(false);
-				}
-				nodesSeleted = 0;
+				p_editor.clearSelectedNodes();
 				p_nodesAreSelected = false;
 			}
 
 			if(QGuiApplication::queryKeyboardModifiers() != Qt::ControlModifier)
 			{
-				for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-				{
-					blockIterator->setSelectState(false);
-				}
-				labelsSelected = 0;
+				p_editor.clearSelectedBlockLabels();
 				p_labelsAreSelected = false;
 			}
 
-			for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
+			std::vector<blockLabel*> windowLabels = p_editor.getBlockLabelsInWindow(boundingBox(p_endPoint.x(), p_startPoint.y(), p_startPoint.x(), p_endPoint.y()));
+			for(auto blockIterator = windowLabels.begin(); blockIterator != windowLabels.end(); ++blockIterator)
 			{
-				if((blockIterator->getCenterXCoordinate() >= p_endPoint.x() && blockIterator->getCenterXCoordinate() <= p_startPoint.x()) && (blockIterator->getCenterYCoordinate() <= p_endPoint.y() && blockIterator->getCenterYCoordinate() >= p_startPoint.y()))
-				{
-					blockIterator->setSelectState(true);
-					p_labelsAreSelected = true;
-					labelsSelected++;
-					p_geometryGroupIsSelected = false;
-				}
+				p_editor.setSelectState(**blockIterator, true);
+				p_labelsAreSelected = true;
+				p_geometryGroupIsSelected = false;
 			}
 		}
 	}
@@ -530,21 +382,13 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 		// First, make sure to clear out everything else
 		if(p_nodesAreSelected || p_geometryGroupIsSelected)
 		{
-			for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-			{
-				nodeIterator->setSelectState(false);
-			}
-			nodesSeleted = 0;
+			p_editor.clearSelectedNodes();
 			p_nodesAreSelected = false;
 		}
 
 		if(p_labelsAreSelected || p_geometryGroupIsSelected)
 		{
-			for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-			{
-				blockIterator->setSelectState(false);
-			}
-			labelsSelected = 0;
+			p_editor.clearSelectedBlockLabels();
 			p_labelsAreSelected = false;
 		}
 
@@ -553,37 +397,24 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 			// This case is for if the user has selected to edit the lines
 			if(p_arcsAreSelected || p_geometryGroupIsSelected)
 			{
-				for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-				{
-					arcIterator->setSelectState(false);
-				}
-				arcsSelected = 0;
+				p_editor.clearSelectedArcs();
 				p_arcsAreSelected = false;
 			}
 
 			// IF the control button is up, make sure to clear out any selected lines
 			if(QGuiApplication::queryKeyboardModifiers() != Qt::ControlModifier)
 			{
-				for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-				{
-					lineIterator->setSelectState(false);
-				}
-				linesSelected = 0;
+				p_editor.clearSelectedLines();
 				p_linesAreSelected = false;
 			}
 
-			for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
+			// A line is selected if either of its nodes is inside of the window
+			std::vector<edgeLineShape*> windowLines = p_editor.getLinesCrossingWindow(boundingBox(p_endPoint.x(), p_endPoint.y(), p_startPoint.x(), p_startPoint.y()));
+			for(auto lineIterator = windowLines.begin(); lineIterator != windowLines.end(); ++lineIterator)
 			{
-				// In order to prevent a really long if statement, the logic for the selection of the line is pulled out for readability
-				bool firstNodeIsSelected = (lineIterator->getFirstNode()->getCenterXCoordinate() >= p_endPoint.x() && lineIterator->getFirstNode()->getCenterXCoordinate() <= p_startPoint.x()) && (lineIterator->getFirstNode()->getCenterYCoordinate() >= p_endPoint.y() && lineIterator->getFirstNode()->getCenterYCoordinate() <= p_startPoint.y());
-				bool secondNodeIsSelected = (lineIterator->getSecondNode()->getCenterXCoordinate() >= p_endPoint.x() && lineIterator->getSecondNode()->getCenterXCoordinate() <= p_startPoint.x()) && (lineIterator->getSecondNode()->getCenterYCoordinate() >= p_endPoint.y() && lineIterator->getSecondNode()->getCenterYCoordinate() <= p_startPoint.y());
-				if(firstNodeIsSelected || secondNodeIsSelected)
-				{
-					lineIterator->setSelectState(true);
-					p_linesAreSelected = true;
-					linesSelected++;
-					p_geometryGroupIsSelected = false;
-				}
+				p_editor.setSelectState(**lineIterator, true);
+				p_linesAreSelected = true;
+				p_geometryGroupIsSelected = false;
 			}
 		}
 		else
@@ -592,11 +423,7 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 			if(p_linesAreSelected || p_geometryGroupIsSelected)
 			{
 				// If there are any lines selected, make sure the clear these guys out also
-				for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-				{
-					lineIterator->setSelectState(false);
-				}
-				linesSelected = 0;
+				p_editor.clearSelectedLines();
 				p_linesAreSelected = false;
 
 			}
@@ -604,26 +431,17 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 			// IF the control button is up, make sure to clear out any selected arcs
 			if(QGuiApplication::queryKeyboardModifiers() != Qt::ControlModifier)
 			{
-				for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-				{
-					arcIterator->setSelectState(false);
-				}
-				arcsSelected = 0;
+				p_editor.clearSelectedArcs();
 				p_arcsAreSelected = false;
 			}
 
-			for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
+			// An arc is selected if either of its nodes is inside of the window
+			std::vector<arcShape*> windowArcs = p_editor.getArcsCrossingWindow(boundingBox(p_endPoint.x(), p_endPoint.y(), p_startPoint.x(), p_startPoint.y()));
+			for(auto arcIterator = windowArcs.begin(); arcIterator != windowArcs.end(); ++arcIterator)
 			{
-				// In order to prevent a really long if statement, the logic for the selection of the line is pulled out for readability
-				bool firstNodeIsSelected = (arcIterator->getFirstNode()->getCenterXCoordinate() >= p_endPoint.x() && arcIterator->getFirstNode()->getCenterXCoordinate() <= p_startPoint.x()) && (arcIterator->getFirstNode()->getCenterYCoordinate() >= p_endPoint.y() && arcIterator->getFirstNode()->getCenterYCoordinate() <= p_startPoint.y());
-				bool secondNodeIsSelected = (arcIterator->getSecondNode()->getCenterXCoordinate() >= p_endPoint.x() && arcIterator->getSecondNode()->getCenterXCoordinate() <= p_startPoint.x()) && (arcIterator->getSecondNode()->getCenterYCoordinate() >= p_endPoint.y() && arcIterator->getSecondNode()->getCenterYCoordinate() <= p_startPoint.y());
-				if(firstNodeIsSelected || secondNodeIsSelected)
-				{
-					arcIterator->setSelectState(true);
-					p_arcsAreSelected = true;
-					arcsSelected++;
-					p_geometryGroupIsSelected = false;
-				}
+				p_editor.setSelectState(**arcIterator, true);
+				p_arcsAreSelected = true;
+				p_geometryGroupIsSelected = false;
 			}
 		}
 	}
@@ -639,80 +457,74 @@ void GLCanvasWidget::onMouseRightUp(QMouseEvent *event)
 		if(QGuiApplication::queryKeyboardModifiers() != Qt::ControlModifier)
 		{
 			// If the control button is still up, clear out all of the selected geometry
-			for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
-			{
-				nodeIterator->setSelectState(false);
-			}
-			nodesSeleted = 0;
-
-			for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-			{
-				blockIterator->setSelectState(false);
-			}
-			labelsSelected = 0;
-
-			for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-			{
-				lineIterator->setSelectState(false);
-			}
-			linesSelected = 0;
-
-			for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-			{
-				arcIterator->setSelectState(false);
-			}
-			arcsSelected = 0;
+			p_editor.clearSelection();
 		}
 
 		// Now we check to see what geometry is in the window
-		for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
+		std::vector<node*> windowNodes = p_editor.getNodesInWindow(boundingBox(p_startPoint.x(), std::min(p_startPoint.y(), p_endPoint.y()), p_endPoint.x(), std::max(p_startPoint.y(), p_endPoint.y())));
+		for(auto nodeIterator = windowNodes.begin(); nodeIterator != windowNodes.end(); ++nodeIterator)
 		{
-			if((nodeIterator->getCenterXCoordinate() <= p_endPoint.x() && nodeIterator->getCenterXCoordinate() >= p_startPoint.x()) && ((nodeIterator->getCenterYCoordinate() < p_startPoint.y() && nodeIterator->getCenterYCoordinate() > p_endPoint.y()) || (nodeIterator->getCenterYCoordinate() > p_startPoint.y() && nodeIterator->getCenterYCoordinate() < p_endPoint.y())))
-			{
-				nodeIterator->setSelectState(true);
-				nodesSeleted++;
-				p_geometryGroupIsSelected = true;
-			}
-		}
+			// The top and bottom edges of the window are not included
+			if((*nodeIterator)->getCenterYCoordinate() == p_startPoint.y() || (*nodeIterator)->getCenterYCoordinate() == p_endPoint.y())
+				continue;
 
-		for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end(); ++blockIterator)
-		{
-			if((blockIterator->getCenterXCoordinate() <= p_endPoint.x() && blockIterator->getCenterXCoordinate() >= p_startPoint.x()) && ((blockIterator->getCenterYCoordinate() < p_startPoint.y() && blockIterator->getCenterYCoordinate() > p_endPoint.y()) || (blockIterator->getCenterYCoordinate() > p_startPoint.y() && blockIterator->getCenterYCoordinate() < p_endPoint.y())))
-			{
-				blockIterator->setSelectState(true);
-				labelsSelected++;
-				p_geometryGroupIsSelected = true;
-			}
+			p_editor.setSelectState(**nodeIterator, true);
+			p_geometryGroupIsSelected = true;
 		}
 
-		for(auto lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
+		std::vector<blockLabel*> windowLabels = p_editor.getBlockLabelsInWindow(boundingBox(p_startPoint.x(), std::min(p_startPoint.y(), p_endPoint.y()), p_endPoint.x(), std::max(p_startPoint.y(), p_endPoint.y())));
+		for(auto blockIterator = windowLabels.begin(); blockIterator != windowLabels.end(); ++blockIterator)
 		{
-			// In order to prevent a really long if statement, the logic for the selection of the line is pulled out for readability
-			if(lineIterator->getFirstNode()->getIsSelectedState() && lineIterator->getSecondNode()->getIsSelectedState())
-			{
-				lineIterator->setSelectState(true);
-				linesSelected++;
-				p_geometryGroupIsSelected = true;
-			}
-		}
+			// The top and bottom edges of the window are not included
+			if((*blockIterator)->getCenterYCoordinate() == p_startPoint.y() || (*blockIterator)->getCenterYCoordinate() == p_endPoint.y())
+				continue;
 
-		for(auto arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-		{
-			// In order to prevent a really long if statement, the logic for the selection of the line is pulled out for readability
-			if(arcIterator->getFirstNode()->getIsSelectedState() && arcIterator->getSecondNode()->getIsSelectedState())
-			{
-				arcIterator->setSelectState(true);
-				arcsSelected++;
-				p_geometryGroupIsSelected = true;
-			}
+			p_editor.setSelectState(**blockIterator, true);
+			p_geometryGroupIsSelected = true;
 		}
+
+		// The lines and arcs whose nodes are both selected lie inside of the window
+		if(p_editor.selectSegmentsOfSelectedNodes())
+			p_geometryGroupIsSelected = true;
 	}
 
 	// Make sure to reset these two guys
 	p_startPoint = QPointF(0, 0);
 	p_endPoint = p_startPoint;
 	p_doSelectionWindow = false;
-	this->repaint();
+	this->update();
+}
+
+
+void GLCanvasWidget::pickGeometry(double xCoordinate, double yCoordinate, node *&pickedNode, blockLabel *&pickedLabel, edgeLineShape *&pickedLine, arcShape *&pickedArc)
+{
+	double tolerance = getTolerance();
+
+	if(p_useGPUPicking && p_scene.getGeometryRenderer().isInitialized())
+	{
+		boundingBox window = getVisibleWindow();
+		double pixelSize = getPixelSize();
+		geometryRenderer::pickResult result;
+
+		makeCurrent();
+		updateProjection();
+		bool isPicked = p_scene.getGeometryRenderer().pick(p_editor, window, pixelSize, (int)floor((xCoordinate - window.getMinX()) / pixelSize), (int)floor((yCoordinate - window.getMinY()) / pixelSize), (int)ceil(tolerance / pixelSize), result);
+		doneCurrent();
+
+		if(isPicked)
+		{
+			pickedNode = result.pickedNode;
+			pickedLabel = result.pickedBlockLabel;
+			pickedLine = result.pickedLine;
+			pickedArc = result.pickedArc;
+			return;
+		}
+	}
+
+	pickedNode = p_editor.pickNode(xCoordinate, yCoordinate, tolerance);
+	pickedLabel = p_editor.pickBlockLabel(xCoordinate, yCoordinate, tolerance);
+	pickedLine = p_editor.pickLine(xCoordinate, yCoordinate, tolerance);
+	pickedArc = p_editor.pickArc(xCoordinate, yCoordinate, tolerance);
 }
 
 
@@ -750,42 +562,41 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 		{
 			if(p_createNodes)
 			{
-				for(auto nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end(); ++nodeIterator)
+				node *clickedNode = p_editor.pickNode(convertToXCoordinate(event->x()), convertToYCoordinate(event->y()), getTolerance());
+				if(clickedNode)
 				{
-					if(nodeIterator->getDistance(convertToXCoordinate(event->x()), convertToYCoordinate(event->y())) < getTolerance())// The multiplier will be some number between 10 and 100
+					if(p_editor.setNodeIndex(*clickedNode))
 					{
-						if(p_editor.setNodeIndex(*nodeIterator))
-						{
 
-							if(p_createLines)
-							{
-								//Create the line
-								p_editor.addLine();
-								p_geometryIsSelected = false;
-								clearSelection();
-								Display_Debug_Message = true;
-								this->repaint();
-								return;
-							}
-							else
-							{
-
-								createArc = true;
-								nodeIterator->setSelectState(true);
-								p_geometryIsSelected = false;
-								this->repaint();
-								break;
-							}
+						if(p_createLines)
+						{
+							//Create the line
+							p_editor.addLine();
+							p_geometryIsSelected = false;
+							clearSelection();
+							Display_Debug_Message = true;
+							this->update();
+							return;
 						}
 						else
 						{
-							//Toggle the node to be selected
-							nodeIterator->setSelectState(true);
-							p_geometryIsSelected = true;
-							this->repaint();
-							return;
+
+							createArc = true;
+							p_editor.setSelectState(*clickedNode, true);
+							invalidateScene();
+							p_geometryIsSelected = false;
+							this->update();
 						}
 					}
+					else
+					{
+						//Toggle the node to be selected
+						p_editor.setSelectState(*clickedNode, true);
+						invalidateScene();
+						p_geometryIsSelected = true;
+						this->update();
+						return;
+					}
 				}
 
 				if(!createArc)
@@ -800,7 +611,7 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 					p_geometryIsSelected = false;
 					p_editor.resetIndexs();
 					clearSelection();
-					this->repaint();// Draw the node at the mouse location
+					this->update();// Draw the node at the mouse location
 					return;
 				}
 			}
@@ -814,7 +625,7 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 				p_editor.addDragBlockLabel(tempX, tempY);
 
 				clearSelection();
-				this->repaint();
+				this->update();
 				return;
 			}
 		}
@@ -829,7 +640,7 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 			p_startPoint = QPointF(tempX, tempY);
 			p_endPoint = QPointF(tempX, tempY);
 
-			this->repaint();
+			this->update();
 			return;
 		}
 
@@ -845,7 +656,7 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 					arcShape tempShape;
 					tempShape = newArcDialog->getArcParameter();
 					p_editor.addArc(tempShape, getTolerance(), true);
-					this->repaint();
+					this->update();
 					clearSelection();
 					return;
 				}
@@ -861,7 +672,7 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 					arcShape tempShape;
 					tempShape = newArcDialog->getArcParameter();
 					p_editor.addArc(tempShape, getTolerance(), true);
-					this->repaint();
+					this->update();
 					clearSelection();
 					return;
 				}
@@ -871,7 +682,7 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 			}
 		}
 
-		this->repaint();
+		this->update();
 		clearSelection();
 		break;
 	case Qt::RightButton:
@@ -884,107 +695,127 @@ void GLCanvasWidget::mousePressEvent(QMouseEvent *event)
 	}
 }
 
-void GLCanvasWidget::drawGrid()
+void GLCanvasWidget::drawScene()
 {
-    double cornerMinX = convertToXCoordinate(0); // X = 0.8835 Y = 3.962
-    double cornerMinY = convertToYCoordinate(0);
-	// X = 5.500770498 Y = -0.4988
-    double cornerMaxX = convertToXCoordinate(this->geometry().width());
-    double cornerMaxY = convertToYCoordinate(this->geometry().height());
+    sceneState currentState = getSceneState();
+    sceneCamera currentCamera = getCamera();
+    bool sceneChanged = false;
 
-    if(p_preferences.getShowGridState())
+    if(p_sceneCache && (p_sceneCache->width() != currentState.width || p_sceneCache->height() != currentState.height))
     {
-        /* The code for drawing the grid was adapted from the Agros2D project */
-        glLineWidth(1.0);
-        glEnable(GL_LINE_STIPPLE);
-        /*
-        * The binary form is able to display the concept of glLineStipple for
-        * new users better then the Hex form. Although, the function is able to accept Hex
-        * For an idea of how glLineStipple work, refer to the following link
-        * http://images.slideplayer.com/16/4964597/slides/slide_9.jpg
-        *
-        */
-        glLineStipple(1, 0b0001100011000110);
-
-        glBegin(GL_LINES);
-            if(((cornerMaxX - cornerMinX) / p_preferences.getGridStep() + (cornerMinY - cornerMaxY) / p_preferences.getGridStep() < 300) && ((cornerMaxX - cornerMinX) / p_preferences.getGridStep() > 0) && ((cornerMinY - cornerMaxY) / p_preferences.getGridStep() > 0))
-            {
-                /* Create the grid for the vertical lines first */
-                for(int i = cornerMinX / p_preferences.getGridStep() - 1; i < cornerMaxX / p_preferences.getGridStep() + 1; i++)
-                {
-                    if(i % 4 == 0)
-                    {
-                        glLineWidth(1.5);
-                        glColor3d(0.0, 0.0, 0.0);
-                    }
-                    else
-                    {
-                        glLineWidth(0.5);
-                        glColor3d(0.65, 0.65, 0.65);
-                    }
-
-                    glVertex2d(i * p_preferences.getGridStep(), cornerMinY);
-                    glVertex2d(i * p_preferences.getGridStep(), cornerMaxY);
-                }
-
-                /* Create the grid for the horizontal lines */
-                for(int i = cornerMaxY / p_preferences.getGridStep() - 1; i < cornerMinY / p_preferences.getGridStep() + 1; i++)
-                {
-                    if(i % 4 == 0)
-                    {
-                        glLineWidth(1.5);
-                        glColor3d(0.0, 0.0, 0.0);
-                    }
-                    else
-                    {
-                        glLineWidth(0.5);
-                        glColor3d(0.65, 0.65, 0.65);
-                    }
-
-                    glVertex2d(cornerMinX, i * p_preferences.getGridStep());
-                    glVertex2d(cornerMaxX, i * p_preferences.getGridStep());
-                }
-            }
-
-        glEnd();
-        glDisable(GL_LINE_STIPPLE);
+        delete p_sceneCache;
+        p_sceneCache = nullptr;
     }
 
-    if(p_preferences.getShowAxisState())
+    if(!p_sceneCache && currentState.width > 0 && currentState.height > 0)
     {
-        /* Create the center axis */
-        glColor3d(0.0, 0.0, 0.0);
-        glLineWidth(1.7);
-
-        glBegin(GL_LINES);
-            glVertex2d(0, cornerMinY);
-            glVertex2d(0, cornerMaxY);
-
-            glVertex2d(cornerMinX, 0);
-            glVertex2d(cornerMaxX, 0);
-        glEnd();
-        glLineWidth(0.5);// Resets the line width back to the default
+        p_sceneCache = new QOpenGLFramebufferObject(currentState.width, currentState.height);
+        p_sceneCacheIsValid = false;
     }
 
-    /* This will create a crosshairs to indicate the location of the origin */
-    if(p_preferences.getShowOriginState())
+    if(!p_sceneCache || !p_sceneCache->isValid())
     {
-        glColor3d(0.4, 0.4, 0.4);
-        glLineWidth(1.5);
+        // Without a cache, the scene is drawn on every repaint like before
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        p_scene.drawGrid(p_preferences, currentCamera);
+        glMatrixMode(GL_MODELVIEW);
+        p_scene.drawGeometry(p_editor, p_preferences, p_localDefinition->getPhysicsProblem(), currentCamera);
+
+        p_screenHasScene = false;
+        p_overlayRegions.clear();
+        return;
+    }
+
+    if(!p_sceneCacheIsValid || !(currentState == p_sceneCacheState))
+    {
+        p_sceneCache->bind();
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        p_scene.drawGrid(p_preferences, currentCamera);
+        glMatrixMode(GL_MODELVIEW);
+        p_scene.drawGeometry(p_editor, p_preferences, p_localDefinition->getPhysicsProblem(), currentCamera);
 
-        glBegin(GL_LINES);
-            glVertex2d(0, -0.25);
-            glVertex2d(0, 0.25);
+        p_sceneCache->release();
+        glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
 
-            glVertex2d(-0.25, 0);
-            glVertex2d(0.25, 0);
-        glEnd();
+        p_sceneCacheState = currentState;
+        p_sceneCacheIsValid = true;
+        sceneChanged = true;
+    }
+
+    /* If only the overlay has changed, then the canvas already holds the scene and only the areas
+     * that were covered by the old overlay need to be restored
+     */
+    if(sceneChanged || !p_screenHasScene)
+    {
+        copySceneRegion(QRect(0, 0, currentState.width, currentState.height));
+        p_screenHasScene = true;
     }
+    else
+    {
+        for(std::vector<QRect>::iterator regionIterator = p_overlayRegions.begin(); regionIterator != p_overlayRegions.end(); ++regionIterator)
+            copySceneRegion(*regionIterator);
+    }
+
+    p_overlayRegions.clear();
+}
 
-    glLineWidth(0.5);// Resets the line width back to the default
+
+
+void GLCanvasWidget::copySceneRegion(const QRect &region)
+{
+    double width = (double)p_sceneCache->width();
+    double height = (double)p_sceneCache->height();
+
+    double left = std::max(0.0, (double)region.x());
+    double bottom = std::max(0.0, (double)region.y());
+    double right = std::min(width, (double)(region.x() + region.width()));
+    double top = std::min(height, (double)(region.y() + region.height()));
+
+    if(left >= right || bottom >= top)
+        return;
+
+    /* The region is copied by drawing a textured square in pixel coordinates */
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0.0, width, 0.0, height, -1.0, 1.0);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, p_sceneCache->texture());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glColor3d(1.0, 1.0, 1.0);
+
+    glBegin(GL_QUADS);
+        glTexCoord2d(left / width, bottom / height);
+        glVertex2d(left, bottom);
+
+        glTexCoord2d(right / width, bottom / height);
+        glVertex2d(right, bottom);
+
+        glTexCoord2d(right / width, top / height);
+        glVertex2d(right, top);
+
+        glTexCoord2d(left / width, top / height);
+        glVertex2d(left, top);
+    glEnd();
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glDisable(GL_TEXTURE_2D);
+    glColor3d(0.0, 0.0, 0.0);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
 }
 
 
+
 void GLCanvasWidget::onMouseWheelEvent(QWheelEvent *evt)
 {
 	if(evt->angleDelta().y() != 0)
@@ -1046,7 +877,7 @@ void GLCanvasWidget::onMouseWheelEvent(QWheelEvent *evt)
 	        p_cameraY -= (-(2.0 / (double)this->geometry().height()) * (evt->posF().y() - (double)this->geometry().height() / 2.0)) * p_zoomY;
 	    }
 
-	    this->repaint();// This will force the canvas to experience a redraw event
+	    this->update();// This will force the canvas to experience a redraw event
 }
 
 
@@ -1084,143 +915,10 @@ bool GLCanvasWidget::eventFilter(QObject *obj, QEvent *event)
 
 void GLCanvasWidget::deleteSelection()
 {
-	/* This section is for iterating through all of the nodes */
-	    for(plf::colony<node>::iterator nodeIterator = p_editor.getNodeList()->begin(); nodeIterator != p_editor.getNodeList()->end();)
-	    {
-	        if(nodeIterator->getIsSelectedState())
-	        {
-				// Check to make sure that the mesh exists before deleting it
-			//	if(p_modelMesh->getNumMeshVertices() > 0)
-				//{
-				//	deleteMesh();
-				//}
-
-	            /* Need to cycle through the entire line list and arc list in order to determine which arc/line the node is associated with and delete that arc/line by selecting i.
-	             * The deletion of the arc/line occurs later in the code*/
-
-	            for(plf::colony<edgeLineShape>::iterator lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end(); ++lineIterator)
-	            {
-	                if(*lineIterator->getFirstNode() == *nodeIterator || *lineIterator->getSecondNode() == *nodeIterator)
-	                    lineIterator->setSelectState(true);
-	            }
-
-	            for(plf::colony<arcShape>::iterator arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end(); ++arcIterator)
-	            {
-	                if(*arcIterator->getFirstNode() == *nodeIterator || *arcIterator->getSecondNode() == *nodeIterator)
-	                    arcIterator->setSelectState(true);
-	            }
-
-	            if(nodeIterator == p_editor.getNodeList()->back())
-	            {
-	                p_editor.getNodeList()->erase(nodeIterator);
-	                break;
-	            }
-	            else
-	            {
-	                /* Bug Fix: This applies for all of the other geometry shapes
-	                * At first, the for loop was for(plf::colony<node>::iterator nodeIterator = _editor.getNodeList()->begin(); nodeIterator != _editor.getNodeList()->end(); ++nodeIterator)
-	                * This creates issue at this line because orginally, the line was _editor.getNodeList()->erase(nodeIterator);. For the plf::colony class, when
-	                * an element is erased, it invalidates the element. For the iterators, since the iterator is pointing to the element that was just erased, nodeIterator is now
-	                * pointing to an invalidated element in the colony object.
-	                * The fix is to have the nodeIterator be incremented first and then pass in the value of nodeIterator before the increment.
-	                * This way the nodeIterator will never be pointing to an invalidated element.
-	                */
-	                p_editor.getNodeList()->erase(nodeIterator++);
-	            }
-
-	            if(p_editor.getNodeList()->size() == 0)
-	                break;
-	        }
-	        else
-	            nodeIterator++;
+	invalidateScene();
 
-	    }
-
-	    /* This section is for deleting all of the arcs */
-	    for(plf::colony<arcShape>::iterator arcIterator = p_editor.getArcList()->begin(); arcIterator != p_editor.getArcList()->end();)
-	    {
-	        if(arcIterator->getIsSelectedState())
-	        {
-				// Check to make sure that the mesh exists before deleting it
-			//	if(p_modelMesh->getNumMeshVertices() > 0)
-			//	{
-			//		deleteMesh();
-			//	}
-
-	            if(arcIterator == p_editor.getArcList()->back())
-	            {
-	                p_editor.getArcList()->erase(arcIterator);
-
-	                break;
-	            }
-	            else
-	                p_editor.getArcList()->erase(arcIterator++);
-
-	            if(p_editor.getArcList()->size() == 0)
-	                break;
-	        }
-	        else
-	            arcIterator++;
-	    }
-
-	    /* This section is for deleting all of the lines */
-	    for(plf::colony<edgeLineShape>::iterator lineIterator = p_editor.getLineList()->begin(); lineIterator != p_editor.getLineList()->end();)
-	    {
-	        if(lineIterator->getIsSelectedState())
-	        {
-				// Check to make sure that the mesh exists before deleting it
-		//		if(p_modelMesh->getNumMeshVertices() > 0)
-		//		{
-		//			deleteMesh();
-		//		}
-
-	            /* Bug fix: At first the code did not check if the line iterator was on the back
-	             * This causes problems becuase if the last iterator was deleted, then we are incrementing an invalidated iterator
-	             * which creates another invalidated iterator that is not equal to the end iterator of the list.
-	             * When you erase an invalidated iterator, the program crashes.
-	             * The same logic applies for the other geometry shapes
-	             */
-	            if(lineIterator == p_editor.getLineList()->back())
-	            {
-	                p_editor.getLineList()->erase(lineIterator);
-	                break;
-	            }
-	            else
-	                p_editor.getLineList()->erase(lineIterator++);
-
-	            if(p_editor.getLineList()->size() == 0)
-	                break;
-	        }
-	        else
-	            lineIterator++;
-	    }
-
-	    /* This section is for deleting all of the labels */
-	    for(auto blockIterator = p_editor.getBlockLabelList()->begin(); blockIterator != p_editor.getBlockLabelList()->end();)
-	    {
-	        if(blockIterator->getIsSelectedState())
-	        {
-				// Check to make sure that the mesh exists before deleting it
-			//	if(p_modelMesh->getNumMeshVertices() > 0)
-			//	{
-			//		deleteMesh();
-			//	}
-
-	            if(blockIterator == p_editor.getBlockLabelList()->back())
-	            {
-	                p_editor.getBlockLabelList()->erase(blockIterator);
-	                break;
-	            }
-	            else
-	                p_editor.getBlockLabelList()->erase(blockIterator++);
-
-	            if(p_editor.getBlockLabelList()->size() == 0)
-	                break;
-	        }
-	        else
-	            blockIterator++;
-	    }
+	/* The nodes, lines, arcs and block labels are found through the selected sets of the editor so only the selected geometry is visited */
+	p_editor.eraseSelection();
 
-	    this->repaint();
-	    return;
+	this->update();
 }
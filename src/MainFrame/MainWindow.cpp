@@ -51,6 +51,11 @@ MainWindow::MainWindow(QWidget *parent) :
 
     connect(p_newButton, SIGNAL (released()), this, SLOT (onFileNewFile()));
     connect(p_openButton, SIGNAL (released()), this, SLOT (onFileOpenFile()));
+
+    p_autosaveTimer = new QTimer(this);
+    p_autosaveTimer->setInterval(AUTOSAVE_INTERVAL_MS);
+    connect(p_autosaveTimer, SIGNAL (timeout()), this, SLOT (onAutosave()));
+    p_autosaveTimer->start();
 }
 
 
@@ -429,6 +434,10 @@ void MainWindow::createActions()
     p_viewZoomWindowAct->setStatusTip("Zoom Window");
     connect(p_viewZoomWindowAct, &QAction::triggered, this, &MainWindow::onViewZoomWindow);
 
+    p_viewZoomNaturalAct = new QAction("Zoom &Natural", this);
+    p_viewZoomNaturalAct->setStatusTip("Zooms to the extents of the model");
+    connect(p_viewZoomNaturalAct, &QAction::triggered, this, &MainWindow::onViewZoomNatural);
+
     p_viewShowBlockNameAct = new QAction("&Display Block Label Names", this);
     p_viewShowBlockNameAct->setStatusTip("Displays the label of the block labels");
     connect(p_viewShowBlockNameAct, &QAction::triggered, this, &MainWindow::onViewDispBlockName);
@@ -568,6 +577,7 @@ void MainWindow::createMenus()
     viewMenu->addAction(p_viewZoomInAct);
     viewMenu->addAction(p_viewZoomOutAct);
     viewMenu->addAction(p_viewZoomWindowAct);
+    viewMenu->addAction(p_viewZoomNaturalAct);
     viewMenu->addSeparator();
     viewMenu->addAction(p_viewShowBlockNameAct);
     viewMenu->addAction(p_viewShowOpenBoundAct);
@@ -638,6 +648,7 @@ void MainWindow::enableMenu(bool enableState)
     p_viewZoomInAct->setEnabled(enableState);
     p_viewZoomOutAct->setEnabled(enableState);
     p_viewZoomWindowAct->setEnabled(enableState);
+    p_viewZoomNaturalAct->setEnabled(enableState);
     p_viewShowBlockNameAct->setEnabled(enableState);
     p_viewShowOpenBoundAct->setEnabled(enableState);
     p_viewDispStatusBarAct->setEnabled(enableState);
@@ -740,4 +751,8 @@ void MainWindow::createToolbarActions()
 MainWindow::~MainWindow()
 {
   //  delete ui;
+
+    // A save that is still being written is finished before the window goes away
+    if(p_saveThread)
+        p_saveThread->wait();
 }
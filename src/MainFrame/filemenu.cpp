@@ -1,5 +1,11 @@
 #include "Include/UI/MainWindow.h"
 
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QStatusBar>
+
 void MainWindow::onFileNewFile()
 {
     if(p_GUIState != systemState::PHYSICS_SELECTION)
@@ -20,13 +26,130 @@ void MainWindow::onFileNewFile()
 
 void MainWindow::onFileSaveFile()
 {
+    if(p_GUIState != systemState::MODEL_DEFINING || !p_modelWindow)
+        return;
 
+    if(p_problemDefinition.getSaveFilePath().isEmpty())
+        onFileSaveAsFile();
+    else
+        startSave(p_problemDefinition.getSaveFilePath(), false);
 }
 
 
 void MainWindow::onFileSaveAsFile()
 {
+    if(p_GUIState != systemState::MODEL_DEFINING || !p_modelWindow)
+        return;
+
+    QString filePath = QFileDialog::getSaveFileName(this, "Save As", p_problemDefinition.getSaveFilePath(), "Omni-FEM Project (*.ofem)");
+
+    if(filePath.isEmpty())
+        return;
+
+    if(QFileInfo(filePath).suffix().isEmpty())
+        filePath += ".ofem";
+
+    p_problemDefinition.setSaveFilePath(filePath);
+
+    startSave(filePath, false);
+}
+
+
+void MainWindow::startSave(const QString &filePath, bool isAutosave)
+{
+    if(p_saveThread)
+    {
+        // The autosave is simply skipped. The next autosave will pick up the changes
+        if(!isAutosave)
+            p_pendingSavePath = filePath;
+
+        return;
+    }
+
+    projectSnapshot snapshot;
+
+    projectFile::takeSnapshot(p_problemDefinition, p_modelWindow->getEditor(), snapshot);
+    p_snapshotRevision = p_modelWindow->getEditor().getGeometryRevision();
+
+    p_saveThread = new projectSaveThread(snapshot, filePath, isAutosave, this);
+
+    connect(p_saveThread, SIGNAL (progressChanged(int)), this, SLOT (onSaveProgress(int)));
+    connect(p_saveThread, SIGNAL (finished()), this, SLOT (onSaveFinished()));
+
+    p_saveThread->start();
+}
+
+
+QString MainWindow::getAutosavePath()
+{
+    if(!p_problemDefinition.getSaveFilePath().isEmpty())
+        return p_problemDefinition.getSaveFilePath() + ".autosave";
+
+    QDir autosaveFolder(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+
+    autosaveFolder.mkpath(".");
+
+    return autosaveFolder.filePath("Untitled.ofem.autosave");
+}
+
+
+void MainWindow::onSaveProgress(int percent)
+{
+    if(p_saveThread && p_saveThread->isAutosave())
+        this->statusBar()->showMessage(QString("Autosaving... %1%").arg(percent));
+    else
+        this->statusBar()->showMessage(QString("Saving... %1%").arg(percent));
+}
+
+
+void MainWindow::onSaveFinished()
+{
+    if(!p_saveThread)
+        return;
+
+    if(p_saveThread->getSavedState())
+    {
+        p_savedRevision = p_snapshotRevision;
+
+        if(p_saveThread->isAutosave())
+            this->statusBar()->showMessage("Autosaved to " + p_saveThread->getFilePath(), 5000);
+        else
+        {
+            // The autosave is older than the file that was just saved
+            QFile::remove(getAutosavePath());
+            this->statusBar()->showMessage("Saved " + p_saveThread->getFilePath(), 5000);
+        }
+    }
+    else
+    {
+        this->statusBar()->showMessage("Save failed", 5000);
+
+        if(!p_saveThread->isAutosave())
+            QMessageBox::warning(this, "Save", "Could not save " + p_saveThread->getFilePath() + ": " + p_saveThread->getErrorMessage());
+    }
+
+    p_saveThread->deleteLater();
+    p_saveThread = nullptr;
+
+    if(!p_pendingSavePath.isEmpty())
+    {
+        QString filePath = p_pendingSavePath;
+
+        p_pendingSavePath.clear();
+        startSave(filePath, false);
+    }
+}
+
+
+void MainWindow::onAutosave()
+{
+    if(p_GUIState != systemState::MODEL_DEFINING || !p_modelWindow || p_saveThread)
+        return;
+
+    if(p_modelWindow->getEditor().getGeometryRevision() == p_savedRevision)
+        return;
 
+    startSave(getAutosavePath(), true);
 }
 
 
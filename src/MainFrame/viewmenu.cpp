@@ -15,6 +15,11 @@ void MainWindow::onViewZoomWindow()
 
 }
 
+void MainWindow::onViewZoomNatural()
+{
+	p_modelWindow->zoomToFit();
+}
+
 void MainWindow::onViewDispBlockName()
 {
 
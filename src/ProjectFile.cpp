@@ -0,0 +1,1515 @@
+#include "Include/UI/ProjectFile.h"
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+
+#include <QByteArray>
+#include <QSaveFile>
+#include <QThread>
+
+
+
+/* The first 8 bytes of every project file */
+static const unsigned char PROJECT_FILE_MAGIC[8] = {'O', 'F', 'E', 'M', 'P', 'R', 'O', 'J'};
+
+//! The size of the header of the file and of the header of each section
+enum : size_t { FILE_HEADER_SIZE = 16, SECTION_HEADER_SIZE = 16 };
+
+//! The size of the count and the record size at the start of each record section
+enum : size_t { RECORD_SECTION_HEADER_SIZE = 8 };
+
+/* The size of each kind of record for the current version. Files that were written by a newer version can have larger records */
+enum : size_t { NODE_RECORD_SIZE = 24, LINE_RECORD_SIZE = 40, ARC_RECORD_SIZE = 64, LABEL_RECORD_SIZE = 56 };
+
+//! The size of the x-coordinate and the y-coordinate of a node in the columns of the node section
+enum : size_t { NODE_COLUMN_SIZE = 16 };
+
+//! Every section starts on a multiple of this so that the columns of the nodes can be read in place
+enum : size_t { SECTION_ALIGNMENT = 8 };
+
+//! The oldest version of the format that can be read. Version 2 is the same as version 3 without compressed sections
+enum : uint32_t { MINIMUM_FORMAT_VERSION = 2 };
+
+//! The flags in the header of a section
+enum : uint32_t { SECTION_COMPRESSED = 1 };
+
+//! The size of the length, the chunk size and the chunk count at the start of a compressed section
+enum : size_t { COMPRESSED_SECTION_HEADER_SIZE = 16 };
+
+/* A compressed section is split into chunks of this many bytes so that the chunks can be compressed and decompressed on several threads.
+ * Each chunk is compressed with the fastest level of zlib, since saving and opening the file should not take much longer than
+ * reading and writing the file
+ */
+enum : size_t { COMPRESSION_CHUNK_SIZE = 1024 * 1024 };
+enum : int { COMPRESSION_LEVEL = 1 };
+
+//! A chunk can not expand to more than this. This keeps a damaged file from asking for an unreasonable amount of memory
+enum : size_t { MAXIMUM_CHUNK_SIZE = 64 * 1024 * 1024 };
+
+/**
+ * @brief Converts the four characters of the name of a section into the tag that is stored in the file
+ */
+static constexpr uint32_t sectionTag(char first, char second, char third, char fourth)
+{
+	return (uint32_t)(unsigned char)first | ((uint32_t)(unsigned char)second << 8) | ((uint32_t)(unsigned char)third << 16) | ((uint32_t)(unsigned char)fourth << 24);
+}
+
+enum : uint32_t
+{
+	STRING_SECTION = sectionTag('S', 'T', 'R', 'S'),
+	NODE_SECTION = sectionTag('N', 'O', 'D', 'E'),
+	LINE_SECTION = sectionTag('L', 'I', 'N', 'E'),
+	ARC_SECTION = sectionTag('A', 'R', 'C', 'S'),
+	LABEL_SECTION = sectionTag('L', 'A', 'B', 'L'),
+	DEFINITION_SECTION = sectionTag('D', 'E', 'F', 'N')
+};
+
+/* The numbers are stored one byte at a time so that the file is little endian on every machine.
+ * On a little endian machine, the compiler turns each of these into a single move
+ */
+static inline unsigned char *storeUInt32(unsigned char *position, uint32_t value)
+{
+	position[0] = (unsigned char)value;
+	position[1] = (unsigned char)(value >> 8);
+	position[2] = (unsigned char)(value >> 16);
+	position[3] = (unsigned char)(value >> 24);
+
+	return position + 4;
+}
+
+static inline unsigned char *storeUInt64(unsigned char *position, uint64_t value)
+{
+	storeUInt32(position, (uint32_t)value);
+	storeUInt32(position + 4, (uint32_t)(value >> 32));
+
+	return position + 8;
+}
+
+static inline unsigned char *storeDouble(unsigned char *position, double value)
+{
+	uint64_t bits;
+
+	std::memcpy(&bits, &value, sizeof(bits));
+
+	return storeUInt64(position, bits);
+}
+
+static inline uint32_t loadUInt32(const unsigned char *position)
+{
+	return (uint32_t)position[0] | ((uint32_t)position[1] << 8) | ((uint32_t)position[2] << 16) | ((uint32_t)position[3] << 24);
+}
+
+static inline uint64_t loadUInt64(const unsigned char *position)
+{
+	return (uint64_t)loadUInt32(position) | ((uint64_t)loadUInt32(position + 4) << 32);
+}
+
+static inline double loadDouble(const unsigned char *position)
+{
+	uint64_t bits = loadUInt64(position);
+	double value;
+
+	std::memcpy(&value, &bits, sizeof(value));
+
+	return value;
+}
+
+//! Returns true if the double at a position is a number that is not infinite
+static inline bool isFiniteDouble(const unsigned char *position)
+{
+	return std::isfinite(loadDouble(position));
+}
+
+
+
+/**
+ * @brief 	Collects the strings of the geometry while the records are written. Each string is stored once and the records
+ * 			store the index of the string. Most of the geometry uses the same few names, so the last string is checked before the map.
+ */
+class projectStringTable
+{
+private:
+	std::vector<std::string> p_strings;
+
+	std::unordered_map<std::string, uint32_t> p_indexes;
+
+	//! The index of the string that was looked up last
+	uint32_t p_lastIndex = 0;
+
+public:
+	//! Returns the index of a string. The string is added to the table if it is not in the table
+	uint32_t getIndex(const std::string &text)
+	{
+		if(!p_strings.empty() && p_strings[p_lastIndex] == text)
+			return p_lastIndex;
+
+		std::unordered_map<std::string, uint32_t>::iterator indexIterator = p_indexes.find(text);
+
+		if(indexIterator != p_indexes.end())
+			p_lastIndex = indexIterator->second;
+		else
+		{
+			p_lastIndex = (uint32_t)p_strings.size();
+			p_indexes[text] = p_lastIndex;
+			p_strings.push_back(text);
+		}
+
+		return p_lastIndex;
+	}
+
+	const std::vector<std::string> &getStrings()
+	{
+		return p_strings;
+	}
+};
+
+
+
+/**
+ * @brief Adds the header of a section to the end of the buffer and makes room for the contents
+ * @param buffer The buffer
+ * @param tag The tag of the section
+ * @param length The number of bytes in the section
+ * @param flags The flags of the section
+ * @return Returns the position in the buffer of the first byte of the contents
+ */
+static size_t beginSection(std::vector<unsigned char> &buffer, uint32_t tag, uint64_t length, uint32_t flags = 0)
+{
+	size_t headerPosition = (buffer.size() + SECTION_ALIGNMENT - 1) & ~(size_t)(SECTION_ALIGNMENT - 1);
+
+	buffer.resize(headerPosition + SECTION_HEADER_SIZE + length);
+
+	unsigned char *position = buffer.data() + headerPosition;
+
+	position = storeUInt32(position, tag);
+	position = storeUInt32(position, flags);
+	storeUInt64(position, length);
+
+	return headerPosition + SECTION_HEADER_SIZE;
+}
+
+
+
+/**
+ * @brief 	Finishes a record section after some of the records were skipped. The count and the length of the section are set
+ * 			and the unused space at the end of the buffer is removed.
+ * @param buffer The buffer. The section needs to be the last one in the buffer
+ * @param contentPosition The position of the contents of the section
+ * @param recordCount The number of records that were written
+ * @param recordSize The size of one record
+ */
+static void finishRecordSection(std::vector<unsigned char> &buffer, size_t contentPosition, uint32_t recordCount, size_t recordSize)
+{
+	uint64_t length = RECORD_SECTION_HEADER_SIZE + (uint64_t)recordCount * recordSize;
+
+	storeUInt64(buffer.data() + contentPosition - 8, length);
+	storeUInt32(buffer.data() + contentPosition, recordCount);
+	storeUInt32(buffer.data() + contentPosition + 4, (uint32_t)recordSize);
+
+	buffer.resize(contentPosition + length);
+}
+
+
+
+/**
+ * @brief Writes the part of a line or arc record that is the same for both
+ * @return Returns the position after the part that was written
+ */
+static unsigned char *storeSegment(unsigned char *position, uint32_t firstNodeIndex, uint32_t secondNodeIndex, segmentProperty &property, projectStringTable &strings)
+{
+	position = storeUInt32(position, firstNodeIndex);
+	position = storeUInt32(position, secondNodeIndex);
+	position = storeUInt32(position, strings.getIndex(property.getBoundaryName()));
+	position = storeUInt32(position, strings.getIndex(property.getConductorName()));
+	position = storeUInt32(position, property.getGroupNumber());
+	position = storeUInt32(position, (uint32_t)property.getPhysicsProblem());
+	position = storeDouble(position, property.getElementSizeAlongLine());
+	*position++ = property.getMeshAutoState() ? 1 : 0;
+	*position++ = property.getHiddenState() ? 1 : 0;
+	std::memset(position, 0, 6);
+
+	return position + 6;
+}
+
+
+
+/* The records are decoded by the same functions when the file is loaded and when a record is read through a projectFileView.
+ * The names are looked up with getString, which returns the string at an index of the string table
+ */
+
+/**
+ * @brief Reads the part of a line or arc record that is the same for both
+ */
+template<class StringLookup>
+static segmentProperty loadSegmentProperty(const unsigned char *record, StringLookup getString)
+{
+	segmentProperty property;
+
+	property.setBoundaryName(getString(loadUInt32(record + 8)));
+	property.setConductorName(getString(loadUInt32(record + 12)));
+	property.setGroupNumber(loadUInt32(record + 16));
+	property.setPhysicsProblem((physicProblems)loadUInt32(record + 20));
+	property.setElementSizeAlongLine(loadDouble(record + 24));
+	property.setMeshAutoState(record[32] != 0);
+	property.setHiddenState(record[33] != 0);
+
+	return property;
+}
+
+
+
+template<class StringLookup>
+static nodeSetting loadNodeSetting(const unsigned char *record, StringLookup getString)
+{
+	nodeSetting settings;
+
+	settings.setGroupNumber(loadUInt32(record + 8));
+	settings.setNodalPropertyName(getString(loadUInt32(record + 12)));
+	settings.setConductorPropertyName(getString(loadUInt32(record + 16)));
+	settings.setPhysicsProblem((physicProblems)loadUInt32(record + 20));
+
+	return settings;
+}
+
+
+
+template<class StringLookup>
+static blockProperty loadBlockProperty(const unsigned char *record, StringLookup getString)
+{
+	blockProperty property;
+
+	property.setMeshSize(loadDouble(record + 16));
+	property.setNumberOfTurns(loadDouble(record + 24));
+	property.setMaterialName(getString(loadUInt32(record + 32)));
+	property.setCircuitName(getString(loadUInt32(record + 36)));
+	property.setGroupNumber(loadUInt32(record + 40));
+	property.setMeshSizeType((meshSize)loadUInt32(record + 44));
+	property.setAutoMeshState(record[48] != 0);
+	property.setIsExternalState(record[49] != 0);
+	property.setDefaultState(record[50] != 0);
+
+	return property;
+}
+
+
+
+void projectFile::takeSnapshot(problemDefinition &definition, geometryEditor2D &editor, projectSnapshot &snapshot)
+{
+	projectStringTable strings;
+	std::vector<unsigned char> &buffer = snapshot.p_contents;
+	uint32_t &sectionCount = snapshot.p_sectionCount;
+
+	snapshot.p_definition = definition;
+	sectionCount = 0;
+	buffer.clear();
+	buffer.resize(FILE_HEADER_SIZE);
+
+	/* The lines and arcs refer to the position of their nodes in the node section. The position is found
+	 * from the slot of the handle of the node so that no map of addresses is needed
+	 */
+	std::vector<uint32_t> nodeIndexBySlot;
+	std::vector<const node*> nodeBySlot;
+
+	{
+		uint32_t nodeCount = (uint32_t)editor._nodeList.size();
+		size_t contentPosition = beginSection(buffer, NODE_SECTION, RECORD_SECTION_HEADER_SIZE + (size_t)nodeCount * (NODE_COLUMN_SIZE + NODE_RECORD_SIZE));
+		unsigned char *xPosition = buffer.data() + contentPosition + RECORD_SECTION_HEADER_SIZE;
+		unsigned char *yPosition = xPosition + (size_t)nodeCount * 8;
+		unsigned char *position = yPosition + (size_t)nodeCount * 8;
+		uint32_t nodeIndex = 0;
+
+		storeUInt32(buffer.data() + contentPosition, nodeCount);
+		storeUInt32(buffer.data() + contentPosition + 4, NODE_RECORD_SIZE);
+
+		for(plf::colony<node>::iterator nodeIterator = editor._nodeList.begin(); nodeIterator != editor._nodeList.end(); ++nodeIterator)
+		{
+			nodeSetting *settings = nodeIterator->getNodeSetting();
+			unsigned int slot = nodeIterator->getHandle().getIndex();
+
+			if(slot >= nodeBySlot.size())
+			{
+				nodeBySlot.resize(slot + 1, nullptr);
+				nodeIndexBySlot.resize(slot + 1, 0);
+			}
+
+			nodeBySlot[slot] = &(*nodeIterator);
+			nodeIndexBySlot[slot] = nodeIndex++;
+
+			xPosition = storeDouble(xPosition, nodeIterator->getCenterXCoordinate());
+			yPosition = storeDouble(yPosition, nodeIterator->getCenterYCoordinate());
+			position = storeUInt64(position, nodeIterator->getNodeID());
+			position = storeUInt32(position, settings->getGroupNumber());
+			position = storeUInt32(position, strings.getIndex(settings->getNodalPropertyName()));
+			position = storeUInt32(position, strings.getIndex(settings->getConductorPropertyName()));
+			position = storeUInt32(position, (uint32_t)settings->getPhysicsProblem());
+		}
+
+		sectionCount++;
+	}
+
+	/* Returns false if the node is not in the node list. Segments that are not connected to two nodes of the list are not saved */
+	auto findNodeIndex = [&](node *segmentNode, uint32_t &nodeIndex) -> bool
+	{
+		if(!segmentNode)
+			return false;
+
+		unsigned int slot = segmentNode->getHandle().getIndex();
+
+		if(slot >= nodeBySlot.size() || nodeBySlot[slot] != segmentNode)
+			return false;
+
+		nodeIndex = nodeIndexBySlot[slot];
+
+		return true;
+	};
+
+	{
+		size_t contentPosition = beginSection(buffer, LINE_SECTION, RECORD_SECTION_HEADER_SIZE + editor._lineList.size() * LINE_RECORD_SIZE);
+		unsigned char *position = buffer.data() + contentPosition + RECORD_SECTION_HEADER_SIZE;
+		uint32_t lineCount = 0;
+
+		for(plf::colony<edgeLineShape>::iterator lineIterator = editor._lineList.begin(); lineIterator != editor._lineList.end(); ++lineIterator)
+		{
+			uint32_t firstNodeIndex = 0;
+			uint32_t secondNodeIndex = 0;
+
+			// A line that starts and ends on the same node has no length and is left out
+			if(!findNodeIndex(lineIterator->getFirstNode(), firstNodeIndex) || !findNodeIndex(lineIterator->getSecondNode(), secondNodeIndex) || firstNodeIndex == secondNodeIndex)
+				continue;
+
+			position = storeSegment(position, firstNodeIndex, secondNodeIndex, *lineIterator->getSegmentProperty(), strings);
+
+			lineCount++;
+		}
+
+		finishRecordSection(buffer, contentPosition, lineCount, LINE_RECORD_SIZE);
+		sectionCount++;
+	}
+
+	{
+		size_t contentPosition = beginSection(buffer, ARC_SECTION, RECORD_SECTION_HEADER_SIZE + editor._arcList.size() * ARC_RECORD_SIZE);
+		unsigned char *position = buffer.data() + contentPosition + RECORD_SECTION_HEADER_SIZE;
+		uint32_t arcCount = 0;
+
+		for(plf::colony<arcShape>::iterator arcIterator = editor._arcList.begin(); arcIterator != editor._arcList.end(); ++arcIterator)
+		{
+			uint32_t firstNodeIndex = 0;
+			uint32_t secondNodeIndex = 0;
+
+			if(!findNodeIndex(arcIterator->getFirstNode(), firstNodeIndex) || !findNodeIndex(arcIterator->getSecondNode(), secondNodeIndex) || firstNodeIndex == secondNodeIndex)
+				continue;
+
+			position = storeSegment(position, firstNodeIndex, secondNodeIndex, *arcIterator->getSegmentProperty(), strings);
+
+			// The sign of the angle is the direction of the arc
+			position = storeDouble(position, arcIterator->getArcAngle());
+			position = storeUInt64(position, arcIterator->getArcID());
+			position = storeUInt32(position, arcIterator->getnumSegments());
+			position = storeUInt32(position, 0);
+
+			arcCount++;
+		}
+
+		finishRecordSection(buffer, contentPosition, arcCount, ARC_RECORD_SIZE);
+		sectionCount++;
+	}
+
+	{
+		size_t contentPosition = beginSection(buffer, LABEL_SECTION, RECORD_SECTION_HEADER_SIZE + editor._blockLabelList.size() * LABEL_RECORD_SIZE);
+		unsigned char *position = buffer.data() + contentPosition + RECORD_SECTION_HEADER_SIZE;
+		uint32_t labelCount = 0;
+
+		for(plf::colony<blockLabel>::iterator labelIterator = editor._blockLabelList.begin(); labelIterator != editor._blockLabelList.end(); ++labelIterator)
+		{
+			blockProperty *property = labelIterator->getProperty();
+
+			position = storeDouble(position, labelIterator->getCenterXCoordinate());
+			position = storeDouble(position, labelIterator->getCenterYCoordinate());
+			position = storeDouble(position, property->getMeshSize());
+			position = storeDouble(position, property->getNumberOfTurns());
+			position = storeUInt32(position, strings.getIndex(property->getMaterialName()));
+			position = storeUInt32(position, strings.getIndex(property->getCircuitName()));
+			position = storeUInt32(position, property->getGroupNumber());
+			position = storeUInt32(position, (uint32_t)property->getMeshsizeType());
+			*position++ = property->getAutoMeshState() ? 1 : 0;
+			*position++ = property->getIsExternalState() ? 1 : 0;
+			*position++ = property->getDefaultState() ? 1 : 0;
+			std::memset(position, 0, 5);
+			position += 5;
+
+			labelCount++;
+		}
+
+		finishRecordSection(buffer, contentPosition, labelCount, LABEL_RECORD_SIZE);
+		sectionCount++;
+	}
+
+	{
+		uint64_t length = 4;
+
+		for(const std::string &text : strings.getStrings())
+			length += 4 + text.size();
+
+		size_t contentPosition = beginSection(buffer, STRING_SECTION, length);
+		unsigned char *position = buffer.data() + contentPosition;
+
+		position = storeUInt32(position, (uint32_t)strings.getStrings().size());
+
+		for(const std::string &text : strings.getStrings())
+		{
+			position = storeUInt32(position, (uint32_t)text.size());
+			std::memcpy(position, text.data(), text.size());
+			position += text.size();
+		}
+
+		sectionCount++;
+	}
+
+}
+
+
+
+/**
+ * @brief 	Takes the next chunk that has not been taken and processes the chunk until every chunk has been taken
+ * @param processChunk Processes the chunk with the index that is given. Returns false if the chunk could not be processed
+ * @param chunkCount The number of chunks
+ * @param nextChunk The index of the next chunk that has not been taken. This is shared by all of the threads
+ * @param isValid Set to false once a chunk could not be processed. The chunks that are left are skipped
+ */
+static void takeChunks(const std::function<bool(size_t)> &processChunk, size_t chunkCount, std::atomic<size_t> &nextChunk, std::atomic<bool> &isValid)
+{
+	for(size_t chunkIndex = nextChunk++; chunkIndex < chunkCount && isValid; chunkIndex = nextChunk++)
+	{
+		if(!processChunk(chunkIndex))
+			isValid = false;
+	}
+}
+
+
+
+/**
+ * @brief One of the threads that compress or decompress the chunks of a project file
+ */
+class projectChunkThread : public QThread
+{
+private:
+	const std::function<bool(size_t)> &p_processChunk;
+
+	size_t p_chunkCount;
+
+	std::atomic<size_t> &p_nextChunk;
+
+	std::atomic<bool> &p_isValid;
+
+protected:
+	void run() override
+	{
+		takeChunks(p_processChunk, p_chunkCount, p_nextChunk, p_isValid);
+	}
+
+public:
+	projectChunkThread(const std::function<bool(size_t)> &processChunk, size_t chunkCount, std::atomic<size_t> &nextChunk, std::atomic<bool> &isValid) :
+		p_processChunk(processChunk), p_chunkCount(chunkCount), p_nextChunk(nextChunk), p_isValid(isValid)
+	{
+
+	}
+};
+
+
+
+/**
+ * @brief 	Processes all of the chunks on as many threads as the machine has cores. The calling thread works on the chunks as well,
+ * 			so no thread is started if there is only one core or one chunk
+ * @param chunkCount The number of chunks
+ * @param processChunk Processes the chunk with the index that is given. This is called from several threads at the same time
+ * @return Returns true if every chunk was processed. Otherwise, returns false
+ */
+static bool processChunks(size_t chunkCount, const std::function<bool(size_t)> &processChunk)
+{
+	std::atomic<size_t> nextChunk(0);
+	std::atomic<bool> isValid(true);
+	std::vector<projectChunkThread*> threads;
+	size_t threadCount = std::min((size_t)std::max(QThread::idealThreadCount(), 1), chunkCount);
+
+	for(size_t i = 1; i < threadCount; i++)
+	{
+		threads.push_back(new projectChunkThread(processChunk, chunkCount, nextChunk, isValid));
+		threads.back()->start();
+	}
+
+	takeChunks(processChunk, chunkCount, nextChunk, isValid);
+
+	for(projectChunkThread *thread : threads)
+	{
+		thread->wait();
+		delete thread;
+	}
+
+	return isValid;
+}
+
+
+
+/**
+ * @brief 	Compresses the sections of a project file. Each section is split into chunks and the chunks are compressed on their own.
+ * 			A section that does not get smaller is stored as it is.
+ * @param input The project file. None of the sections of the file can be compressed
+ * @param output The project file with the compressed sections. Any contents of the buffer are replaced
+ * @return Returns true if the sections were compressed. Otherwise, returns false and the output is empty
+ */
+static bool compressSections(const std::vector<unsigned char> &input, std::vector<unsigned char> &output)
+{
+	struct sectionChunks
+	{
+		uint32_t tag;
+
+		const unsigned char *contents;
+
+		uint64_t length;
+
+		size_t firstChunk;
+
+		size_t chunkCount;
+	};
+
+	std::vector<sectionChunks> sections;
+	std::vector<const unsigned char*> chunkContents;
+	std::vector<int> chunkSizes;
+	uint32_t sectionCount = loadUInt32(input.data() + 12);
+	size_t position = FILE_HEADER_SIZE;
+
+	output.clear();
+
+	for(uint32_t i = 0; i < sectionCount; i++)
+	{
+		sectionChunks section;
+
+		section.tag = loadUInt32(input.data() + position);
+		section.length = loadUInt64(input.data() + position + 8);
+		section.contents = input.data() + position + SECTION_HEADER_SIZE;
+		section.firstChunk = chunkContents.size();
+
+		for(uint64_t chunkPosition = 0; chunkPosition < section.length; chunkPosition += COMPRESSION_CHUNK_SIZE)
+		{
+			chunkContents.push_back(section.contents + chunkPosition);
+			chunkSizes.push_back((int)std::min<uint64_t>(COMPRESSION_CHUNK_SIZE, section.length - chunkPosition));
+		}
+
+		section.chunkCount = chunkContents.size() - section.firstChunk;
+		sections.push_back(section);
+
+		position = (position + SECTION_HEADER_SIZE + section.length + SECTION_ALIGNMENT - 1) & ~(size_t)(SECTION_ALIGNMENT - 1);
+	}
+
+	std::vector<QByteArray> compressedChunks(chunkContents.size());
+
+	bool isCompressed = processChunks(chunkContents.size(), [&](size_t index) -> bool
+	{
+		compressedChunks[index] = qCompress(chunkContents[index], chunkSizes[index], COMPRESSION_LEVEL);
+
+		return !compressedChunks[index].isEmpty();
+	});
+
+	if(!isCompressed)
+		return false;
+
+	output.insert(output.end(), input.begin(), input.begin() + FILE_HEADER_SIZE);
+
+	for(const sectionChunks &section : sections)
+	{
+		uint64_t compressedLength = COMPRESSED_SECTION_HEADER_SIZE + 8 * (uint64_t)section.chunkCount;
+
+		for(size_t i = section.firstChunk; i < section.firstChunk + section.chunkCount; i++)
+			compressedLength += compressedChunks[i].size();
+
+		if(section.chunkCount == 0 || compressedLength >= section.length)
+		{
+			size_t contentPosition = beginSection(output, section.tag, section.length);
+
+			std::memcpy(output.data() + contentPosition, section.contents, section.length);
+			continue;
+		}
+
+		size_t contentPosition = beginSection(output, section.tag, compressedLength, SECTION_COMPRESSED);
+		unsigned char *chunkPosition = output.data() + contentPosition;
+
+		chunkPosition = storeUInt64(chunkPosition, section.length);
+		chunkPosition = storeUInt32(chunkPosition, COMPRESSION_CHUNK_SIZE);
+		chunkPosition = storeUInt32(chunkPosition, (uint32_t)section.chunkCount);
+
+		for(size_t i = section.firstChunk; i < section.firstChunk + section.chunkCount; i++)
+			chunkPosition = storeUInt64(chunkPosition, compressedChunks[i].size());
+
+		for(size_t i = section.firstChunk; i < section.firstChunk + section.chunkCount; i++)
+		{
+			std::memcpy(chunkPosition, compressedChunks[i].constData(), compressedChunks[i].size());
+			chunkPosition += compressedChunks[i].size();
+
+			// The chunk is released as soon as it is copied
+			compressedChunks[i] = QByteArray();
+		}
+	}
+
+	return true;
+}
+
+
+
+void projectFile::write(projectSnapshot &snapshot, std::vector<unsigned char> &buffer, bool compress)
+{
+	buffer.clear();
+	buffer.swap(snapshot.p_contents);
+
+	uint32_t sectionCount = snapshot.p_sectionCount;
+
+	if(buffer.size() < FILE_HEADER_SIZE)
+		buffer.resize(FILE_HEADER_SIZE);
+
+	{
+		std::ostringstream definitionStream;
+
+		{
+			boost::archive::text_oarchive archive(definitionStream);
+			archive << snapshot.p_definition;
+		}
+
+		std::string definitionText = definitionStream.str();
+
+		size_t contentPosition = beginSection(buffer, DEFINITION_SECTION, definitionText.size());
+
+		std::memcpy(buffer.data() + contentPosition, definitionText.data(), definitionText.size());
+		sectionCount++;
+	}
+
+	unsigned char *position = buffer.data();
+
+	std::memcpy(position, PROJECT_FILE_MAGIC, sizeof(PROJECT_FILE_MAGIC));
+	position = storeUInt32(position + sizeof(PROJECT_FILE_MAGIC), FORMAT_VERSION);
+	storeUInt32(position, sectionCount);
+
+	snapshot.p_sectionCount = 0;
+
+	if(compress)
+	{
+		std::vector<unsigned char> compressedBuffer;
+
+		// If the sections could not be compressed, then the file is written without compression
+		if(compressSections(buffer, compressedBuffer))
+			buffer.swap(compressedBuffer);
+	}
+}
+
+
+
+void projectFile::write(problemDefinition &definition, geometryEditor2D &editor, std::vector<unsigned char> &buffer, bool compress)
+{
+	projectSnapshot snapshot;
+
+	takeSnapshot(definition, editor, snapshot);
+	write(snapshot, buffer, compress);
+}
+
+
+
+/**
+ * @brief Reads the count and the record size from the start of a record section and checks that the columns and the records fit in the section
+ * @param section The section that is filled in
+ * @param contents The contents of the section
+ * @param length The length of the section
+ * @param minimumRecordSize The size of the records that this version writes. Smaller records are not accepted
+ * @param columnSize The number of bytes for each record in the columns in front of the records
+ * @return Returns true if the section is valid. Otherwise, returns false
+ */
+static bool openRecordSection(projectRecordSection &section, const unsigned char *contents, uint64_t length, size_t minimumRecordSize, size_t columnSize)
+{
+	if(length < RECORD_SECTION_HEADER_SIZE)
+		return false;
+
+	section.count = loadUInt32(contents);
+	section.recordSize = loadUInt32(contents + 4);
+	section.columns = contents + RECORD_SECTION_HEADER_SIZE;
+	section.records = section.columns + (size_t)section.count * columnSize;
+
+	return (section.recordSize >= minimumRecordSize && (length - RECORD_SECTION_HEADER_SIZE) / (columnSize + section.recordSize) >= section.count);
+}
+
+
+
+/**
+ * @brief Where each of the sections is in a project file that is held in memory
+ */
+struct projectSectionTable
+{
+	const unsigned char *definition = nullptr;
+
+	uint64_t definitionLength = 0;
+
+	//! The position of each string of the string table. This is where the length of the string is stored
+	std::vector<const unsigned char*> strings;
+
+	projectRecordSection nodes;
+
+	projectRecordSection lines;
+
+	projectRecordSection arcs;
+
+	projectRecordSection labels;
+
+	//! The contents of the sections that were compressed. The positions above point into these for the compressed sections
+	std::vector<std::vector<unsigned char>> expandedSections;
+};
+
+
+
+/**
+ * @brief One chunk of a compressed section and the place in the expanded section that the chunk is expanded to
+ */
+struct projectCompressedChunk
+{
+	const unsigned char *contents;
+
+	uint64_t length;
+
+	unsigned char *expandedContents;
+
+	size_t expandedLength;
+};
+
+
+
+/**
+ * @brief 	Checks the chunks of a compressed section. The contents of a compressed section are the length of the expanded section (8 bytes),
+ * 			the number of bytes in each chunk before the chunk was compressed (4 bytes), the number of chunks (4 bytes),
+ * 			the length of each compressed chunk (8 bytes each) and then the compressed chunks.
+ * @param contents The contents of the compressed section
+ * @param length The length of the compressed section
+ * @param expandedContents The buffer that the section is expanded into. This is sized to the expanded section
+ * @param chunks The list of chunks to expand. The chunks of the section are added to the list
+ * @return Returns true if the chunks are valid. Otherwise, returns false
+ */
+static bool addCompressedChunks(const unsigned char *contents, uint64_t length, std::vector<unsigned char> &expandedContents, std::vector<projectCompressedChunk> &chunks)
+{
+	if(length < COMPRESSED_SECTION_HEADER_SIZE)
+		return false;
+
+	uint64_t expandedLength = loadUInt64(contents);
+	uint32_t chunkSize = loadUInt32(contents + 8);
+	uint32_t chunkCount = loadUInt32(contents + 12);
+
+	if(chunkSize == 0 || chunkSize > MAXIMUM_CHUNK_SIZE || (length - COMPRESSED_SECTION_HEADER_SIZE) / 8 < chunkCount)
+		return false;
+
+	if(chunkCount != expandedLength / chunkSize + ((expandedLength % chunkSize != 0) ? 1 : 0))
+		return false;
+
+	uint64_t chunkPosition = COMPRESSED_SECTION_HEADER_SIZE + 8 * (uint64_t)chunkCount;
+
+	for(uint32_t i = 0; i < chunkCount; i++)
+	{
+		uint64_t chunkLength = loadUInt64(contents + COMPRESSED_SECTION_HEADER_SIZE + 8 * (size_t)i);
+
+		// zlib can not compress by more than about a factor of 1000, so a chunk that claims to be larger than that is damaged
+		if(chunkLength > length - chunkPosition || chunkLength > INT_MAX || chunkLength * 1032 + 64 < std::min<uint64_t>(chunkSize, expandedLength - (uint64_t)i * chunkSize))
+			return false;
+
+		chunkPosition += chunkLength;
+	}
+
+	expandedContents.resize(expandedLength);
+	chunkPosition = COMPRESSED_SECTION_HEADER_SIZE + 8 * (uint64_t)chunkCount;
+
+	for(uint32_t i = 0; i < chunkCount; i++)
+	{
+		projectCompressedChunk chunk;
+
+		chunk.contents = contents + chunkPosition;
+		chunk.length = loadUInt64(contents + COMPRESSED_SECTION_HEADER_SIZE + 8 * (size_t)i);
+		chunk.expandedContents = expandedContents.data() + (size_t)i * chunkSize;
+		chunk.expandedLength = (size_t)std::min<uint64_t>(chunkSize, expandedLength - (uint64_t)i * chunkSize);
+
+		chunks.push_back(chunk);
+		chunkPosition += chunk.length;
+	}
+
+	return true;
+}
+
+
+
+/**
+ * @brief Checks the header of a project file and finds the sections. The compressed sections are expanded. The records themselves are not checked
+ * @param data The contents of the file
+ * @param size The number of bytes in the file
+ * @param sections The table that is filled in
+ * @return Returns true if the header, the sections and the string table are valid. Otherwise, returns false
+ */
+static bool findSections(const unsigned char *data, size_t size, projectSectionTable &sections)
+{
+	if(!data || size < FILE_HEADER_SIZE || std::memcmp(data, PROJECT_FILE_MAGIC, sizeof(PROJECT_FILE_MAGIC)) != 0)
+		return false;
+
+	uint32_t version = loadUInt32(data + 8);
+
+	if(version < MINIMUM_FORMAT_VERSION || version > projectFile::FORMAT_VERSION)
+		return false;
+
+	struct sectionLocation
+	{
+		uint32_t tag;
+
+		const unsigned char *contents;
+
+		uint64_t length;
+	};
+
+	uint32_t sectionCount = loadUInt32(data + 12);
+	size_t position = FILE_HEADER_SIZE;
+	std::vector<sectionLocation> locations;
+	std::vector<projectCompressedChunk> chunks;
+
+	sections.expandedSections.clear();
+
+	for(uint32_t i = 0; i < sectionCount; i++)
+	{
+		if(size - position < SECTION_HEADER_SIZE)
+			return false;
+
+		sectionLocation location;
+		uint32_t flags = loadUInt32(data + position + 4);
+
+		// This is the length in the file. The location has the length after the section is expanded
+		uint64_t length = loadUInt64(data + position + 8);
+
+		location.tag = loadUInt32(data + position);
+		position += SECTION_HEADER_SIZE;
+
+		if(length > size - position)
+			return false;
+
+		location.contents = data + position;
+		location.length = length;
+
+		switch(location.tag)
+		{
+		case STRING_SECTION:
+		case DEFINITION_SECTION:
+		case NODE_SECTION:
+		case LINE_SECTION:
+		case ARC_SECTION:
+		case LABEL_SECTION:
+			if((flags & ~(uint32_t)SECTION_COMPRESSED) != 0)
+				return false;
+
+			if(flags & SECTION_COMPRESSED)
+			{
+				sections.expandedSections.emplace_back();
+
+				std::vector<unsigned char> &expandedContents = sections.expandedSections.back();
+
+				if(!addCompressedChunks(location.contents, location.length, expandedContents, chunks))
+					return false;
+
+				location.contents = expandedContents.data();
+				location.length = expandedContents.size();
+			}
+
+			locations.push_back(location);
+			break;
+		default:
+			/* The section was added by a newer version. The section is skipped without being expanded or read,
+			 * so a large section that is not needed to build the model costs nothing when the file is mapped
+			 */
+			break;
+		}
+
+		// The padding after the last section can be left out
+		position = std::min(size, (size_t)((position + length + SECTION_ALIGNMENT - 1) & ~(uint64_t)(SECTION_ALIGNMENT - 1)));
+	}
+
+	bool isExpanded = processChunks(chunks.size(), [&chunks](size_t index) -> bool
+	{
+		const projectCompressedChunk &chunk = chunks[index];
+		QByteArray expandedChunk = qUncompress(chunk.contents, (int)chunk.length);
+
+		if((size_t)expandedChunk.size() != chunk.expandedLength)
+			return false;
+
+		std::memcpy(chunk.expandedContents, expandedChunk.constData(), chunk.expandedLength);
+
+		return true;
+	});
+
+	if(!isExpanded)
+		return false;
+
+	const unsigned char *stringContents = nullptr;
+	uint64_t stringLength = 0;
+
+	for(const sectionLocation &location : locations)
+	{
+		bool isValid = true;
+
+		switch(location.tag)
+		{
+		case STRING_SECTION:
+			stringContents = location.contents;
+			stringLength = location.length;
+			break;
+		case DEFINITION_SECTION:
+			sections.definition = location.contents;
+			sections.definitionLength = location.length;
+			break;
+		case NODE_SECTION:
+			isValid = openRecordSection(sections.nodes, location.contents, location.length, NODE_RECORD_SIZE, NODE_COLUMN_SIZE);
+			break;
+		case LINE_SECTION:
+			isValid = openRecordSection(sections.lines, location.contents, location.length, LINE_RECORD_SIZE, 0);
+			break;
+		case ARC_SECTION:
+			isValid = openRecordSection(sections.arcs, location.contents, location.length, ARC_RECORD_SIZE, 0);
+			break;
+		case LABEL_SECTION:
+			isValid = openRecordSection(sections.labels, location.contents, location.length, LABEL_RECORD_SIZE, 0);
+			break;
+		}
+
+		if(!isValid)
+			return false;
+	}
+
+	if(stringContents)
+	{
+		if(stringLength < 4)
+			return false;
+
+		uint32_t stringCount = loadUInt32(stringContents);
+		uint64_t stringPosition = 4;
+
+		sections.strings.reserve(std::min<uint64_t>(stringCount, stringLength / 4));
+
+		for(uint32_t i = 0; i < stringCount; i++)
+		{
+			if(stringLength - stringPosition < 4)
+				return false;
+
+			uint32_t textLength = loadUInt32(stringContents + stringPosition);
+
+			if(stringLength - stringPosition - 4 < textLength)
+				return false;
+
+			sections.strings.push_back(stringContents + stringPosition);
+			stringPosition += 4 + textLength;
+		}
+	}
+
+	return true;
+}
+
+
+
+//! Returns the string that starts at a position of the string table
+static std::string loadString(const unsigned char *position)
+{
+	return std::string((const char*)position + 4, loadUInt32(position));
+}
+
+
+
+bool projectFile::read(const unsigned char *data, size_t size, problemDefinition &definition, geometryEditor2D &editor)
+{
+	projectSectionTable sections;
+
+	/* First, the sections are found and checked. Nothing is changed until the whole file is known to be valid */
+	if(!findSections(data, size, sections))
+		return false;
+
+	return read(sections, definition, editor);
+}
+
+
+
+bool projectFile::read(const projectSectionTable &sections, problemDefinition &definition, geometryEditor2D &editor)
+{
+	const projectRecordSection &nodeSection = sections.nodes;
+	const projectRecordSection &lineSection = sections.lines;
+	const projectRecordSection &arcSection = sections.arcs;
+	const projectRecordSection &labelSection = sections.labels;
+	std::vector<std::string> strings;
+
+	strings.reserve(sections.strings.size());
+
+	for(const unsigned char *stringPosition : sections.strings)
+		strings.push_back(loadString(stringPosition));
+
+	/* The indexes and the numbers in the records are checked before any of the geometry is created.
+	 * A coordinate or an angle that is not a number would break the spatial indexes and the calculation of the arcs
+	 */
+	uint32_t stringCount = (uint32_t)strings.size();
+	const unsigned char *xColumn = nodeSection.columns;
+	const unsigned char *yColumn = nodeSection.columns + (size_t)nodeSection.count * 8;
+
+	for(uint32_t i = 0; i < nodeSection.count; i++)
+	{
+		const unsigned char *record = nodeSection.getRecord(i);
+
+		if(loadUInt32(record + 12) >= stringCount || loadUInt32(record + 16) >= stringCount)
+			return false;
+
+		if(!isFiniteDouble(xColumn + (size_t)i * 8) || !isFiniteDouble(yColumn + (size_t)i * 8))
+			return false;
+	}
+
+	const projectRecordSection *segmentSections[] = {&lineSection, &arcSection};
+
+	for(const projectRecordSection *section : segmentSections)
+	{
+		for(uint32_t i = 0; i < section->count; i++)
+		{
+			const unsigned char *record = section->getRecord(i);
+			uint32_t firstNodeIndex = loadUInt32(record);
+			uint32_t secondNodeIndex = loadUInt32(record + 4);
+
+			if(firstNodeIndex >= nodeSection.count || secondNodeIndex >= nodeSection.count ||
+					loadUInt32(record + 8) >= stringCount || loadUInt32(record + 12) >= stringCount || !isFiniteDouble(record + 24))
+				return false;
+		}
+	}
+
+	for(uint32_t i = 0; i < arcSection.count; i++)
+	{
+		if(!isFiniteDouble(arcSection.getRecord(i) + 40))
+			return false;
+	}
+
+	for(uint32_t i = 0; i < labelSection.count; i++)
+	{
+		const unsigned char *record = labelSection.getRecord(i);
+
+		if(loadUInt32(record + 32) >= stringCount || loadUInt32(record + 36) >= stringCount)
+			return false;
+
+		if(!isFiniteDouble(record) || !isFiniteDouble(record + 8) || !isFiniteDouble(record + 16) || !isFiniteDouble(record + 24))
+			return false;
+	}
+
+	problemDefinition loadedDefinition = definition;
+
+	if(sections.definition)
+	{
+		try
+		{
+			std::istringstream definitionStream(std::string((const char*)sections.definition, sections.definitionLength));
+			boost::archive::text_iarchive archive(definitionStream);
+
+			archive >> loadedDefinition;
+		}
+		catch(const std::exception &error)
+		{
+			return false;
+		}
+	}
+
+	/* The file is valid. The geometry of the editor is replaced */
+	definition = loadedDefinition;
+
+	editor._nodeList.clear();
+	editor._lineList.clear();
+	editor._arcList.clear();
+	editor._blockLabelList.clear();
+	editor._nodeNumber = 0;
+	editor.p_arcNumber = 0;
+	editor._nodeInterator1 = nullptr;
+	editor._nodeInterator2 = nullptr;
+	editor.p_batchIsOpen = false;
+
+	auto getString = [&strings](uint32_t index) -> const std::string&
+	{
+		return strings[index];
+	};
+
+	std::vector<node*> nodes;
+
+	nodes.reserve(nodeSection.count);
+
+	for(uint32_t i = 0; i < nodeSection.count; i++)
+	{
+		const unsigned char *record = nodeSection.getRecord(i);
+		node newNode;
+
+		newNode.setCenter(loadDouble(xColumn + (size_t)i * 8), loadDouble(yColumn + (size_t)i * 8));
+		newNode.setNodeID((unsigned long)loadUInt64(record));
+		newNode.setNodeSettings(loadNodeSetting(record, getString));
+
+		if(newNode.getNodeID() > editor._nodeNumber)
+			editor._nodeNumber = newNode.getNodeID();
+
+		nodes.push_back(&(*editor._nodeList.insert(newNode)));
+	}
+
+	// The handles need to be given out before the lines and arcs copy the handles of their nodes
+	editor.rebuildHandleTable();
+
+	/* A line or arc that starts and ends on the same node has no length. These are not written anymore
+	 * but files that were saved before can still have them, so they are skipped instead of rejecting the file
+	 */
+	for(uint32_t i = 0; i < lineSection.count; i++)
+	{
+		const unsigned char *record = lineSection.getRecord(i);
+		edgeLineShape newLine;
+
+		if(loadUInt32(record) == loadUInt32(record + 4))
+			continue;
+
+		newLine.setSegmentProperty(loadSegmentProperty(record, getString));
+		newLine.setFirstNode(*nodes[loadUInt32(record)]);
+		newLine.setSecondNode(*nodes[loadUInt32(record + 4)]);
+		newLine.calculateDistance();
+
+		editor._lineList.insert(newLine);
+	}
+
+	for(uint32_t i = 0; i < arcSection.count; i++)
+	{
+		const unsigned char *record = arcSection.getRecord(i);
+		arcShape newArc;
+
+		if(loadUInt32(record) == loadUInt32(record + 4))
+			continue;
+
+		newArc.setSegmentProperty(loadSegmentProperty(record, getString));
+		newArc.setArcAngle(loadDouble(record + 40));
+		newArc.setArcID((unsigned long)loadUInt64(record + 48));
+		newArc.setNumSegments(loadUInt32(record + 56));
+		newArc.setFirstNode(*nodes[loadUInt32(record)]);
+		newArc.setSecondNode(*nodes[loadUInt32(record + 4)]);
+		newArc.calculate();
+
+		if(newArc.getArcID() > editor.p_arcNumber)
+			editor.p_arcNumber = newArc.getArcID();
+
+		editor._arcList.insert(newArc);
+	}
+
+	for(uint32_t i = 0; i < labelSection.count; i++)
+	{
+		const unsigned char *record = labelSection.getRecord(i);
+		blockLabel newLabel;
+
+		newLabel.setCenter(loadDouble(record), loadDouble(record + 8));
+		newLabel.setPorperty(loadBlockProperty(record, getString));
+
+		editor._blockLabelList.insert(newLabel);
+	}
+
+	editor.rebuildSpatialIndex();
+
+	editor._lastNodeAdded = editor._nodeList.begin();
+	editor._lastLineAdded = editor._lineList.begin();
+	editor._lastArcAdded = editor._arcList.begin();
+	editor._lastBlockLabelAdded = editor._blockLabelList.begin();
+
+	return true;
+}
+
+
+
+bool projectFile::save(const std::string &filePath, problemDefinition &definition, geometryEditor2D &editor, bool compress)
+{
+	std::vector<unsigned char> buffer;
+
+	write(definition, editor, buffer, compress);
+
+	/* The file is written to a temporary file that only replaces the old file once everything has been written
+	 * (the same way as projectSaveThread). This way, a failed save does not destroy the file that was saved before
+	 */
+	QSaveFile outputFile(QString::fromStdString(filePath));
+
+	if(!outputFile.open(QIODevice::WriteOnly))
+		return false;
+
+	if(outputFile.write((const char*)buffer.data(), (qint64)buffer.size()) != (qint64)buffer.size())
+	{
+		outputFile.cancelWriting();
+		return false;
+	}
+
+	return outputFile.commit();
+}
+
+
+
+bool projectFile::load(const std::string &filePath, problemDefinition &definition, geometryEditor2D &editor)
+{
+	projectFileView view;
+
+	if(!view.open(filePath))
+		return false;
+
+	return view.load(definition, editor);
+}
+
+
+
+bool projectFile::isProjectFile(const std::string &filePath)
+{
+	unsigned char magic[sizeof(PROJECT_FILE_MAGIC)];
+	std::ifstream inputFile(filePath, std::ios::binary);
+
+	if(!inputFile.read((char*)magic, sizeof(magic)))
+		return false;
+
+	return (std::memcmp(magic, PROJECT_FILE_MAGIC, sizeof(magic)) == 0);
+}
+
+
+
+bool projectFileView::open(const std::string &filePath)
+{
+	close();
+
+	p_file.setFileName(QString::fromStdString(filePath));
+
+	if(!p_file.open(QIODevice::ReadOnly) || p_file.size() < (qint64)FILE_HEADER_SIZE)
+	{
+		close();
+		return false;
+	}
+
+	p_size = (size_t)p_file.size();
+	p_data = p_file.map(0, p_file.size());
+
+	projectSectionTable sections;
+
+	if(!p_data || !findSections(p_data, p_size, sections))
+	{
+		close();
+		return false;
+	}
+
+	p_expandedSections.swap(sections.expandedSections);
+	p_definition = sections.definition;
+	p_definitionLength = sections.definitionLength;
+	p_strings.swap(sections.strings);
+	p_nodes = sections.nodes;
+	p_lines = sections.lines;
+	p_arcs = sections.arcs;
+	p_labels = sections.labels;
+
+	/* The columns are handed out in place when the file has the same byte order as the machine */
+#if Q_BYTE_ORDER != Q_LITTLE_ENDIAN
+	p_swappedCoordinates.resize(2 * (size_t)p_nodes.count);
+
+	for(size_t i = 0; i < p_swappedCoordinates.size(); i++)
+		p_swappedCoordinates[i] = loadDouble(p_nodes.columns + i * 8);
+#endif
+
+	return true;
+}
+
+
+
+void projectFileView::close()
+{
+	if(p_data)
+		p_file.unmap(const_cast<unsigned char*>(p_data));
+
+	p_file.close();
+
+	p_data = nullptr;
+	p_size = 0;
+	p_expandedSections.clear();
+	p_definition = nullptr;
+	p_definitionLength = 0;
+	p_strings.clear();
+	p_nodes = projectRecordSection();
+	p_lines = projectRecordSection();
+	p_arcs = projectRecordSection();
+	p_labels = projectRecordSection();
+	p_swappedCoordinates.clear();
+}
+
+
+
+bool projectFileView::load(problemDefinition &definition, geometryEditor2D &editor) const
+{
+	if(!p_data)
+		return false;
+
+	// The sections were already found and expanded when the file was opened
+	projectSectionTable sections;
+
+	sections.definition = p_definition;
+	sections.definitionLength = p_definitionLength;
+	sections.strings = p_strings;
+	sections.nodes = p_nodes;
+	sections.lines = p_lines;
+	sections.arcs = p_arcs;
+	sections.labels = p_labels;
+
+	return projectFile::read(sections, definition, editor);
+}
+
+
+
+std::string projectFileView::getString(uint32_t index) const
+{
+	return loadString(p_strings[index]);
+}
+
+
+
+const double *projectFileView::getNodeXCoordinates() const
+{
+	if(!p_swappedCoordinates.empty())
+		return p_swappedCoordinates.data();
+
+	return reinterpret_cast<const double*>(p_nodes.columns);
+}
+
+
+
+const double *projectFileView::getNodeYCoordinates() const
+{
+	return getNodeXCoordinates() + p_nodes.count;
+}
+
+
+
+unsigned long projectFileView::getNodeID(uint32_t index) const
+{
+	return (unsigned long)loadUInt64(p_nodes.getRecord(index));
+}
+
+
+
+nodeSetting projectFileView::getNodeSetting(uint32_t index) const
+{
+	return loadNodeSetting(p_nodes.getRecord(index), [this](uint32_t stringIndex) { return getString(stringIndex); });
+}
+
+
+
+uint32_t projectFileView::getLineFirstNode(uint32_t index) const
+{
+	return loadUInt32(p_lines.getRecord(index));
+}
+
+
+
+uint32_t projectFileView::getLineSecondNode(uint32_t index) const
+{
+	return loadUInt32(p_lines.getRecord(index) + 4);
+}
+
+
+
+segmentProperty projectFileView::getLineProperty(uint32_t index) const
+{
+	return loadSegmentProperty(p_lines.getRecord(index), [this](uint32_t stringIndex) { return getString(stringIndex); });
+}
+
+
+
+uint32_t projectFileView::getArcFirstNode(uint32_t index) const
+{
+	return loadUInt32(p_arcs.getRecord(index));
+}
+
+
+
+uint32_t projectFileView::getArcSecondNode(uint32_t index) const
+{
+	return loadUInt32(p_arcs.getRecord(index) + 4);
+}
+
+
+
+segmentProperty projectFileView::getArcProperty(uint32_t index) const
+{
+	return loadSegmentProperty(p_arcs.getRecord(index), [this](uint32_t stringIndex) { return getString(stringIndex); });
+}
+
+
+
+double projectFileView::getArcAngle(uint32_t index) const
+{
+	return loadDouble(p_arcs.getRecord(index) + 40);
+}
+
+
+
+unsigned int projectFileView::getArcNumberOfSegments(uint32_t index) const
+{
+	return loadUInt32(p_arcs.getRecord(index) + 56);
+}
+
+
+
+double projectFileView::getBlockLabelXCoordinate(uint32_t index) const
+{
+	return loadDouble(p_labels.getRecord(index));
+}
+
+
+
+double projectFileView::getBlockLabelYCoordinate(uint32_t index) const
+{
+	return loadDouble(p_labels.getRecord(index) + 8);
+}
+
+
+
+blockProperty projectFileView::getBlockLabelProperty(uint32_t index) const
+{
+	return loadBlockProperty(p_labels.getRecord(index), [this](uint32_t stringIndex) { return getString(stringIndex); });
+}
+
+
+
+bool projectFileView::getBoundingBox(boundingBox &box) const
+{
+	if(p_nodes.count == 0 && p_labels.count == 0)
+		return false;
+
+	const double *xCoordinates = getNodeXCoordinates();
+	const double *yCoordinates = getNodeYCoordinates();
+	double minX, minY, maxX, maxY;
+
+	if(p_nodes.count > 0)
+	{
+		minX = maxX = xCoordinates[0];
+		minY = maxY = yCoordinates[0];
+	}
+	else
+	{
+		minX = maxX = getBlockLabelXCoordinate(0);
+		minY = maxY = getBlockLabelYCoordinate(0);
+	}
+
+	for(uint32_t i = 0; i < p_nodes.count; i++)
+	{
+		minX = std::min(minX, xCoordinates[i]);
+		maxX = std::max(maxX, xCoordinates[i]);
+		minY = std::min(minY, yCoordinates[i]);
+		maxY = std::max(maxY, yCoordinates[i]);
+	}
+
+	for(uint32_t i = 0; i < p_labels.count; i++)
+	{
+		minX = std::min(minX, getBlockLabelXCoordinate(i));
+		maxX = std::max(maxX, getBlockLabelXCoordinate(i));
+		minY = std::min(minY, getBlockLabelYCoordinate(i));
+		maxY = std::max(maxY, getBlockLabelYCoordinate(i));
+	}
+
+	box = boundingBox(minX, minY, maxX, maxY);
+
+	return true;
+}
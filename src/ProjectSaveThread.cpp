@@ -0,0 +1,59 @@
+#include "Include/UI/ProjectSaveThread.h"
+#include <algorithm>
+
+#include <QSaveFile>
+
+
+
+projectSaveThread::projectSaveThread(projectSnapshot &snapshot, const QString &filePath, bool isAutosave, QObject *parent) : QThread(parent)
+{
+	std::swap(p_snapshot, snapshot);
+	p_filePath = filePath;
+	p_isAutosave = isAutosave;
+}
+
+
+
+void projectSaveThread::run()
+{
+	std::vector<unsigned char> buffer;
+
+	emit progressChanged(0);
+
+	projectFile::write(p_snapshot, buffer);
+
+	QSaveFile outputFile(p_filePath);
+
+	if(!outputFile.open(QIODevice::WriteOnly))
+	{
+		p_errorMessage = outputFile.errorString();
+		return;
+	}
+
+	size_t bytesWritten = 0;
+
+	while(bytesWritten < buffer.size())
+	{
+		qint64 chunkSize = (qint64)std::min((size_t)WRITE_CHUNK_SIZE, buffer.size() - bytesWritten);
+
+		if(outputFile.write((const char*)buffer.data() + bytesWritten, chunkSize) != chunkSize)
+		{
+			p_errorMessage = outputFile.errorString();
+			outputFile.cancelWriting();
+			return;
+		}
+
+		bytesWritten += chunkSize;
+
+		emit progressChanged((int)((100 * (uint64_t)bytesWritten) / buffer.size()));
+	}
+
+	// The temporary file only replaces the file here
+	if(!outputFile.commit())
+	{
+		p_errorMessage = outputFile.errorString();
+		return;
+	}
+
+	p_isSaved = true;
+}